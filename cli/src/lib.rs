@@ -23,13 +23,15 @@ use iroha_core::{
     block_sync::{BlockSynchronizer, BlockSynchronizerHandle},
     gossiper::{TransactionGossiper, TransactionGossiperHandle},
     handler::ThreadHandler,
+    hot_keys::HotKeys,
     kiso::KisoHandle,
     kura::Kura,
     query::store::LiveQueryStore,
     queue::Queue,
     smartcontracts::isi::Registrable as _,
     snapshot::{
-        try_read_snapshot, SnapshotMaker, SnapshotMakerHandle, TryReadError as TryReadSnapshotError,
+        try_read_snapshot, SnapshotMaker, SnapshotMakerHandle, SnapshotMetrics,
+        TryReadError as TryReadSnapshotError,
     },
     state::{State, StateReadOnly, World},
     sumeragi::{GenesisWithPubKey, SumeragiHandle, SumeragiMetrics, SumeragiStartArgs},
@@ -236,6 +238,7 @@ impl Iroha {
         let (events_sender, _) = broadcast::channel(10000);
         let world = World::with(
             [genesis_domain(config.genesis.public_key.clone())],
+            [genesis_account(config.genesis.public_key.clone())],
             config
                 .sumeragi
                 .trusted_peers
@@ -248,7 +251,7 @@ impl Iroha {
         let kura_thread_handler = Kura::start(Arc::clone(&kura));
         let live_query_store_handle = LiveQueryStore::from_config(config.live_query_store).start();
 
-        let state = match try_read_snapshot(
+        let mut state = match try_read_snapshot(
             config.snapshot.store_dir.resolve_relative_path(),
             &kura,
             live_query_store_handle.clone(),
@@ -277,6 +280,9 @@ impl Iroha {
                 live_query_store_handle.clone(),
             )
         });
+        if config.hot_keys.enabled {
+            state.hot_keys = Some(HotKeys::from_config(config.hot_keys));
+        }
         let state = Arc::new(state);
 
         let queue = Arc::new(Queue::from_config(config.queue, events_sender.clone()));
@@ -350,8 +356,17 @@ impl Iroha {
         }
         .start();
 
-        let snapshot_maker = SnapshotMaker::from_config(&config.snapshot, Arc::clone(&state))
-            .map(SnapshotMaker::start);
+        let snapshot_metrics = SnapshotMetrics {
+            duration: metrics_reporter.metrics().snapshot_duration.clone(),
+            bytes: metrics_reporter.metrics().snapshot_bytes.clone(),
+            compression_ratio: metrics_reporter
+                .metrics()
+                .snapshot_compression_ratio
+                .clone(),
+        };
+        let snapshot_maker =
+            SnapshotMaker::from_config(&config.snapshot, Arc::clone(&state), snapshot_metrics)
+                .map(SnapshotMaker::start);
 
         let kiso = KisoHandle::new(config.clone());
 
@@ -532,14 +547,7 @@ fn genesis_account(public_key: PublicKey) -> Account {
 
 fn genesis_domain(public_key: PublicKey) -> Domain {
     let genesis_account = genesis_account(public_key);
-    let mut domain =
-        Domain::new(iroha_genesis::GENESIS_DOMAIN_ID.clone()).build(&genesis_account.id);
-
-    domain
-        .accounts
-        .insert(genesis_account.id.clone(), genesis_account);
-
-    domain
+    Domain::new(iroha_genesis::GENESIS_DOMAIN_ID.clone()).build(&genesis_account.id)
 }
 
 /// Error of [`read_config_and_genesis`]
@@ -1,6 +1,6 @@
 //! Various utilities
 
-use std::{path::PathBuf, time::Duration};
+use std::{num::ParseIntError, path::PathBuf, str::FromStr, time::Duration};
 
 use derive_more::Display;
 use drop_bomb::DropBomb;
@@ -27,6 +27,15 @@ impl From<Duration> for HumanDuration {
     }
 }
 
+/// Parses a number of milliseconds, same as in the config file
+impl FromStr for HumanDuration {
+    type Err = ParseIntError;
+
+    fn from_str(s: &str) -> Result<Self, Self::Err> {
+        s.parse().map(|millis| Self(Duration::from_millis(millis)))
+    }
+}
+
 /// Representation of number of bytes, parseable from a human-readable string.
 #[derive(Debug, Copy, Clone, Deserialize, Serialize)]
 pub struct HumanBytes<T: num_traits::int::PrimInt>(pub T);
@@ -252,4 +261,12 @@ mod tests {
 
         assert_eq!(value.get(), Duration::from_millis(10_500));
     }
+
+    #[test]
+    fn parse_human_duration_from_env_str() {
+        let value: HumanDuration = "10500".parse().expect("input is fine, should parse");
+        assert_eq!(value.get(), Duration::from_millis(10_500));
+
+        assert!("10.5s".parse::<HumanDuration>().is_err());
+    }
 }
@@ -24,17 +24,123 @@ pub enum InitMode {
     Strict,
     /// Fast initialization with basic checks.
     Fast,
+    /// Check block checksums and strictly validate only blocks written after the last flush.
+    Verify,
+}
+
+/// Compression of blocks written by Kura.
+#[derive(
+    Debug,
+    Clone,
+    Copy,
+    PartialEq,
+    Eq,
+    Default,
+    strum::EnumString,
+    strum::Display,
+    DeserializeFromStr,
+    SerializeDisplay,
+)]
+#[strum(serialize_all = "snake_case")]
+pub enum BlockCompression {
+    /// Store blocks as is.
+    #[default]
+    None,
+    /// Compress every block with Zstandard.
+    Zstd,
+}
+
+/// When blocks written by Kura are flushed to the storage device.
+#[derive(
+    Debug,
+    Clone,
+    Copy,
+    PartialEq,
+    Eq,
+    Default,
+    strum::EnumString,
+    strum::Display,
+    DeserializeFromStr,
+    SerializeDisplay,
+)]
+#[strum(serialize_all = "snake_case")]
+pub enum DurabilityMode {
+    /// Leave flushing to the operating system.
+    #[default]
+    None,
+    /// Flush after every batch of written blocks.
+    Batch,
+    /// Flush at most once per sync interval.
+    Interval,
+}
+
+/// What happens to sealed block segments once a snapshot covers them.
+#[derive(
+    Debug,
+    Clone,
+    Copy,
+    PartialEq,
+    Eq,
+    Default,
+    strum::EnumString,
+    strum::Display,
+    DeserializeFromStr,
+    SerializeDisplay,
+)]
+#[strum(serialize_all = "snake_case")]
+pub enum PruningMode {
+    /// Keep all segments.
+    #[default]
+    None,
+    /// Move segments to the archive directory.
+    Archive,
+    /// Delete segments.
+    Delete,
 }
 
 #[cfg(test)]
 mod tests {
-    use crate::kura::InitMode;
+    use crate::kura::{BlockCompression, DurabilityMode, InitMode, PruningMode};
 
     #[test]
     fn init_mode_display_reprs() {
         assert_eq!(format!("{}", InitMode::Strict), "strict");
         assert_eq!(format!("{}", InitMode::Fast), "fast");
+        assert_eq!(format!("{}", InitMode::Verify), "verify");
         assert_eq!("strict".parse::<InitMode>().unwrap(), InitMode::Strict);
         assert_eq!("fast".parse::<InitMode>().unwrap(), InitMode::Fast);
+        assert_eq!("verify".parse::<InitMode>().unwrap(), InitMode::Verify);
+    }
+
+    #[test]
+    fn block_compression_display_reprs() {
+        assert_eq!(format!("{}", BlockCompression::None), "none");
+        assert_eq!(format!("{}", BlockCompression::Zstd), "zstd");
+        assert_eq!(
+            "zstd".parse::<BlockCompression>().unwrap(),
+            BlockCompression::Zstd
+        );
+    }
+
+    #[test]
+    fn durability_mode_display_reprs() {
+        assert_eq!(format!("{}", DurabilityMode::None), "none");
+        assert_eq!(format!("{}", DurabilityMode::Batch), "batch");
+        assert_eq!(format!("{}", DurabilityMode::Interval), "interval");
+        assert_eq!(
+            "interval".parse::<DurabilityMode>().unwrap(),
+            DurabilityMode::Interval
+        );
+    }
+
+    #[test]
+    fn pruning_mode_display_reprs() {
+        assert_eq!(format!("{}", PruningMode::None), "none");
+        assert_eq!(format!("{}", PruningMode::Archive), "archive");
+        assert_eq!(format!("{}", PruningMode::Delete), "delete");
+        assert_eq!(
+            "archive".parse::<PruningMode>().unwrap(),
+            PruningMode::Archive
+        );
     }
 }
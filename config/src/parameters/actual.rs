@@ -17,10 +17,10 @@ use iroha_data_model::{
 use iroha_primitives::{addr::SocketAddr, unique_vec::UniqueVec};
 use serde::{Deserialize, Serialize};
 use url::Url;
-pub use user::{DevTelemetry, Logger, Snapshot};
+pub use user::{DevTelemetry, HotKeys, Logger, Snapshot};
 
 use crate::{
-    kura::InitMode,
+    kura::{BlockCompression, DurabilityMode, InitMode, PruningMode},
     parameters::{defaults, user},
 };
 
@@ -40,6 +40,7 @@ pub struct Root {
     pub logger: Logger,
     pub queue: Queue,
     pub snapshot: Snapshot,
+    pub hot_keys: HotKeys,
     pub telemetry: Option<Telemetry>,
     pub dev_telemetry: DevTelemetry,
     pub chain_wide: ChainWide,
@@ -114,6 +115,12 @@ pub struct Queue {
 pub struct Kura {
     pub init_mode: InitMode,
     pub store_dir: WithOrigin<PathBuf>,
+    pub block_cache_size_bytes: u64,
+    pub block_compression: BlockCompression,
+    pub durability_mode: DurabilityMode,
+    pub sync_interval: Duration,
+    pub pruning_mode: PruningMode,
+    pub archive_dir: WithOrigin<PathBuf>,
     pub debug_output_new_blocks: bool,
 }
 
@@ -22,7 +22,15 @@ pub mod queue {
 }
 
 pub mod kura {
+    use super::*;
+
     pub const STORE_DIR: &str = "./storage";
+    /// Directory for pruned block segments in the `archive` pruning mode
+    pub const ARCHIVE_DIR: &str = "./storage/archive";
+    /// Memory budget for blocks loaded from disk
+    pub const BLOCK_CACHE_SIZE: u64 = 256 * 2_u64.pow(20);
+    /// Period of flushing written blocks in the `interval` durability mode
+    pub const SYNC_INTERVAL: Duration = Duration::from_millis(100);
 }
 
 pub mod network {
@@ -43,6 +51,14 @@ pub mod snapshot {
     pub const STORE_DIR: &str = "./storage/snapshot";
     // The default frequency of making snapshots is 1 minute, need to be adjusted for larger world state view size
     pub const CREATE_EVERY: Duration = Duration::from_secs(60);
+    pub const DELTA_COUNT: u32 = 0;
+}
+
+pub mod hot_keys {
+    use super::*;
+
+    pub const TOP_K: NonZeroUsize = nonzero!(32_usize);
+    pub const SAMPLE_EVERY: NonZeroU32 = nonzero!(1_u32);
 }
 
 pub mod chain_wide {
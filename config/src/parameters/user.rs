@@ -34,7 +34,10 @@ use serde::Deserialize;
 use url::Url;
 
 use crate::{
-    kura::InitMode as KuraInitMode,
+    kura::{
+        BlockCompression as KuraBlockCompression, DurabilityMode as KuraDurabilityMode,
+        InitMode as KuraInitMode, PruningMode as KuraPruningMode,
+    },
     logger::Format as LoggerFormat,
     parameters::{actual, defaults},
     snapshot::Mode as SnapshotMode,
@@ -76,6 +79,8 @@ pub struct Root {
     queue: Queue,
     #[config(nested)]
     snapshot: Snapshot,
+    #[config(nested)]
+    hot_keys: HotKeys,
     telemetry: Option<Telemetry>,
     #[config(nested)]
     dev_telemetry: DevTelemetry,
@@ -116,6 +121,7 @@ impl Root {
         let logger = self.logger;
         let queue = self.queue;
         let snapshot = self.snapshot;
+        let hot_keys = self.hot_keys;
         let dev_telemetry = self.dev_telemetry;
         let (torii, live_query_store) = self.torii.parse();
         let telemetry = self.telemetry.map(actual::Telemetry::from);
@@ -154,6 +160,7 @@ impl Root {
             logger,
             queue: queue.parse(),
             snapshot,
+            hot_keys,
             telemetry,
             dev_telemetry,
             chain_wide,
@@ -187,6 +194,33 @@ pub struct Kura {
         default = "PathBuf::from(defaults::kura::STORE_DIR)"
     )]
     pub store_dir: WithOrigin<PathBuf>,
+    /// Memory budget for blocks loaded from disk. Blocks not yet written to disk are not counted.
+    #[config(
+        env = "KURA_BLOCK_CACHE_SIZE",
+        default = "defaults::kura::BLOCK_CACHE_SIZE.into()"
+    )]
+    pub block_cache_size: HumanBytes<u64>,
+    /// Compression of newly written blocks. Blocks already on disk stay as they are.
+    #[config(env = "KURA_BLOCK_COMPRESSION", default)]
+    pub block_compression: KuraBlockCompression,
+    /// When written blocks are flushed to the storage device.
+    #[config(env = "KURA_DURABILITY_MODE", default)]
+    pub durability_mode: KuraDurabilityMode,
+    /// Period of flushing written blocks in the `interval` durability mode.
+    #[config(
+        env = "KURA_SYNC_INTERVAL",
+        default = "defaults::kura::SYNC_INTERVAL.into()"
+    )]
+    pub sync_interval: HumanDuration,
+    /// What happens to sealed block segments once a snapshot covers them.
+    #[config(env = "KURA_PRUNING_MODE", default)]
+    pub pruning_mode: KuraPruningMode,
+    /// Directory for pruned block segments in the `archive` pruning mode.
+    #[config(
+        env = "KURA_ARCHIVE_DIR",
+        default = "PathBuf::from(defaults::kura::ARCHIVE_DIR)"
+    )]
+    pub archive_dir: WithOrigin<PathBuf>,
     #[config(nested)]
     pub debug: KuraDebug,
 }
@@ -196,6 +230,12 @@ impl Kura {
         let Self {
             init_mode,
             store_dir,
+            block_cache_size,
+            block_compression,
+            durability_mode,
+            sync_interval,
+            pruning_mode,
+            archive_dir,
             debug:
                 KuraDebug {
                     output_new_blocks: debug_output_new_blocks,
@@ -205,6 +245,12 @@ impl Kura {
         actual::Kura {
             init_mode,
             store_dir,
+            block_cache_size_bytes: block_cache_size.get(),
+            block_compression,
+            durability_mode,
+            sync_interval: sync_interval.get(),
+            pruning_mode,
+            archive_dir,
             debug_output_new_blocks,
         }
     }
@@ -431,6 +477,26 @@ pub struct Snapshot {
         env = "SNAPSHOT_STORE_DIR"
     )]
     pub store_dir: WithOrigin<PathBuf>,
+    /// Number of delta snapshots, holding only entries changed since the previous snapshot,
+    /// made between full snapshots. Zero disables delta snapshots.
+    #[config(default = "defaults::snapshot::DELTA_COUNT")]
+    pub delta_count: u32,
+    /// Maximum rate at which snapshots are written to disk, per second. Unlimited if not set.
+    #[config(env = "SNAPSHOT_MAX_WRITE_RATE")]
+    pub max_write_rate: Option<HumanBytes<u64>>,
+}
+
+#[derive(Debug, Copy, Clone, ReadConfig)]
+pub struct HotKeys {
+    /// Trace reads and writes of accounts, asset definitions and triggers done by transactions.
+    #[config(env = "HOT_KEYS_ENABLED", default)]
+    pub enabled: bool,
+    /// Number of the most accessed keys kept for every block.
+    #[config(default = "defaults::hot_keys::TOP_K")]
+    pub top_k: NonZeroUsize,
+    /// Only every `sample_every`-th access is traced.
+    #[config(default = "defaults::hot_keys::SAMPLE_EVERY")]
+    pub sample_every: NonZeroU32,
 }
 
 // TODO: make serde
@@ -125,6 +125,17 @@ fn minimal_config_snapshot() {
                         id: ParameterId(kura.store_dir),
                     },
                 },
+                block_cache_size_bytes: 268435456,
+                block_compression: None,
+                durability_mode: None,
+                sync_interval: 100ms,
+                pruning_mode: None,
+                archive_dir: WithOrigin {
+                    value: "./storage/archive",
+                    origin: Default {
+                        id: ParameterId(kura.archive_dir),
+                    },
+                },
                 debug_output_new_blocks: false,
             },
             sumeragi: Sumeragi {
@@ -190,6 +201,13 @@ fn minimal_config_snapshot() {
                         id: ParameterId(snapshot.store_dir),
                     },
                 },
+                delta_count: 0,
+                max_write_rate: None,
+            },
+            hot_keys: HotKeys {
+                enabled: false,
+                top_k: 32,
+                sample_every: 1,
             },
             telemetry: None,
             dev_telemetry: DevTelemetry {
@@ -0,0 +1,184 @@
+#![allow(missing_docs)]
+
+//! Cost of chaining a block of transfers submitted as instructions and as smart contracts.
+//!
+//! Smart contracts are compiled by background workers while the block is validated,
+//! so the gap between the two measures what compilation still adds to validation.
+//! Transactions are validated one by one in their canonical order either way.
+
+use std::num::NonZeroU32;
+
+use criterion::{criterion_group, criterion_main, BatchSize, BenchmarkId, Criterion, Throughput};
+use iroha_core::{
+    block::BlockBuilder,
+    kura::Kura,
+    prelude::*,
+    query::store::LiveQueryStore,
+    smartcontracts::Execute as _,
+    state::{State, World},
+    sumeragi::network_topology::Topology,
+};
+use iroha_data_model::{isi::InstructionBox, prelude::*, ChainId};
+use iroha_primitives::unique_vec::UniqueVec;
+use parity_scale_codec::Encode as _;
+use test_samples::gen_account_in;
+
+const TRANSACTIONS_PER_BLOCK: usize = 256;
+
+/// How transfers are submitted
+#[derive(Debug, Clone, Copy)]
+enum Submission {
+    Instructions,
+    SmartContract,
+}
+
+impl Submission {
+    fn executable(self, instruction: InstructionBox) -> Executable {
+        match self {
+            Self::Instructions => Executable::Instructions(vec![instruction]),
+            Self::SmartContract => Executable::Wasm(smart_contract(&instruction)),
+        }
+    }
+}
+
+/// Smart contract executing `instruction` through the host, in the wasm text format
+fn smart_contract(instruction: &InstructionBox) -> WasmSmartContract {
+    let bytes = instruction.encode();
+    let data: String = bytes.iter().map(|byte| format!("\\{byte:02x}")).collect();
+    let wat = format!(
+        r#"
+        (module
+            (import "iroha" "execute_instruction" (func $execute (param i32 i32) (result i32)))
+            (memory (export "memory") 1)
+            (data (i32.const 0) "{data}")
+
+            ;; Allocator which never frees
+            (global $allocated (mut i32) i32.const {len})
+            (func (export "_iroha_smart_contract_alloc") (param $size i32) (result i32)
+                global.get $allocated
+                (global.set $allocated (i32.add (global.get $allocated) (local.get $size))))
+            (func (export "_iroha_smart_contract_dealloc") (param i32) (param i32)
+                nop)
+
+            (func (export "_iroha_smart_contract_main")
+                (call $execute (i32.const 0) (i32.const {len}))
+                drop))
+        "#,
+        len = bytes.len(),
+    );
+    WasmSmartContract::from_compiled(wat.into_bytes())
+}
+
+fn setup(
+    rt: &tokio::runtime::Handle,
+    submission: Submission,
+) -> (State, ChainId, Vec<SignedTransaction>) {
+    let chain_id = ChainId::from("00000000-0000-0000-0000-000000000000");
+    let (receiver_id, _receiver_keypair) = gen_account_in("wonderland");
+    let senders: Vec<_> = (0..TRANSACTIONS_PER_BLOCK)
+        .map(|_| gen_account_in("wonderland"))
+        .collect();
+    let asset_definition_id: AssetDefinitionId = "xor#wonderland".parse().expect("Valid");
+
+    let domain = Domain::new(receiver_id.domain_id.clone()).build(&receiver_id);
+    let accounts = senders
+        .iter()
+        .map(|(account_id, _)| account_id.clone())
+        .chain([receiver_id.clone()])
+        .map(|account_id| Account::new(account_id).build(&receiver_id));
+    let query_handle = {
+        let _guard = rt.enter();
+        LiveQueryStore::test().start()
+    };
+    let state = State::new(
+        World::with([domain], accounts, UniqueVec::new()),
+        Kura::blank_kura_for_testing(),
+        query_handle,
+    );
+    {
+        let mut state_block = state.block();
+        let mut state_transaction = state_block.transaction();
+        let register: InstructionBox =
+            Register::asset_definition(AssetDefinition::numeric(asset_definition_id.clone()))
+                .into();
+        let mints = senders.iter().map(|(account_id, _)| {
+            Mint::asset_numeric(
+                u32::MAX,
+                AssetId::new(asset_definition_id.clone(), account_id.clone()),
+            )
+            .into()
+        });
+        for instruction in [register].into_iter().chain(mints) {
+            instruction
+                .execute(&receiver_id, &mut state_transaction)
+                .expect("Failed to set up the world");
+        }
+        state_transaction.apply();
+        state_block.commit();
+    }
+
+    let transactions = (1..=TRANSACTIONS_PER_BLOCK)
+        .map(|nonce| NonZeroU32::new(nonce as u32).expect("Starts from 1"))
+        .zip(&senders)
+        .map(|(nonce, (account_id, key_pair))| {
+            let transfer = Transfer::asset_numeric(
+                AssetId::new(asset_definition_id.clone(), account_id.clone()),
+                1_u32,
+                receiver_id.clone(),
+            );
+            let mut builder = TransactionBuilder::new(chain_id.clone(), account_id.clone())
+                .with_executable(submission.executable(transfer.into()));
+            // Make transactions with the same payload distinct
+            builder.set_nonce(nonce);
+            builder.sign(key_pair)
+        })
+        .collect();
+
+    (state, chain_id, transactions)
+}
+
+fn smart_contract_blocks(c: &mut Criterion) {
+    let rt = tokio::runtime::Builder::new_multi_thread()
+        .enable_all()
+        .build()
+        .expect("Failed building the Runtime");
+
+    let mut group = c.benchmark_group("smart_contract_blocks");
+    group
+        .throughput(Throughput::Elements(TRANSACTIONS_PER_BLOCK as u64))
+        .sample_size(10);
+    for submission in [Submission::Instructions, Submission::SmartContract] {
+        let (state, chain_id, transactions) = setup(rt.handle(), submission);
+        let topology = Topology::new(UniqueVec::new());
+        group.bench_with_input(
+            BenchmarkId::from_parameter(format!("{submission:?}")),
+            &transactions,
+            |b, transactions| {
+                b.iter_batched(
+                    || {
+                        let limits = state.view().transaction_executor().transaction_limits;
+                        transactions
+                            .iter()
+                            .cloned()
+                            .map(|tx| {
+                                AcceptedTransaction::accept(tx, &chain_id, &limits)
+                                    .expect("Transaction must be accepted")
+                            })
+                            .collect::<Vec<_>>()
+                    },
+                    |transactions| {
+                        // Block isn't committed so that every iteration starts from the same state
+                        let mut state_block = state.block();
+                        BlockBuilder::new(transactions, topology.clone(), Vec::new())
+                            .chain(0, &mut state_block)
+                    },
+                    BatchSize::SmallInput,
+                );
+            },
+        );
+    }
+    group.finish();
+}
+
+criterion_group!(blocks, smart_contract_blocks);
+criterion_main!(blocks);
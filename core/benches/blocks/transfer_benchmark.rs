@@ -0,0 +1,92 @@
+#![allow(missing_docs)]
+
+//! Cost of a single transfer between two accounts depending on the number
+//! of accounts registered in their domain. Accounts live in their own world
+//! storage, so the cost should stay flat as the domain grows.
+
+use criterion::{criterion_group, criterion_main, BenchmarkId, Criterion, Throughput};
+use iroha_core::{
+    kura::Kura,
+    prelude::*,
+    query::store::LiveQueryStore,
+    smartcontracts::Execute as _,
+    state::{State, World},
+};
+use iroha_data_model::{isi::InstructionBox, prelude::*};
+use iroha_primitives::unique_vec::UniqueVec;
+use test_samples::gen_account_in;
+
+const DOMAIN_SIZES: [usize; 3] = [1_000, 10_000, 100_000];
+
+fn setup(rt: &tokio::runtime::Handle, domain_size: usize) -> (State, AccountId, InstructionBox) {
+    let (alice_id, _alice_keypair) = gen_account_in("wonderland");
+    let (bob_id, _bob_keypair) = gen_account_in("wonderland");
+    let asset_id = AssetId::new("xor#wonderland".parse().expect("Valid"), alice_id.clone());
+
+    let domain = Domain::new(alice_id.domain_id.clone()).build(&alice_id);
+    let accounts = [alice_id.clone(), bob_id.clone()]
+        .into_iter()
+        .chain((2..domain_size).map(|_| gen_account_in("wonderland").0))
+        .map(|account_id| Account::new(account_id).build(&alice_id));
+    let query_handle = {
+        let _guard = rt.enter();
+        LiveQueryStore::test().start()
+    };
+    let state = State::new(
+        World::with([domain], accounts, UniqueVec::new()),
+        Kura::blank_kura_for_testing(),
+        query_handle,
+    );
+    {
+        let mut state_block = state.block();
+        let mut state_transaction = state_block.transaction();
+        let instructions: [InstructionBox; 2] = [
+            Register::asset_definition(AssetDefinition::numeric(asset_id.definition_id.clone()))
+                .into(),
+            Mint::asset_numeric(u32::MAX, asset_id.clone()).into(),
+        ];
+        for instruction in instructions {
+            instruction
+                .execute(&alice_id, &mut state_transaction)
+                .expect("Failed to set up the world");
+        }
+        state_transaction.apply();
+        state_block.commit();
+    }
+
+    let transfer = Transfer::asset_numeric(asset_id, 1_u32, bob_id).into();
+    (state, alice_id, transfer)
+}
+
+fn transfer(c: &mut Criterion) {
+    let rt = tokio::runtime::Builder::new_multi_thread()
+        .enable_all()
+        .build()
+        .expect("Failed building the Runtime");
+
+    let mut group = c.benchmark_group("transfer_by_domain_size");
+    group.throughput(Throughput::Elements(1));
+    for domain_size in DOMAIN_SIZES {
+        let (state, alice_id, transfer) = setup(rt.handle(), domain_size);
+        group.bench_with_input(
+            BenchmarkId::from_parameter(domain_size),
+            &transfer,
+            |b, transfer| {
+                b.iter(|| {
+                    let mut state_block = state.block();
+                    let mut state_transaction = state_block.transaction();
+                    transfer
+                        .clone()
+                        .execute(&alice_id, &mut state_transaction)
+                        .expect("Transfer must succeed");
+                    state_transaction.apply();
+                    state_block.commit();
+                });
+            },
+        );
+    }
+    group.finish();
+}
+
+criterion_group!(transfers, transfer);
+criterion_main!(transfers);
@@ -7,15 +7,17 @@ use criterion::{criterion_group, criterion_main, Criterion};
 use iroha_config::{base::WithOrigin, parameters::actual::Kura as Config};
 use iroha_core::{
     block::*,
-    kura::{BlockStore, LockStatus},
+    kura::{BlockIndex, BlockStore, BlockStoreMap, LockStatus},
     prelude::*,
     query::store::LiveQueryStore,
     state::{State, World},
     sumeragi::network_topology::Topology,
 };
 use iroha_crypto::KeyPair;
-use iroha_data_model::{prelude::*, transaction::TransactionLimits};
+use iroha_data_model::{block::SignedBlock, prelude::*, transaction::TransactionLimits};
 use iroha_primitives::unique_vec::UniqueVec;
+use iroha_version::scale::DecodeVersioned;
+use rand::Rng as _;
 use test_samples::gen_account_in;
 use tokio::{fs, runtime::Runtime};
 
@@ -39,6 +41,12 @@ async fn measure_block_size_for_n_executors(n_executors: u32) {
     let dir = tempfile::tempdir().expect("Could not create tempfile.");
     let cfg = Config {
         init_mode: iroha_config::kura::InitMode::Strict,
+        block_cache_size_bytes: iroha_config::parameters::defaults::kura::BLOCK_CACHE_SIZE,
+        block_compression: iroha_config::kura::BlockCompression::None,
+        durability_mode: iroha_config::kura::DurabilityMode::None,
+        sync_interval: iroha_config::parameters::defaults::kura::SYNC_INTERVAL,
+        pruning_mode: iroha_config::kura::PruningMode::None,
+        archive_dir: WithOrigin::inline(dir.path().join("archive")),
         debug_output_new_blocks: false,
         store_dir: WithOrigin::inline(dir.path().to_path_buf()),
     };
@@ -80,5 +88,71 @@ fn measure_block_size(_criterion: &mut Criterion) {
     Runtime::new().unwrap().block_on(measure_block_size_async());
 }
 
-criterion_group!(kura, measure_block_size);
+/// Compare loading blocks at random heights through [`BlockStore`] file reads
+/// against decoding them from the memory mapped store used by `Kura`.
+fn random_height_reads(criterion: &mut Criterion) {
+    const BLOCK_COUNT: u64 = 1_000;
+
+    let chain_id = ChainId::from("00000000-0000-0000-0000-000000000000");
+    let (alice_id, alice_keypair) = gen_account_in("test");
+    let (bob_id, _bob_keypair) = gen_account_in("test");
+    let xor_id = AssetDefinitionId::from_str("xor#test").expect("tested");
+    let transfer = Transfer::asset_numeric(AssetId::new(xor_id, alice_id.clone()), 10u32, bob_id);
+    let tx = TransactionBuilder::new(chain_id.clone(), alice_id)
+        .with_instructions([transfer])
+        .sign(&alice_keypair);
+    let transaction_limits = TransactionLimits {
+        max_instruction_number: 4096,
+        max_wasm_size_bytes: 0,
+    };
+    let tx = AcceptedTransaction::accept(tx, &chain_id, &transaction_limits)
+        .expect("Failed to accept Transaction.");
+
+    let runtime = Runtime::new().unwrap();
+    let kura = iroha_core::kura::Kura::blank_kura_for_testing();
+    let query_handle = runtime.block_on(async { LiveQueryStore::test().start() });
+    let state = State::new(World::new(), kura, query_handle);
+    let block: SignedBlock = {
+        let mut state_block = state.block();
+        BlockBuilder::new(vec![tx], Topology::new(UniqueVec::new()), Vec::new())
+            .chain(0, &mut state_block)
+            .sign(&KeyPair::random())
+            .unpack(|_| {})
+            .into()
+    };
+
+    let dir = tempfile::tempdir().expect("Could not create tempfile.");
+    let mut block_store = BlockStore::new(dir.path(), LockStatus::Unlocked);
+    block_store.create_files_if_they_do_not_exist().unwrap();
+    for _ in 0..BLOCK_COUNT {
+        block_store.append_block_to_chain(&block).unwrap();
+    }
+    let block_map = BlockStoreMap::new(dir.path()).unwrap();
+
+    let mut rng = rand::thread_rng();
+    let mut group = criterion.benchmark_group("kura_random_height_reads");
+    group.bench_function("block_store", |b| {
+        b.iter(|| {
+            let block_number = rng.gen_range(0..BLOCK_COUNT);
+            let BlockIndex { start, length, .. } =
+                block_store.read_block_index(block_number).unwrap();
+            let mut block_buf = vec![0_u8; usize::try_from(length).unwrap()];
+            block_store
+                .read_block_data(block_number, start, &mut block_buf)
+                .unwrap();
+            SignedBlock::decode_all_versioned(&block_buf).unwrap()
+        });
+    });
+    group.bench_function("mmap", |b| {
+        b.iter(|| {
+            block_map
+                .read_block(rng.gen_range(0..BLOCK_COUNT))
+                .unwrap()
+                .unwrap()
+        });
+    });
+    group.finish();
+}
+
+criterion_group!(kura, measure_block_size, random_height_reads);
 criterion_main!(kura);
@@ -0,0 +1,54 @@
+#![allow(missing_docs)]
+
+use criterion::{criterion_group, criterion_main, Criterion};
+use iroha_core::block_hashes::BlockHashes;
+use iroha_crypto::{Hash, HashOf};
+use iroha_data_model::block::SignedBlock;
+use storage::cell::Cell;
+
+const BLOCK_COUNT: usize = 10_000_000;
+
+fn block_hash(n: usize) -> HashOf<SignedBlock> {
+    HashOf::from_untyped_unchecked(Hash::new(n.to_le_bytes()))
+}
+
+fn block_hashes(criterion: &mut Criterion) {
+    let cell = Cell::new((0..BLOCK_COUNT).map(block_hash).collect::<BlockHashes>());
+    // Commit one block so that there is a block to revert
+    let mut block = cell.block();
+    block.push(block_hash(BLOCK_COUNT));
+    block.commit();
+
+    let mut group = criterion.benchmark_group("block_hashes_10m");
+    group.bench_function("append", |b| {
+        b.iter(|| {
+            // Dropped without commit, so the height stays the same
+            let mut block = cell.block();
+            block.push(block_hash(BLOCK_COUNT + 1));
+        });
+    });
+    group.bench_function("revert_and_append", |b| {
+        b.iter(|| {
+            let mut block = cell.block_and_revert();
+            block.push(block_hash(BLOCK_COUNT + 1));
+            block.commit();
+        });
+    });
+    group.finish();
+
+    // Previous representation, every block clones the whole vector
+    let cell = Cell::new((0..BLOCK_COUNT).map(block_hash).collect::<Vec<_>>());
+    let mut group = criterion.benchmark_group("block_hashes_vec_10m");
+    group.sample_size(10);
+    group.bench_function("revert_and_append", |b| {
+        b.iter(|| {
+            let mut block = cell.block_and_revert();
+            block.push(block_hash(BLOCK_COUNT + 1));
+            block.commit();
+        });
+    });
+    group.finish();
+}
+
+criterion_group!(benches, block_hashes);
+criterion_main!(benches);
@@ -0,0 +1,584 @@
+//! Realistic block store workload shared by the `kura_io` benchmark and example.
+//!
+//! The store is generated through [`Kura`] itself, so it has the same segments,
+//! indices and chain links as the store of a peer. Its shape is configured through
+//! environment variables:
+//!
+//! - `KURA_BENCH_BLOCKS`: number of blocks in the store
+//! - `KURA_BENCH_TXS_PER_BLOCK`: number of transactions in every block
+//! - `KURA_BENCH_LARGE_TX_PERCENT`: share of transactions carrying a metadata payload
+//! - `KURA_BENCH_LARGE_TX_BYTES`: size of that payload
+//! - `KURA_BENCH_APPEND_BATCH`: number of blocks handed to `Kura` at once while appending
+//! - `KURA_BENCH_COMPRESSION`, `KURA_BENCH_DURABILITY`: `kura` config of the store
+//! - `KURA_BENCH_DIR`: directory to create the store in instead of the system temp directory
+//! - `KURA_BENCH_DROP_CACHES`: drop the page cache before cold reads, requires root
+
+use std::{
+    fmt::{self, Debug, Display},
+    num::NonZeroU32,
+    path::Path,
+    str::FromStr,
+    sync::Arc,
+    time::{Duration, Instant},
+};
+
+use iroha_config::{
+    base::WithOrigin,
+    kura::{BlockCompression, DurabilityMode, InitMode, PruningMode},
+    parameters::{actual::Kura as Config, defaults},
+};
+use iroha_core::{
+    block::{BlockBuilder, CommittedBlock},
+    kura::Kura,
+    prelude::*,
+    query::store::LiveQueryStore,
+    smartcontracts::Execute as _,
+    state::{State, StateBlock, World},
+    sumeragi::network_topology::Topology,
+};
+use iroha_data_model::{
+    block::SignedBlock, isi::InstructionBox, metadata::UnlimitedMetadata, prelude::*,
+    transaction::TransactionLimits,
+};
+use iroha_primitives::unique_vec::UniqueVec;
+use iroha_telemetry::metrics::{KuraDurableLatencyHistogram, Metrics};
+use parity_scale_codec::Encode as _;
+use rand::{seq::index::sample, Rng as _};
+use tempfile::TempDir;
+use test_samples::gen_account_in;
+
+/// Shape of the generated block store.
+#[derive(Debug, Clone, Copy)]
+pub struct StoreParameters {
+    pub block_count: usize,
+    pub txs_per_block: usize,
+    pub large_tx_percent: u32,
+    pub large_tx_bytes: usize,
+    pub append_batch: usize,
+    pub compression: BlockCompression,
+    pub durability: DurabilityMode,
+}
+
+impl StoreParameters {
+    /// Override `defaults` with the `KURA_BENCH_*` environment variables.
+    ///
+    /// # Panics
+    /// If a variable can't be parsed
+    pub fn from_env(defaults: Self) -> Self {
+        Self {
+            block_count: env_or("KURA_BENCH_BLOCKS", defaults.block_count),
+            txs_per_block: env_or("KURA_BENCH_TXS_PER_BLOCK", defaults.txs_per_block),
+            large_tx_percent: env_or("KURA_BENCH_LARGE_TX_PERCENT", defaults.large_tx_percent),
+            large_tx_bytes: env_or("KURA_BENCH_LARGE_TX_BYTES", defaults.large_tx_bytes),
+            append_batch: env_or("KURA_BENCH_APPEND_BATCH", defaults.append_batch).max(1),
+            compression: env_or("KURA_BENCH_COMPRESSION", defaults.compression),
+            durability: env_or("KURA_BENCH_DURABILITY", defaults.durability),
+        }
+    }
+}
+
+/// Value of the environment variable `name`, `default` if it isn't set
+pub fn env_or<T: FromStr>(name: &str, default: T) -> T
+where
+    T::Err: Debug,
+{
+    std::env::var(name).map_or(default, |value| {
+        value
+            .parse()
+            .unwrap_or_else(|error| panic!("Invalid value of {name}: {error:?}"))
+    })
+}
+
+/// Measurements of one store operation.
+#[derive(Debug)]
+pub struct Report {
+    pub operation: String,
+    /// Bytes of encoded blocks processed by the operation
+    pub bytes: u64,
+    /// Total time spent in the operation
+    pub elapsed: Duration,
+    /// Latencies of the individual operations, sorted
+    pub latencies: Vec<Duration>,
+    /// Peak resident set size while the operation was running, if the platform reports it
+    pub peak_rss_bytes: Option<u64>,
+}
+
+impl Report {
+    fn new(
+        operation: impl Into<String>,
+        bytes: u64,
+        elapsed: Duration,
+        mut latencies: Vec<Duration>,
+    ) -> Self {
+        latencies.sort_unstable();
+        Self {
+            operation: operation.into(),
+            bytes,
+            elapsed,
+            latencies,
+            peak_rss_bytes: peak_rss_bytes(),
+        }
+    }
+
+    /// Throughput in megabytes per second.
+    #[allow(clippy::cast_precision_loss)]
+    pub fn megabytes_per_second(&self) -> f64 {
+        self.bytes as f64 / 1e6 / self.elapsed.as_secs_f64()
+    }
+
+    /// Nearest-rank percentile of the latencies, `quantile` is in `0.0..=1.0`.
+    #[allow(
+        clippy::cast_possible_truncation,
+        clippy::cast_precision_loss,
+        clippy::cast_sign_loss
+    )]
+    pub fn percentile(&self, quantile: f64) -> Duration {
+        let Some(last) = self.latencies.len().checked_sub(1) else {
+            return Duration::ZERO;
+        };
+        self.latencies[(last as f64 * quantile).round() as usize]
+    }
+}
+
+impl Display for Report {
+    fn fmt(&self, f: &mut fmt::Formatter<'_>) -> fmt::Result {
+        write!(
+            f,
+            "{:<20} {:>8} ops {:>10.1} MB/s   p50 {:>10.3?}   p99 {:>10.3?}",
+            self.operation,
+            self.latencies.len(),
+            self.megabytes_per_second(),
+            self.percentile(0.5),
+            self.percentile(0.99),
+        )?;
+        match self.peak_rss_bytes {
+            Some(peak) => write!(f, "   peak RSS {} MiB", peak / 2_u64.pow(20)),
+            None => write!(f, "   peak RSS n/a"),
+        }
+    }
+}
+
+/// Reset the peak resident set size of the process, so that the next
+/// [`Report`] only covers the operation measured after this call.
+pub fn reset_peak_rss() {
+    // Supported since Linux 4.0, elsewhere the peak covers the whole process lifetime
+    let _ = std::fs::write("/proc/self/clear_refs", "5");
+}
+
+/// Peak resident set size of the process since the latest [`reset_peak_rss`]
+pub fn peak_rss_bytes() -> Option<u64> {
+    let status = std::fs::read_to_string("/proc/self/status").ok()?;
+    let kilobytes = status
+        .lines()
+        .find_map(|line| line.strip_prefix("VmHWM:"))?
+        .trim()
+        .strip_suffix("kB")?
+        .trim()
+        .parse::<u64>()
+        .ok()?;
+    Some(kilobytes * 1024)
+}
+
+/// Observer of the time it takes blocks stored in [`Kura`] to become durable.
+pub struct DurableBlocks {
+    histogram: KuraDurableLatencyHistogram,
+    awaited_count: u64,
+}
+
+impl DurableBlocks {
+    /// Observe blocks stored in `kura` from now on.
+    pub fn observe(kura: &Kura) -> Self {
+        let histogram = Metrics::default().kura_commit_to_durable;
+        kura.observe_durable_latency(histogram.clone());
+        Self {
+            histogram,
+            awaited_count: 0,
+        }
+    }
+
+    /// Wait until the blocks stored at `stored_at` are durable and return how long each took.
+    pub fn wait(&mut self, stored_at: &[Instant]) -> Vec<Duration> {
+        self.awaited_count += stored_at.len() as u64;
+        while self.histogram.get_sample_count() < self.awaited_count {
+            std::thread::yield_now();
+        }
+        stored_at.iter().map(Instant::elapsed).collect()
+    }
+}
+
+/// Creates signed blocks full of transfers chained on top of each other.
+struct BlockGenerator {
+    state: State,
+    chain_id: ChainId,
+    alice_id: AccountId,
+    alice_keypair: KeyPair,
+    bob_id: AccountId,
+    asset_id: AssetId,
+    peer_keypair: KeyPair,
+    transaction_limits: TransactionLimits,
+    nonce: u32,
+    parameters: StoreParameters,
+}
+
+impl BlockGenerator {
+    fn new(rt: &tokio::runtime::Handle, parameters: StoreParameters) -> Self {
+        let (alice_id, alice_keypair) = gen_account_in("wonderland");
+        let (bob_id, _bob_keypair) = gen_account_in("wonderland");
+        let asset_id = AssetId::new("xor#wonderland".parse().expect("Valid"), alice_id.clone());
+
+        let kura = Kura::blank_kura_for_testing();
+        let query_handle = {
+            let _guard = rt.enter();
+            LiveQueryStore::test().start()
+        };
+        let domain = Domain::new(alice_id.domain_id.clone()).build(&alice_id);
+        let accounts = [&alice_id, &bob_id]
+            .map(|account_id| Account::new(account_id.clone()).build(&alice_id));
+        let state = State::new(
+            World::with([domain], accounts, UniqueVec::new()),
+            kura,
+            query_handle,
+        );
+        {
+            let mut state_block = state.block();
+            let mut state_transaction = state_block.transaction();
+            let instructions: [InstructionBox; 2] = [
+                Register::asset_definition(AssetDefinition::numeric(
+                    asset_id.definition_id.clone(),
+                ))
+                .into(),
+                Mint::asset_numeric(u32::MAX, asset_id.clone()).into(),
+            ];
+            for instruction in instructions {
+                instruction
+                    .execute(&alice_id, &mut state_transaction)
+                    .expect("Failed to set up the world");
+            }
+            state_transaction.apply();
+            state_block.commit();
+        }
+
+        Self {
+            state,
+            chain_id: ChainId::from("00000000-0000-0000-0000-000000000000"),
+            alice_id,
+            alice_keypair,
+            bob_id,
+            asset_id,
+            peer_keypair: KeyPair::random(),
+            transaction_limits: TransactionLimits::new(4096, 0),
+            nonce: 0,
+            parameters,
+        }
+    }
+
+    fn transactions(&mut self) -> Vec<AcceptedTransaction> {
+        let mut rng = rand::thread_rng();
+        (0..self.parameters.txs_per_block)
+            .map(|_| {
+                // Transactions created within the same millisecond differ only in the nonce
+                self.nonce = self.nonce.wrapping_add(1);
+                let transfer =
+                    Transfer::asset_numeric(self.asset_id.clone(), 1_u32, self.bob_id.clone());
+                let mut builder =
+                    TransactionBuilder::new(self.chain_id.clone(), self.alice_id.clone())
+                        .with_instructions([transfer]);
+                builder.set_nonce(NonZeroU32::new(self.nonce).unwrap_or(NonZeroU32::MIN));
+                if rng.gen_range(0..100) < self.parameters.large_tx_percent {
+                    let mut payload = vec![0_u8; self.parameters.large_tx_bytes];
+                    rng.fill(&mut payload[..]);
+                    let mut metadata = UnlimitedMetadata::new();
+                    metadata.insert(
+                        "payload".parse().expect("Valid"),
+                        MetadataValueBox::Bytes(payload),
+                    );
+                    builder = builder.with_metadata(metadata);
+                }
+                let transaction = builder.sign(&self.alice_keypair);
+                AcceptedTransaction::accept(transaction, &self.chain_id, &self.transaction_limits)
+                    .expect("Failed to accept transaction")
+            })
+            .collect()
+    }
+
+    fn commit_block(
+        transactions: Vec<AcceptedTransaction>,
+        view_change_index: u64,
+        state_block: &mut StateBlock<'_>,
+        key_pair: &KeyPair,
+    ) -> CommittedBlock {
+        let topology = Topology::new(UniqueVec::new());
+        BlockBuilder::new(transactions, topology.clone(), Vec::new())
+            .chain(view_change_index, state_block)
+            .sign(key_pair)
+            .unpack(|_| {})
+            .commit(&topology)
+            .unpack(|_| {})
+            .expect("Failed to commit block")
+    }
+
+    /// Create the next block of the chain.
+    fn next_block(&mut self) -> CommittedBlock {
+        let transactions = self.transactions();
+        let mut state_block = self.state.block();
+        let block = Self::commit_block(transactions, 0, &mut state_block, &self.peer_keypair);
+        let _events = state_block.apply_without_execution(&block);
+        state_block.commit();
+        block
+    }
+
+    /// Create an alternative to the top block of the chain as produced by a view change.
+    fn fork_top_block(&mut self, view_change_index: u64) -> CommittedBlock {
+        let transactions = self.transactions();
+        let mut state_block = self.state.block_and_revert();
+        Self::commit_block(
+            transactions,
+            view_change_index,
+            &mut state_block,
+            &self.peer_keypair,
+        )
+    }
+}
+
+/// Block store generated with [`StoreParameters`] to run the measurements against.
+pub struct KuraStore {
+    generator: BlockGenerator,
+    block_count: usize,
+    data_bytes: u64,
+    // Dropped last to remove the store
+    dir: TempDir,
+}
+
+impl KuraStore {
+    /// Generate the store by appending blocks through [`Kura`].
+    /// Appending is measured along the way since it is the only time the store grows.
+    ///
+    /// # Panics
+    /// On IO errors
+    pub fn generate(rt: &tokio::runtime::Handle, parameters: StoreParameters) -> (Self, Report) {
+        let dir = match std::env::var_os("KURA_BENCH_DIR") {
+            Some(parent) => tempfile::tempdir_in(parent),
+            None => tempfile::tempdir(),
+        }
+        .expect("Failed to create store directory");
+        let mut generator = BlockGenerator::new(rt, parameters);
+
+        let (kura, _) = Kura::new(&config(dir.path(), InitMode::Strict, parameters))
+            .expect("Failed to create Kura");
+        let writer = Kura::start(Arc::clone(&kura));
+        let mut durable_blocks = DurableBlocks::observe(&kura);
+
+        let mut bytes = 0;
+        let mut elapsed = Duration::ZERO;
+        let mut latencies = Vec::with_capacity(parameters.block_count);
+        reset_peak_rss();
+        let mut remaining = parameters.block_count;
+        while remaining > 0 {
+            let batch = remaining.min(parameters.append_batch);
+            let blocks = (0..batch)
+                .map(|_| generator.next_block())
+                .collect::<Vec<_>>();
+            bytes += blocks
+                .iter()
+                .map(|block| block.as_ref().encoded_size() as u64)
+                .sum::<u64>();
+
+            let started = Instant::now();
+            let mut stored_at = Vec::with_capacity(batch);
+            for block in blocks {
+                stored_at.push(Instant::now());
+                kura.store_block(block);
+            }
+            latencies.extend(durable_blocks.wait(&stored_at));
+            elapsed += started.elapsed();
+            remaining -= batch;
+        }
+        let report = Report::new("append", bytes, elapsed, latencies);
+        drop(writer);
+        drop(kura);
+
+        let store = Self {
+            generator,
+            block_count: parameters.block_count,
+            data_bytes: bytes,
+            dir,
+        };
+        (store, report)
+    }
+
+    /// Number of blocks in the store.
+    pub fn block_count(&self) -> usize {
+        self.block_count
+    }
+
+    /// Total size of the encoded blocks in the store.
+    pub fn data_bytes(&self) -> u64 {
+        self.data_bytes
+    }
+
+    pub fn path(&self) -> &Path {
+        self.dir.path()
+    }
+
+    /// Open the store. Only one [`Kura`] can have the store open at a time.
+    ///
+    /// # Panics
+    /// If the store is locked or corrupted
+    pub fn kura(&self, init_mode: InitMode) -> Arc<Kura> {
+        let (kura, block_count) =
+            Kura::new(&config(self.path(), init_mode, self.generator.parameters))
+                .expect("Failed to open the store");
+        assert_eq!(block_count.0, self.block_count);
+        kura
+    }
+
+    /// Load the first `count` blocks of the store.
+    pub fn blocks(&self, count: usize) -> Vec<Arc<SignedBlock>> {
+        let kura = self.kura(InitMode::Fast);
+        (1..=count.min(self.block_count) as u64)
+            .map(|height| {
+                kura.get_block_by_height(height)
+                    .expect("Block is in the store")
+            })
+            .collect()
+    }
+
+    /// Create an alternative to the top block of the store.
+    pub fn fork_top_block(&mut self, view_change_index: u64) -> CommittedBlock {
+        self.generator.fork_top_block(view_change_index)
+    }
+
+    /// Measure opening the store from scratch `runs` times.
+    pub fn measure_init(&self, init_mode: InitMode, runs: usize) -> Report {
+        reset_peak_rss();
+        let latencies = (0..runs)
+            .map(|_| {
+                let started = Instant::now();
+                let kura = self.kura(init_mode);
+                let elapsed = started.elapsed();
+                drop(kura);
+                elapsed
+            })
+            .collect::<Vec<_>>();
+        let elapsed = latencies.iter().sum();
+        Report::new(
+            format!("init ({init_mode})"),
+            self.data_bytes * runs as u64,
+            elapsed,
+            latencies,
+        )
+    }
+
+    /// Measure reading `reads` distinct random blocks with an empty block cache.
+    ///
+    /// Blocks are only served from disk if the page cache is dropped beforehand, see `KURA_BENCH_DROP_CACHES`.
+    pub fn measure_cold_reads(&self, reads: usize) -> Report {
+        drop_page_cache();
+        let kura = self.kura(InitMode::Fast);
+        let heights = sample(
+            &mut rand::thread_rng(),
+            self.block_count,
+            reads.min(self.block_count),
+        );
+        reset_peak_rss();
+        Self::measure_reads("random read (cold)", &kura, heights.into_iter())
+    }
+
+    /// Measure reading `reads` random blocks out of `hot_blocks` blocks which were read before.
+    pub fn measure_warm_reads(&self, reads: usize, hot_blocks: usize) -> Report {
+        let kura = self.kura(InitMode::Fast);
+        let mut rng = rand::thread_rng();
+        let hot = sample(&mut rng, self.block_count, hot_blocks.min(self.block_count)).into_vec();
+        for &block_number in &hot {
+            kura.get_block_by_height(block_number as u64 + 1);
+        }
+        reset_peak_rss();
+        let heights = (0..reads).map(|_| hot[rng.gen_range(0..hot.len())]);
+        Self::measure_reads("random read (warm)", &kura, heights)
+    }
+
+    /// Measure reading all blocks in the order of the chain.
+    pub fn measure_sequential_scan(&self) -> Report {
+        drop_page_cache();
+        let kura = self.kura(InitMode::Fast);
+        reset_peak_rss();
+        Self::measure_reads("sequential scan", &kura, 0..self.block_count)
+    }
+
+    fn measure_reads(
+        operation: &str,
+        kura: &Kura,
+        block_numbers: impl Iterator<Item = usize>,
+    ) -> Report {
+        let mut bytes = 0;
+        let mut elapsed = Duration::ZERO;
+        let latencies = block_numbers
+            .map(|block_number| {
+                let started = Instant::now();
+                let block = kura
+                    .get_block_by_height(block_number as u64 + 1)
+                    .expect("Block is in the store");
+                let latency = started.elapsed();
+                elapsed += latency;
+                bytes += block.encoded_size() as u64;
+                latency
+            })
+            .collect();
+        Report::new(operation, bytes, elapsed, latencies)
+    }
+
+    /// Measure replacing the top block `replacements` times until it is written to disk.
+    pub fn measure_replace_top_block(&mut self, replacements: usize) -> Report {
+        let forks = [self.fork_top_block(1), self.fork_top_block(2)];
+        let kura = self.kura(InitMode::Fast);
+        let writer = Kura::start(Arc::clone(&kura));
+        let mut durable_blocks = DurableBlocks::observe(&kura);
+
+        let mut bytes = 0;
+        reset_peak_rss();
+        let latencies = forks
+            .iter()
+            .cycle()
+            .take(replacements)
+            .map(|block| {
+                bytes += block.as_ref().encoded_size() as u64;
+                let block = block.clone();
+                let started = Instant::now();
+                kura.replace_top_block(block);
+                durable_blocks.wait(&[started]);
+                started.elapsed()
+            })
+            .collect::<Vec<_>>();
+        let elapsed = latencies.iter().sum();
+        drop(writer);
+        Report::new("replace_top_block", bytes, elapsed, latencies)
+    }
+}
+
+/// `kura` config of a benchmark store at `store_dir`.
+pub fn config(store_dir: &Path, init_mode: InitMode, parameters: StoreParameters) -> Config {
+    Config {
+        init_mode,
+        store_dir: WithOrigin::inline(store_dir.to_path_buf()),
+        block_cache_size_bytes: defaults::kura::BLOCK_CACHE_SIZE,
+        block_compression: parameters.compression,
+        durability_mode: parameters.durability,
+        sync_interval: defaults::kura::SYNC_INTERVAL,
+        pruning_mode: PruningMode::None,
+        archive_dir: WithOrigin::inline(store_dir.join("archive")),
+        debug_output_new_blocks: false,
+    }
+}
+
+/// Best effort to evict the store from the page cache, so that reads hit the storage device.
+fn drop_page_cache() {
+    if std::env::var_os("KURA_BENCH_DROP_CACHES").is_none() {
+        return;
+    }
+    let synced = std::process::Command::new("sync")
+        .status()
+        .is_ok_and(|status| status.success());
+    if !synced || std::fs::write("/proc/sys/vm/drop_caches", "3").is_err() {
+        eprintln!("Failed to drop the page cache, cold reads might be served from memory");
+    }
+}
@@ -0,0 +1,126 @@
+#![allow(missing_docs)]
+
+#[allow(dead_code)]
+mod kura_io;
+
+use std::{sync::Arc, time::Instant};
+
+use criterion::{criterion_group, criterion_main, BatchSize, Criterion, Throughput};
+use iroha_config::kura::{BlockCompression, DurabilityMode, InitMode};
+use iroha_core::kura::{BlockStore, Kura, LockStatus};
+use kura_io::{DurableBlocks, KuraStore, StoreParameters};
+use rand::Rng as _;
+
+fn kura_io(criterion: &mut Criterion) {
+    let rt = tokio::runtime::Builder::new_multi_thread()
+        .enable_all()
+        .build()
+        .expect("Failed building the Runtime");
+    let parameters = StoreParameters::from_env(StoreParameters {
+        block_count: 1_000,
+        txs_per_block: 32,
+        large_tx_percent: 10,
+        large_tx_bytes: 4096,
+        append_batch: 16,
+        compression: BlockCompression::None,
+        durability: DurabilityMode::None,
+    });
+    let (mut store, _) = KuraStore::generate(rt.handle(), parameters);
+    let block_count = store.block_count() as u64;
+
+    let mut group = criterion.benchmark_group("kura_append");
+    let batch = store.blocks(parameters.append_batch);
+    group.throughput(Throughput::Bytes(
+        store.data_bytes() * batch.len() as u64 / block_count,
+    ));
+    group.bench_function("write_blocks_at_height", |b| {
+        b.iter_batched_ref(
+            || {
+                let dir = tempfile::tempdir().expect("Could not create tempfile.");
+                let mut block_store = BlockStore::new(dir.path(), LockStatus::Unlocked);
+                block_store.create_files_if_they_do_not_exist().unwrap();
+                (block_store, dir)
+            },
+            |(block_store, _dir)| {
+                block_store
+                    .write_blocks_at_height(0, batch.iter().map(|block| &**block))
+                    .unwrap();
+            },
+            BatchSize::PerIteration,
+        );
+    });
+    group.finish();
+
+    let mut rng = rand::thread_rng();
+    let mut group = criterion.benchmark_group("kura_random_reads");
+    group.bench_function("cold", |b| {
+        b.iter_batched_ref(
+            || store.kura(InitMode::Fast),
+            |kura| kura.get_block_by_height(rng.gen_range(1..=block_count)),
+            BatchSize::PerIteration,
+        );
+    });
+    group.bench_function("warm", |b| {
+        let kura = store.kura(InitMode::Fast);
+        let hot = (0..64)
+            .map(|_| rng.gen_range(1..=block_count))
+            .collect::<Vec<_>>();
+        for &height in &hot {
+            kura.get_block_by_height(height);
+        }
+        b.iter(|| kura.get_block_by_height(hot[rng.gen_range(0..hot.len())]));
+    });
+    group.finish();
+
+    let mut group = criterion.benchmark_group("kura_sequential_scan");
+    group
+        .throughput(Throughput::Bytes(store.data_bytes()))
+        .sample_size(10);
+    group.bench_function("get_block_by_height", |b| {
+        b.iter_batched_ref(
+            || store.kura(InitMode::Fast),
+            |kura| {
+                for height in 1..=block_count {
+                    kura.get_block_by_height(height);
+                }
+            },
+            BatchSize::PerIteration,
+        );
+    });
+    group.finish();
+
+    let mut group = criterion.benchmark_group("kura_init");
+    group
+        .throughput(Throughput::Bytes(store.data_bytes()))
+        .sample_size(10);
+    for init_mode in [InitMode::Fast, InitMode::Strict] {
+        group.bench_function(init_mode.to_string(), |b| {
+            // Only one `Kura` can have the store open, so it's closed after every iteration
+            b.iter_batched(|| (), |()| store.kura(init_mode), BatchSize::PerIteration);
+        });
+    }
+    group.finish();
+
+    let forks = [store.fork_top_block(1), store.fork_top_block(2)];
+    let kura = store.kura(InitMode::Fast);
+    let writer = Kura::start(Arc::clone(&kura));
+    let mut durable_blocks = DurableBlocks::observe(&kura);
+    let mut group = criterion.benchmark_group("kura_replace_top_block");
+    group.bench_function("replace_top_block", |b| {
+        let mut forks = forks.iter().cycle();
+        b.iter_batched(
+            || forks.next().expect("Cycle is infinite").clone(),
+            |block| {
+                let stored_at = Instant::now();
+                kura.replace_top_block(block);
+                durable_blocks.wait(&[stored_at]);
+            },
+            BatchSize::SmallInput,
+        );
+    });
+    group.finish();
+    drop(writer);
+}
+
+criterion_group!(kura, kura_io);
+criterion_main!(kura);
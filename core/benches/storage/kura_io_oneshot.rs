@@ -0,0 +1,51 @@
+//! Oneshot execution of the `kura_io` benchmark against a realistic multi-gigabyte store.
+//! Prints throughput, latency percentiles and peak memory of every block store operation.
+//!
+//! ```bash
+//! KURA_BENCH_BLOCKS=50000 KURA_BENCH_DIR=/mnt/ssd cargo run --release --example kura_io
+//! ```
+//!
+//! See `kura_io.rs` for all parameters of the generated store.
+
+#[allow(dead_code)]
+mod kura_io;
+
+use iroha_config::kura::{BlockCompression, DurabilityMode, InitMode};
+use kura_io::{KuraStore, StoreParameters};
+
+fn main() {
+    let rt = tokio::runtime::Builder::new_multi_thread()
+        .enable_all()
+        .build()
+        .expect("Failed building the Runtime");
+    {
+        let _guard = rt.enter();
+        iroha_logger::test_logger();
+    }
+    // With these defaults the store takes up about 3 GB
+    let parameters = StoreParameters::from_env(StoreParameters {
+        block_count: 50_000,
+        txs_per_block: 64,
+        large_tx_percent: 10,
+        large_tx_bytes: 4096,
+        append_batch: 64,
+        compression: BlockCompression::None,
+        durability: DurabilityMode::Batch,
+    });
+    iroha_logger::info!(?parameters, "Generating the block store...");
+    let (mut store, append) = KuraStore::generate(rt.handle(), parameters);
+    println!(
+        "Store of {} blocks, {} MB in {}",
+        store.block_count(),
+        store.data_bytes() / 1_000_000,
+        store.path().display()
+    );
+
+    println!("{append}");
+    println!("{}", store.measure_init(InitMode::Fast, 5));
+    println!("{}", store.measure_init(InitMode::Strict, 3));
+    println!("{}", store.measure_cold_reads(10_000));
+    println!("{}", store.measure_warm_reads(100_000, 64));
+    println!("{}", store.measure_sequential_scan());
+    println!("{}", store.measure_replace_top_block(100));
+}
@@ -0,0 +1,150 @@
+#![allow(missing_docs)]
+
+//! Writes and reads a large state through the binary snapshot format and the JSON one used
+//! before. Wall time and peak RSS of a single run of every path are printed before the
+//! benchmarks. The state is shaped by environment variables:
+//!
+//! - `SNAPSHOT_BENCH_DOMAINS`: number of domains
+//! - `SNAPSHOT_BENCH_ACCOUNTS_PER_DOMAIN`: number of accounts in every domain, each holding
+//!   an asset
+
+#[allow(dead_code)]
+mod kura_io;
+
+use std::{fs::File, io::BufWriter, path::Path, time::Instant};
+
+use criterion::{criterion_group, criterion_main, Criterion};
+use iroha_core::{
+    kura::{BlockCount, Kura},
+    query::store::LiveQueryStore,
+    smartcontracts::Execute as _,
+    snapshot::{try_read_snapshot, write_full_snapshot, SNAPSHOT_FILE_NAME},
+    state::{State, World},
+};
+use iroha_data_model::{isi::InstructionBox, prelude::*};
+use iroha_primitives::unique_vec::UniqueVec;
+use kura_io::{env_or, peak_rss_bytes, reset_peak_rss};
+use test_samples::gen_account_in;
+
+/// State with `domains` domains of `accounts_per_domain` accounts holding an asset each
+fn large_state(domains: usize, accounts_per_domain: usize) -> State {
+    let (alice_id, _alice_keypair) = gen_account_in("wonderland");
+    let domain = Domain::new(alice_id.domain_id.clone()).build(&alice_id);
+    let account = Account::new(alice_id.clone()).build(&alice_id);
+    let state = State::new(
+        World::with([domain], [account], UniqueVec::new()),
+        Kura::blank_kura_for_testing(),
+        LiveQueryStore::test().start(),
+    );
+
+    let mut state_block = state.block();
+    let mut state_transaction = state_block.transaction();
+    for domain in 0..domains {
+        let domain_id: DomainId = format!("domain{domain}").parse().expect("Valid");
+        let rose_id = AssetDefinitionId::new(domain_id.clone(), "rose".parse().expect("Valid"));
+        let mut instructions: Vec<InstructionBox> = vec![
+            Register::domain(Domain::new(domain_id.clone())).into(),
+            Register::asset_definition(AssetDefinition::numeric(rose_id.clone())).into(),
+        ];
+        for _ in 0..accounts_per_domain {
+            let (account_id, _account_keypair) = gen_account_in(&domain_id);
+            instructions.push(Register::account(Account::new(account_id.clone())).into());
+            instructions.push(
+                Mint::asset_numeric(100_u32, AssetId::new(rose_id.clone(), account_id)).into(),
+            );
+        }
+        for instruction in instructions {
+            instruction
+                .execute(&alice_id, &mut state_transaction)
+                .expect("Failed to set up the world");
+        }
+    }
+    state_transaction.apply();
+    state_block.commit();
+    state
+}
+
+/// Write `state` in the JSON format used before the binary one
+fn write_json_snapshot(state: &State, store_dir: &Path) {
+    let file = File::create(store_dir.join(SNAPSHOT_FILE_NAME)).expect("Failed to create file");
+    serde_json::to_writer(BufWriter::new(file), state).expect("Failed to write snapshot");
+}
+
+fn read_snapshot(store_dir: &Path) -> State {
+    try_read_snapshot(
+        store_dir,
+        &Kura::blank_kura_for_testing(),
+        LiveQueryStore::test().start(),
+        BlockCount(0),
+    )
+    .expect("Failed to read snapshot")
+}
+
+/// Run `operation` once and print its wall time and the peak RSS it added to the process
+fn report<T>(name: &str, operation: impl FnOnce() -> T) -> T {
+    reset_peak_rss();
+    let baseline = peak_rss_bytes();
+    let started = Instant::now();
+    let output = operation();
+    let elapsed = started.elapsed();
+    match peak_rss_bytes().zip(baseline) {
+        Some((peak, baseline)) => println!(
+            "{name}: {elapsed:?}, peak RSS +{} MiB",
+            peak.saturating_sub(baseline) / 2_u64.pow(20)
+        ),
+        None => println!("{name}: {elapsed:?}, peak RSS n/a"),
+    }
+    output
+}
+
+fn snapshot_io(criterion: &mut Criterion) {
+    let rt = tokio::runtime::Builder::new_multi_thread()
+        .enable_all()
+        .build()
+        .expect("Failed building the Runtime");
+    let _guard = rt.enter();
+    let state = large_state(
+        env_or("SNAPSHOT_BENCH_DOMAINS", 100),
+        env_or("SNAPSHOT_BENCH_ACCOUNTS_PER_DOMAIN", 1_000),
+    );
+    let binary_dir = tempfile::tempdir().expect("Could not create tempfile.");
+    let json_dir = tempfile::tempdir().expect("Could not create tempfile.");
+
+    let binary_size = report("binary_write", || {
+        write_full_snapshot(&state, binary_dir.path()).expect("Failed to write snapshot")
+    });
+    report("json_write", || {
+        write_json_snapshot(&state, json_dir.path())
+    });
+    let json_size = std::fs::metadata(json_dir.path().join(SNAPSHOT_FILE_NAME))
+        .expect("Snapshot is written")
+        .len();
+    println!(
+        "snapshot size: binary {} MiB, json {} MiB",
+        binary_size / 2_u64.pow(20),
+        json_size / 2_u64.pow(20)
+    );
+    drop(report("binary_read", || read_snapshot(binary_dir.path())));
+    drop(report("json_read", || read_snapshot(json_dir.path())));
+
+    let mut group = criterion.benchmark_group("snapshot_io");
+    group.sample_size(10);
+    group.bench_function("binary_write", |b| {
+        b.iter(|| {
+            write_full_snapshot(&state, binary_dir.path()).expect("Failed to write snapshot")
+        });
+    });
+    group.bench_function("json_write", |b| {
+        b.iter(|| write_json_snapshot(&state, json_dir.path()));
+    });
+    group.bench_function("binary_read", |b| {
+        b.iter_with_large_drop(|| read_snapshot(binary_dir.path()));
+    });
+    group.bench_function("json_read", |b| {
+        b.iter_with_large_drop(|| read_snapshot(json_dir.path()));
+    });
+    group.finish();
+}
+
+criterion_group!(benches, snapshot_io);
+criterion_main!(benches);
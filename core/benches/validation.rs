@@ -48,10 +48,9 @@ fn build_test_and_transient_state() -> State {
     let state = State::new(
         {
             let (account_id, _account_keypair) = gen_account_in(&*STARTER_DOMAIN);
-            let mut domain = Domain::new(STARTER_DOMAIN.clone()).build(&account_id);
+            let domain = Domain::new(STARTER_DOMAIN.clone()).build(&account_id);
             let account = Account::new(account_id.clone()).build(&account_id);
-            assert!(domain.add_account(account).is_none());
-            World::with([domain], UniqueVec::new())
+            World::with([domain], [account], UniqueVec::new())
         },
         kura,
         query_handle,
@@ -20,7 +20,11 @@ use thiserror::Error;
 
 pub(crate) use self::event::WithEvents;
 pub use self::{chained::Chained, commit::CommittedBlock, valid::ValidBlock};
-use crate::{prelude::*, sumeragi::network_topology::Topology, tx::AcceptTransactionFail};
+use crate::{
+    prelude::*,
+    sumeragi::network_topology::Topology,
+    tx::{AcceptTransactionFail, SmartContractCompiler},
+};
 
 /// Error during transaction validation
 #[derive(Debug, displaydoc::Display, Error)]
@@ -176,28 +180,48 @@ mod pending {
             transactions: Vec<AcceptedTransaction>,
             state_block: &mut StateBlock<'_>,
         ) -> Vec<CommittedTransaction> {
-            transactions
-                .into_iter()
-                .map(
-                    |tx| match state_block.transaction_executor().validate(tx, state_block) {
-                        Ok(tx) => CommittedTransaction {
-                            value: tx,
-                            error: None,
-                        },
-                        Err((tx, error)) => {
-                            iroha_logger::warn!(
-                                reason = %error,
-                                caused_by = ?error.source(),
-                                "Transaction validation failed",
-                            );
-                            CommittedTransaction {
-                                value: tx,
-                                error: Some(error),
+            let transaction_executor = state_block.transaction_executor();
+            let signed_transactions: Vec<_> = transactions
+                .iter()
+                .map(AsRef::<SignedTransaction>::as_ref)
+                .collect();
+
+            SmartContractCompiler::run(
+                state_block.engine,
+                &transaction_executor.transaction_limits,
+                &signed_transactions,
+                |compiler| {
+                    transactions
+                        .iter()
+                        .cloned()
+                        .enumerate()
+                        .map(|(idx, tx)| {
+                            match transaction_executor.validate_with_compiler(
+                                tx,
+                                compiler,
+                                idx,
+                                state_block,
+                            ) {
+                                Ok(tx) => CommittedTransaction {
+                                    value: tx,
+                                    error: None,
+                                },
+                                Err((tx, error)) => {
+                                    iroha_logger::warn!(
+                                        reason = %error,
+                                        caused_by = ?error.source(),
+                                        "Transaction validation failed",
+                                    );
+                                    CommittedTransaction {
+                                        value: tx,
+                                        error: Some(error),
+                                    }
+                                }
                             }
-                        }
-                    },
-                )
-                .collect()
+                        })
+                        .collect()
+                },
+            )
         }
 
         /// Chain the block with existing blockchain.
@@ -355,38 +379,53 @@ mod valid {
             state_block: &mut StateBlock<'_>,
         ) -> Result<(), TransactionValidationError> {
             let is_genesis = block.header().is_genesis();
+            let transaction_executor = state_block.transaction_executor();
+            let limits = &transaction_executor.transaction_limits;
+            let signed_transactions: Vec<_> = block.transactions().map(|tx| &tx.value).collect();
+
+            SmartContractCompiler::run(
+                state_block.engine,
+                limits,
+                &signed_transactions,
+                |compiler| {
+                    block
+                        .transactions()
+                        // TODO: Unnecessary clone?
+                        .cloned()
+                        .enumerate()
+                        .try_for_each(|(idx, CommittedTransaction { value, error })| {
+                            let tx = if is_genesis {
+                                AcceptedTransaction::accept_genesis(
+                                    GenesisTransaction(value),
+                                    expected_chain_id,
+                                    genesis_public_key,
+                                )
+                            } else {
+                                AcceptedTransaction::accept(value, expected_chain_id, limits)
+                            }?;
+
+                            if error.is_some() {
+                                match transaction_executor.validate_with_compiler(
+                                    tx,
+                                    compiler,
+                                    idx,
+                                    state_block,
+                                ) {
+                                    Err(rejected_transaction) => Ok(rejected_transaction),
+                                    Ok(_) => Err(TransactionValidationError::RejectedIsValid),
+                                }?;
+                            } else {
+                                transaction_executor
+                                    .validate_with_compiler(tx, compiler, idx, state_block)
+                                    .map_err(|(_tx, error)| {
+                                        TransactionValidationError::NotValid(error)
+                                    })?;
+                            }
 
-            block
-                .transactions()
-                // TODO: Unnecessary clone?
-                .cloned()
-                .try_for_each(|CommittedTransaction { value, error }| {
-                    let transaction_executor = state_block.transaction_executor();
-                    let limits = &transaction_executor.transaction_limits;
-
-                    let tx = if is_genesis {
-                        AcceptedTransaction::accept_genesis(
-                            GenesisTransaction(value),
-                            expected_chain_id,
-                            genesis_public_key,
-                        )
-                    } else {
-                        AcceptedTransaction::accept(value, expected_chain_id, limits)
-                    }?;
-
-                    if error.is_some() {
-                        match transaction_executor.validate(tx, state_block) {
-                            Err(rejected_transaction) => Ok(rejected_transaction),
-                            Ok(_) => Err(TransactionValidationError::RejectedIsValid),
-                        }?;
-                    } else {
-                        transaction_executor
-                            .validate(tx, state_block)
-                            .map_err(|(_tx, error)| TransactionValidationError::NotValid(error))?;
-                    }
-
-                    Ok(())
-                })
+                            Ok(())
+                        })
+                },
+            )
         }
 
         /// The manipulation of the topology relies upon all peers seeing the same signature set.
@@ -823,9 +862,8 @@ mod tests {
         let (alice_id, alice_keypair) = gen_account_in("wonderland");
         let account = Account::new(alice_id.clone()).build(&alice_id);
         let domain_id = DomainId::from_str("wonderland").expect("Valid");
-        let mut domain = Domain::new(domain_id).build(&alice_id);
-        assert!(domain.add_account(account).is_none());
-        let world = World::with([domain], UniqueVec::new());
+        let domain = Domain::new(domain_id).build(&alice_id);
+        let world = World::with([domain], [account], UniqueVec::new());
         let kura = Kura::blank_kura_for_testing();
         let query_handle = LiveQueryStore::test().start();
         let state = State::new(world, kura, query_handle);
@@ -878,9 +916,8 @@ mod tests {
         let (alice_id, alice_keypair) = gen_account_in("wonderland");
         let account = Account::new(alice_id.clone()).build(&alice_id);
         let domain_id = DomainId::from_str("wonderland").expect("Valid");
-        let mut domain = Domain::new(domain_id).build(&alice_id);
-        assert!(domain.add_account(account).is_none());
-        let world = World::with([domain], UniqueVec::new());
+        let domain = Domain::new(domain_id).build(&alice_id);
+        let world = World::with([domain], [account], UniqueVec::new());
         let kura = Kura::blank_kura_for_testing();
         let query_handle = LiveQueryStore::test().start();
         let state = State::new(world, kura, query_handle);
@@ -951,12 +988,8 @@ mod tests {
         let (alice_id, alice_keypair) = gen_account_in("wonderland");
         let account = Account::new(alice_id.clone()).build(&alice_id);
         let domain_id = DomainId::from_str("wonderland").expect("Valid");
-        let mut domain = Domain::new(domain_id).build(&alice_id);
-        assert!(
-            domain.add_account(account).is_none(),
-            "{alice_id} already exist in the blockchain"
-        );
-        let world = World::with([domain], UniqueVec::new());
+        let domain = Domain::new(domain_id).build(&alice_id);
+        let world = World::with([domain], [account], UniqueVec::new());
         let kura = Kura::blank_kura_for_testing();
         let query_handle = LiveQueryStore::test().start();
         let state = State::new(world, kura, query_handle);
@@ -1032,12 +1065,11 @@ mod tests {
             GENESIS_DOMAIN_ID.clone(),
             genesis_wrong_key.public_key().clone(),
         );
-        let mut genesis_domain =
+        let genesis_domain =
             Domain::new(GENESIS_DOMAIN_ID.clone()).build(&genesis_correct_account_id);
         let genesis_wrong_account =
             Account::new(genesis_wrong_account_id.clone()).build(&genesis_wrong_account_id);
-        assert!(genesis_domain.add_account(genesis_wrong_account).is_none(),);
-        let world = World::with([genesis_domain], UniqueVec::new());
+        let world = World::with([genesis_domain], [genesis_wrong_account], UniqueVec::new());
         let kura = Kura::blank_kura_for_testing();
         let query_handle = LiveQueryStore::test().start();
         let state = State::new(world, kura, query_handle);
@@ -1090,4 +1122,76 @@ mod tests {
             )) if reason == "Signature doesn't correspond to genesis public key"
         ));
     }
+
+    #[tokio::test]
+    async fn compiling_smart_contracts_ahead_matches_sequential_validation() {
+        let chain_id = ChainId::from("00000000-0000-0000-0000-000000000000");
+
+        // Predefined world state
+        let (alice_id, alice_keypair) = gen_account_in("wonderland");
+        let account = Account::new(alice_id.clone()).build(&alice_id);
+        let domain_id = DomainId::from_str("wonderland").expect("Valid");
+        let domain = Domain::new(domain_id).build(&alice_id);
+        let world = World::with([domain], [account], UniqueVec::new());
+        let kura = Kura::blank_kura_for_testing();
+        let query_handle = LiveQueryStore::test().start();
+        let state = State::new(world, kura, query_handle);
+        let transaction_limits = state.view().transaction_executor().transaction_limits;
+
+        // Smart contracts which succeed, trap and don't compile mixed with instructions
+        // which succeed only the first time
+        let asset_definition_id = AssetDefinitionId::from_str("xor#wonderland").expect("Valid");
+        let executables = [
+            Executable::Wasm(WasmSmartContract::from_compiled(
+                br#"(module (func (export "_iroha_smart_contract_main")))"#.to_vec(),
+            )),
+            Executable::Wasm(WasmSmartContract::from_compiled(
+                br#"(module (func (export "_iroha_smart_contract_main") unreachable))"#.to_vec(),
+            )),
+            Executable::Wasm(WasmSmartContract::from_compiled(b"not a module".to_vec())),
+            Executable::Instructions(vec![Register::asset_definition(AssetDefinition::numeric(
+                asset_definition_id,
+            ))
+            .into()]),
+        ];
+        let transactions: Vec<_> = (1_u32..=32)
+            .zip(executables.iter().cycle())
+            .map(|(nonce, executable)| {
+                let mut builder = TransactionBuilder::new(chain_id.clone(), alice_id.clone())
+                    .with_executable(executable.clone());
+                builder.set_nonce(nonce.try_into().expect("Starts from 1"));
+                let tx = builder.sign(&alice_keypair);
+                AcceptedTransaction::accept(tx, &chain_id, &transaction_limits).expect("Valid")
+            })
+            .collect();
+
+        let mut state_block = state.block();
+        let topology = Topology::new(UniqueVec::new());
+        let valid_block = BlockBuilder::new(transactions.clone(), topology, Vec::new())
+            .chain(0, &mut state_block)
+            .sign(&alice_keypair)
+            .unpack(|_| {});
+        let errors: Vec<_> = valid_block
+            .as_ref()
+            .transactions()
+            .map(|tx| tx.error.clone())
+            .collect();
+        drop(state_block);
+
+        // Same block validated one transaction after another without compiling ahead
+        let mut state_block = state.block();
+        let transaction_executor = state_block.transaction_executor();
+        let sequential_errors: Vec<_> = transactions
+            .into_iter()
+            .map(|tx| {
+                transaction_executor
+                    .validate(tx, &mut state_block)
+                    .err()
+                    .map(|(_tx, error)| error)
+            })
+            .collect();
+
+        assert_eq!(errors, sequential_errors);
+        assert_eq!(errors.iter().filter(|error| error.is_none()).count(), 9);
+    }
 }
@@ -0,0 +1,282 @@
+//! Persistent vector of block hashes.
+//!
+//! [`BlockHashes`] is stored in a [`Cell`](storage::cell::Cell), which clones its value on
+//! the first change in a block and keeps the previous one to revert the latest block. To keep
+//! that clone independent of the chain height, hashes are stored in a trie of shared chunks of
+//! [`BRANCH`] hashes with a small tail holding the latest ones. Cloning copies only the tail,
+//! appending a hash copies at most one path of the trie.
+use std::sync::Arc;
+
+use iroha_crypto::HashOf;
+use iroha_data_model::block::SignedBlock;
+use serde::{
+    de::{SeqAccess, Visitor},
+    Deserialize, Deserializer, Serialize, Serializer,
+};
+
+/// Number of bits of an index consumed by a level of the trie
+const BITS: u32 = 5;
+/// Number of children of a trie node and of hashes in a chunk
+const BRANCH: usize = 1 << BITS;
+/// Mask of the bits of an index consumed by a level of the trie
+const MASK: usize = BRANCH - 1;
+
+/// Hashes of committed blocks, the hash of the block at height `h` has index `h - 1`
+#[derive(Debug, Clone, Default)]
+pub struct BlockHashes {
+    /// Trie of full chunks of hashes, [`None`] until the first chunk is full
+    root: Option<Node>,
+    /// Number of branch levels above the chunks
+    depth: u32,
+    /// Latest hashes which don't fill a chunk yet
+    tail: Vec<HashOf<SignedBlock>>,
+    len: usize,
+}
+
+#[derive(Debug, Clone)]
+enum Node {
+    Branch(Arc<Vec<Node>>),
+    Chunk(Arc<Vec<HashOf<SignedBlock>>>),
+}
+
+impl BlockHashes {
+    /// Number of hashes
+    pub fn len(&self) -> usize {
+        self.len
+    }
+
+    /// Whether there are no hashes
+    pub fn is_empty(&self) -> bool {
+        self.len == 0
+    }
+
+    /// Hash at `index`
+    pub fn get(&self, index: usize) -> Option<&HashOf<SignedBlock>> {
+        let trie_len = self.len - self.tail.len();
+        if index >= trie_len {
+            return self.tail.get(index - trie_len);
+        }
+
+        let mut node = self.root.as_ref()?;
+        let mut depth = self.depth;
+        loop {
+            match node {
+                Node::Branch(children) => {
+                    node = &children[(index >> (BITS * depth)) & MASK];
+                    depth -= 1;
+                }
+                Node::Chunk(hashes) => return hashes.get(index & MASK),
+            }
+        }
+    }
+
+    /// The latest hash
+    pub fn last(&self) -> Option<&HashOf<SignedBlock>> {
+        self.len.checked_sub(1).and_then(|index| self.get(index))
+    }
+
+    /// Iterate over hashes from the oldest to the latest
+    pub fn iter(&self) -> impl Iterator<Item = &HashOf<SignedBlock>> {
+        self.iter_from(0)
+    }
+
+    /// Iterate over hashes starting from `index`
+    pub fn iter_from(&self, index: usize) -> impl Iterator<Item = &HashOf<SignedBlock>> {
+        // Every chunk of the trie is full, so whole chunks are skipped
+        self.chunks()
+            .skip(index / BRANCH)
+            .flatten()
+            .skip(index % BRANCH)
+    }
+
+    /// Append `hash`
+    pub fn push(&mut self, hash: HashOf<SignedBlock>) {
+        if self.tail.len() == BRANCH {
+            let chunk = core::mem::replace(&mut self.tail, Vec::with_capacity(BRANCH));
+            self.push_chunk(chunk);
+        }
+        self.tail.push(hash);
+        self.len += 1;
+    }
+
+    /// Shorten to the first `len` hashes.
+    ///
+    /// Hashes are collected anew, which is fine for the rare cases of replacing a part of
+    /// the chain, reverting the latest block is done by reverting the
+    /// [`Cell`](storage::cell::Cell) instead.
+    pub fn truncate(&mut self, len: usize) {
+        if len < self.len {
+            *self = self.iter().take(len).copied().collect();
+        }
+    }
+
+    fn chunks(&self) -> impl Iterator<Item = &[HashOf<SignedBlock>]> {
+        let mut stack = self.root.iter().collect::<Vec<_>>();
+        let trie_chunks = core::iter::from_fn(move || {
+            while let Some(node) = stack.pop() {
+                match node {
+                    Node::Branch(children) => stack.extend(children.iter().rev()),
+                    Node::Chunk(hashes) => return Some(hashes.as_slice()),
+                }
+            }
+            None
+        });
+        trie_chunks.chain(core::iter::once(self.tail.as_slice()))
+    }
+
+    fn push_chunk(&mut self, chunk: Vec<HashOf<SignedBlock>>) {
+        // Index of the first hash of the chunk, which is still counted in the length
+        let index = self.len - chunk.len();
+        let chunk = Node::Chunk(Arc::new(chunk));
+        self.root = Some(match self.root.take() {
+            None => chunk,
+            Some(root) if index == 1 << (BITS * (self.depth + 1)) => {
+                self.depth += 1;
+                Node::Branch(Arc::new(vec![root, Self::path(self.depth - 1, chunk)]))
+            }
+            Some(mut root) => {
+                Self::insert(&mut root, self.depth, index, chunk);
+                root
+            }
+        });
+    }
+
+    /// Insert `chunk` starting at `index` under the `node` at `depth` above the chunks
+    fn insert(node: &mut Node, depth: u32, index: usize, chunk: Node) {
+        let Node::Branch(children) = node else {
+            unreachable!("Chunks are only inserted after full chunks");
+        };
+        let children = Arc::make_mut(children);
+        let child = (index >> (BITS * depth)) & MASK;
+        if child < children.len() {
+            Self::insert(&mut children[child], depth - 1, index, chunk);
+        } else {
+            children.push(Self::path(depth - 1, chunk));
+        }
+    }
+
+    /// Node at `depth` above the chunks leading to `chunk`
+    fn path(depth: u32, chunk: Node) -> Node {
+        (0..depth).fold(chunk, |node, _| Node::Branch(Arc::new(vec![node])))
+    }
+}
+
+impl core::ops::Index<usize> for BlockHashes {
+    type Output = HashOf<SignedBlock>;
+
+    fn index(&self, index: usize) -> &Self::Output {
+        self.get(index).expect("Index out of bounds")
+    }
+}
+
+impl Extend<HashOf<SignedBlock>> for BlockHashes {
+    fn extend<T: IntoIterator<Item = HashOf<SignedBlock>>>(&mut self, hashes: T) {
+        for hash in hashes {
+            self.push(hash);
+        }
+    }
+}
+
+impl FromIterator<HashOf<SignedBlock>> for BlockHashes {
+    fn from_iter<T: IntoIterator<Item = HashOf<SignedBlock>>>(hashes: T) -> Self {
+        let mut block_hashes = Self::default();
+        block_hashes.extend(hashes);
+        block_hashes
+    }
+}
+
+// Serialized as a sequence, same as the vector of hashes stored before
+impl Serialize for BlockHashes {
+    fn serialize<S: Serializer>(&self, serializer: S) -> Result<S::Ok, S::Error> {
+        serializer.collect_seq(self.iter())
+    }
+}
+
+impl<'de> Deserialize<'de> for BlockHashes {
+    fn deserialize<D: Deserializer<'de>>(deserializer: D) -> Result<Self, D::Error> {
+        struct BlockHashesVisitor;
+
+        impl<'de> Visitor<'de> for BlockHashesVisitor {
+            type Value = BlockHashes;
+
+            fn expecting(&self, formatter: &mut std::fmt::Formatter) -> std::fmt::Result {
+                formatter.write_str("a sequence of block hashes")
+            }
+
+            fn visit_seq<A>(self, mut seq: A) -> Result<Self::Value, A::Error>
+            where
+                A: SeqAccess<'de>,
+            {
+                let mut block_hashes = BlockHashes::default();
+                while let Some(hash) = seq.next_element()? {
+                    block_hashes.push(hash);
+                }
+                Ok(block_hashes)
+            }
+        }
+
+        deserializer.deserialize_seq(BlockHashesVisitor)
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use iroha_crypto::Hash;
+
+    use super::*;
+
+    fn block_hash(n: usize) -> HashOf<SignedBlock> {
+        HashOf::from_untyped_unchecked(Hash::new(n.to_le_bytes()))
+    }
+
+    #[test]
+    fn hashes_are_found_across_levels() {
+        let len = BRANCH * BRANCH * 2 + 5;
+        let block_hashes = (0..len).map(block_hash).collect::<BlockHashes>();
+
+        assert_eq!(block_hashes.len(), len);
+        assert_eq!(block_hashes.depth, 2);
+        for index in [0, 1, BRANCH - 1, BRANCH, BRANCH * BRANCH, len - 6, len - 1] {
+            assert_eq!(block_hashes[index], block_hash(index));
+        }
+        assert_eq!(block_hashes.get(len), None);
+        assert_eq!(block_hashes.last(), Some(&block_hash(len - 1)));
+        assert!(block_hashes.iter().copied().eq((0..len).map(block_hash)));
+        assert!(block_hashes
+            .iter_from(BRANCH + 3)
+            .copied()
+            .eq((BRANCH + 3..len).map(block_hash)));
+    }
+
+    #[test]
+    fn clones_are_independent() {
+        let mut block_hashes = (0..BRANCH * 3).map(block_hash).collect::<BlockHashes>();
+        let previous = block_hashes.clone();
+        block_hashes.push(block_hash(BRANCH * 3));
+
+        assert_eq!(previous.len(), BRANCH * 3);
+        assert_eq!(previous.last(), Some(&block_hash(BRANCH * 3 - 1)));
+        assert_eq!(block_hashes.last(), Some(&block_hash(BRANCH * 3)));
+    }
+
+    #[test]
+    fn truncate_keeps_first_hashes() {
+        let mut block_hashes = (0..BRANCH * 2 + 1).map(block_hash).collect::<BlockHashes>();
+        block_hashes.truncate(BRANCH + 1);
+        block_hashes.push(block_hash(0));
+
+        assert_eq!(block_hashes.len(), BRANCH + 2);
+        assert_eq!(block_hashes[BRANCH], block_hash(BRANCH));
+        assert_eq!(block_hashes[BRANCH + 1], block_hash(0));
+    }
+
+    #[test]
+    fn serialized_as_vector() {
+        let hashes = (0..BRANCH + 1).map(block_hash).collect::<Vec<_>>();
+        let json = serde_json::to_string(&hashes).unwrap();
+        let block_hashes: BlockHashes = serde_json::from_str(&json).unwrap();
+
+        assert!(block_hashes.iter().eq(hashes.iter()));
+        assert_eq!(serde_json::to_string(&block_hashes).unwrap(), json);
+    }
+}
@@ -1,12 +1,13 @@
 //! Structures and impls related to *runtime* `Executor`s processing.
 
 use derive_more::DebugCustom;
+use iroha_crypto::HashOf;
 use iroha_data_model::{
     account::AccountId,
     executor as data_model_executor,
     isi::InstructionBox,
     query::QueryBox,
-    transaction::{Executable, SignedTransaction},
+    transaction::{Executable, SignedTransaction, WasmSmartContract},
     ValidationFail,
 };
 use iroha_logger::trace;
@@ -17,7 +18,7 @@ use serde::{
 
 use crate::{
     smartcontracts::{wasm, Execute as _},
-    state::{deserialize::WasmSeed, StateReadOnly, StateTransaction},
+    state::{deserialize::WasmSeed, serialize::WasmByHash, StateReadOnly, StateTransaction},
 };
 
 impl From<wasm::error::Error> for ValidationFail {
@@ -126,7 +127,41 @@ impl<'de> DeserializeSeed<'de> for WasmSeed<'_, Executor> {
     }
 }
 
+/// Serialized in the same format as [`Executor`], except that the user-provided executor
+/// refers to its contract by hash
+impl Serialize for WasmByHash<'_, Executor> {
+    fn serialize<S: serde::Serializer>(&self, serializer: S) -> Result<S::Ok, S::Error> {
+        /// [`LoadedExecutor`] referring to its contract by hash
+        #[derive(Serialize)]
+        #[serde(rename = "LoadedExecutor")]
+        struct LoadedExecutorByHash {
+            hash: HashOf<WasmSmartContract>,
+        }
+
+        match self.0 {
+            Executor::Initial => serializer.serialize_unit_variant("Executor", 0, "Initial"),
+            Executor::UserProvided(UserProvidedExecutor(loaded)) => serializer
+                .serialize_newtype_variant(
+                    "Executor",
+                    1,
+                    "UserProvided",
+                    &LoadedExecutorByHash {
+                        hash: HashOf::new(&loaded.raw_executor.wasm),
+                    },
+                ),
+        }
+    }
+}
+
 impl Executor {
+    /// WASM blob of the user-provided executor, [`None`] for the initial one
+    pub fn wasm(&self) -> Option<&WasmSmartContract> {
+        match self {
+            Self::Initial => None,
+            Self::UserProvided(UserProvidedExecutor(loaded)) => Some(&loaded.raw_executor.wasm),
+        }
+    }
+
     /// Validate [`SignedTransaction`].
     ///
     /// # Errors
@@ -321,10 +356,24 @@ impl<'de> DeserializeSeed<'de> for WasmSeed<'_, LoadedExecutor> {
                 M: MapAccess<'de>,
             {
                 while let Some(key) = map.next_key::<String>()? {
-                    if key.as_str() == "raw_executor" {
-                        let executor: data_model_executor::Executor = map.next_value()?;
-                        return Ok(LoadedExecutor::load(self.loader.engine, executor).unwrap());
-                    }
+                    let raw_executor = match key.as_str() {
+                        "raw_executor" => map.next_value::<data_model_executor::Executor>()?,
+                        "hash" => data_model_executor::Executor::new(
+                            self.loader.contract::<M::Error>(&map.next_value()?)?,
+                        ),
+                        _ => {
+                            map.next_value::<serde::de::IgnoredAny>()?;
+                            continue;
+                        }
+                    };
+                    let module = self
+                        .loader
+                        .load_module(&raw_executor.wasm)
+                        .map_err(serde::de::Error::custom)?;
+                    return Ok(LoadedExecutor {
+                        module,
+                        raw_executor,
+                    });
                 }
                 Err(serde::de::Error::missing_field("raw_executor"))
             }
@@ -332,7 +381,7 @@ impl<'de> DeserializeSeed<'de> for WasmSeed<'_, LoadedExecutor> {
 
         deserializer.deserialize_struct(
             "LoadedExecutor",
-            &["raw_executor"],
+            &["raw_executor", "hash"],
             LoadedExecutorVisitor { loader: &self },
         )
     }
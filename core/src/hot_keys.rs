@@ -0,0 +1,246 @@
+//! Tracing of the most accessed keys of the world state.
+//!
+//! When enabled, reads and writes of accounts, asset definitions and triggers made while a
+//! block is executed are sampled into a top-K heavy-hitter sketch (the Space-Saving
+//! algorithm). The sketch of every committed block is published as a [`HotKeysReport`]
+//! which is exposed through the torii status endpoint and Prometheus metrics.
+//!
+//! Tracing is disabled by default, in which case [`State`](crate::state::State) holds no
+//! [`HotKeys`] and every access costs a single check of an [`Option`].
+
+use std::{
+    collections::BTreeMap,
+    sync::atomic::{AtomicU64, Ordering},
+};
+
+use iroha_config::parameters::actual::HotKeys as Config;
+use iroha_data_model::prelude::*;
+use parking_lot::Mutex;
+use serde::Serialize;
+
+/// Key of the world state whose accesses are traced
+#[derive(Debug, Clone, PartialEq, Eq, PartialOrd, Ord, Hash, Serialize)]
+#[serde(tag = "kind", content = "id", rename_all = "snake_case")]
+pub enum HotKey {
+    /// [`Account`], accesses to [`Asset`]s held by the account included
+    Account(AccountId),
+    /// [`AssetDefinition`], accesses to its total quantity included
+    AssetDefinition(AssetDefinitionId),
+    /// [`Trigger`] execution
+    Trigger(TriggerId),
+}
+
+impl HotKey {
+    /// Kind of the key as used in metric labels
+    pub fn kind(&self) -> &'static str {
+        match self {
+            Self::Account(_) => "account",
+            Self::AssetDefinition(_) => "asset_definition",
+            Self::Trigger(_) => "trigger",
+        }
+    }
+
+    /// Id of the key as used in metric labels
+    pub fn id(&self) -> String {
+        match self {
+            Self::Account(id) => id.to_string(),
+            Self::AssetDefinition(id) => id.to_string(),
+            Self::Trigger(id) => id.to_string(),
+        }
+    }
+}
+
+/// Kind of access to a [`HotKey`]
+#[derive(Debug, Clone, Copy, PartialEq, Eq)]
+pub enum Access {
+    /// Key was read
+    Read,
+    /// Key was modified
+    Write,
+}
+
+/// Estimated number of accesses to a [`HotKey`] during a block
+#[derive(Debug, Clone, PartialEq, Eq, Serialize)]
+pub struct HotKeyCount {
+    /// Accessed key
+    pub key: HotKey,
+    /// Number of reads counted since the key entered the sketch
+    pub reads: u64,
+    /// Number of writes counted since the key entered the sketch
+    pub writes: u64,
+    /// Accesses of the key which took its place in the sketch.
+    /// The real number of accesses is between `reads + writes` and `reads + writes + error`.
+    pub error: u64,
+}
+
+impl HotKeyCount {
+    fn estimate(&self) -> u64 {
+        self.reads + self.writes + self.error
+    }
+}
+
+/// The most accessed keys of a committed block
+#[derive(Debug, Clone, Default, PartialEq, Eq, Serialize)]
+pub struct HotKeysReport {
+    /// Height of the block
+    pub height: u64,
+    /// Number of traced accesses, including those of keys which didn't make it into `keys`
+    pub accesses: u64,
+    /// The most accessed keys, the hottest first
+    pub keys: Vec<HotKeyCount>,
+}
+
+/// Top-K heavy-hitter sketch of accesses to the keys of the world state
+#[derive(Debug)]
+pub struct HotKeys {
+    top_k: usize,
+    sample_every: u64,
+    /// Accesses made during the current block, sampled or not
+    accesses: AtomicU64,
+    sketch: Mutex<BTreeMap<HotKey, HotKeyCount>>,
+    latest: Mutex<HotKeysReport>,
+}
+
+impl HotKeys {
+    /// Construct [`Self`] from configuration
+    pub fn from_config(config: Config) -> Self {
+        Self {
+            top_k: config.top_k.get(),
+            sample_every: config.sample_every.get().into(),
+            accesses: AtomicU64::new(0),
+            sketch: Mutex::new(BTreeMap::new()),
+            latest: Mutex::new(HotKeysReport::default()),
+        }
+    }
+
+    /// Record an access to the key produced by `key`, which is only called if the access is sampled.
+    pub fn record(&self, access: Access, key: impl FnOnce() -> HotKey) {
+        if self.accesses.fetch_add(1, Ordering::Relaxed) % self.sample_every != 0 {
+            return;
+        }
+
+        let key = key();
+        let mut sketch = self.sketch.lock();
+        let count = match sketch.get_mut(&key) {
+            Some(count) => count,
+            None => {
+                let error = if sketch.len() < self.top_k {
+                    0
+                } else {
+                    // Sketch is small, so linear search is cheaper than keeping it ordered by count
+                    let coldest = sketch
+                        .values()
+                        .min_by_key(|count| count.estimate())
+                        .expect("Sketch is not empty")
+                        .clone();
+                    sketch.remove(&coldest.key);
+                    coldest.estimate()
+                };
+                sketch.entry(key.clone()).or_insert(HotKeyCount {
+                    key,
+                    reads: 0,
+                    writes: 0,
+                    error,
+                })
+            }
+        };
+        match access {
+            Access::Read => count.reads += self.sample_every,
+            Access::Write => count.writes += self.sample_every,
+        }
+    }
+
+    /// Forget accesses made before execution of a new block started
+    pub fn start_block(&self) {
+        self.sketch.lock().clear();
+        self.accesses.store(0, Ordering::Relaxed);
+    }
+
+    /// Publish accesses made during execution of the block at `height`
+    pub fn finish_block(&self, height: u64) {
+        let mut keys: Vec<_> = core::mem::take(&mut *self.sketch.lock())
+            .into_values()
+            .collect();
+        keys.sort_by(|a, b| b.estimate().cmp(&a.estimate()).then(a.key.cmp(&b.key)));
+
+        *self.latest.lock() = HotKeysReport {
+            height,
+            accesses: self.accesses.swap(0, Ordering::Relaxed),
+            keys,
+        };
+    }
+
+    /// The most accessed keys of the latest committed block
+    pub fn latest(&self) -> HotKeysReport {
+        self.latest.lock().clone()
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use nonzero_ext::nonzero;
+    use test_samples::gen_account_in;
+
+    use super::*;
+
+    fn hot_keys(top_k: usize) -> HotKeys {
+        HotKeys::from_config(Config {
+            enabled: true,
+            top_k: top_k.try_into().expect("Not zero"),
+            sample_every: nonzero!(1_u32),
+        })
+    }
+
+    #[test]
+    fn hottest_key_survives_eviction() {
+        let hot_keys = hot_keys(2);
+        let (hot_id, _hot_keypair) = gen_account_in("wonderland");
+
+        hot_keys.start_block();
+        for _ in 0..10 {
+            let (cold_id, _cold_keypair) = gen_account_in("wonderland");
+            hot_keys.record(Access::Write, || HotKey::Account(hot_id.clone()));
+            hot_keys.record(Access::Read, || HotKey::Account(cold_id));
+        }
+        hot_keys.record(Access::Write, || HotKey::Account(hot_id.clone()));
+        hot_keys.finish_block(1);
+
+        let report = hot_keys.latest();
+        assert_eq!(report.height, 1);
+        assert_eq!(report.accesses, 21);
+        assert_eq!(report.keys.len(), 2);
+        assert_eq!(
+            report.keys[0],
+            HotKeyCount {
+                key: HotKey::Account(hot_id),
+                reads: 0,
+                writes: 11,
+                error: 0,
+            }
+        );
+    }
+
+    #[test]
+    fn report_covers_single_block() {
+        let hot_keys = hot_keys(4);
+        let definition_id: AssetDefinitionId = "rose#wonderland".parse().unwrap();
+
+        hot_keys.start_block();
+        hot_keys.record(Access::Read, || {
+            HotKey::AssetDefinition(definition_id.clone())
+        });
+        hot_keys.finish_block(1);
+
+        hot_keys.start_block();
+        hot_keys.finish_block(2);
+
+        assert_eq!(
+            hot_keys.latest(),
+            HotKeysReport {
+                height: 2,
+                accesses: 0,
+                keys: Vec::new(),
+            }
+        );
+    }
+}
@@ -3,40 +3,92 @@
 //! new [`Block`](`crate::block::SignedBlock`)s on the
 //! blockchain.
 use std::{
+    borrow::Cow,
+    collections::{BTreeMap, BTreeSet},
     fmt::Debug,
     fs,
-    io::{BufWriter, Read, Seek, SeekFrom, Write},
+    io::{BufWriter, IoSlice, Read, Seek, SeekFrom, Write},
+    ops::{Deref, DerefMut, Range},
     path::{Path, PathBuf},
-    sync::Arc,
+    sync::{
+        atomic::{AtomicUsize, Ordering},
+        Arc, OnceLock,
+    },
+    time::{Duration, Instant},
 };
 
-use iroha_config::{kura::InitMode, parameters::actual::Kura as Config};
+use iroha_config::{
+    kura::{BlockCompression, DurabilityMode, InitMode, PruningMode},
+    parameters::actual::Kura as Config,
+};
 use iroha_crypto::{Hash, HashOf};
-use iroha_data_model::block::SignedBlock;
+use iroha_data_model::{account::AccountId, block::SignedBlock, transaction::SignedTransaction};
 use iroha_logger::prelude::*;
+use iroha_telemetry::metrics::KuraDurableLatencyHistogram;
 use iroha_version::scale::{DecodeVersioned, EncodeVersioned};
-use parity_scale_codec::DecodeAll;
-use parking_lot::Mutex;
+use memmap2::Mmap;
+use parity_scale_codec::{DecodeAll, Encode as _};
+use parking_lot::{Condvar, Mutex, RwLock};
 
 use crate::{block::CommittedBlock, handler::ThreadHandler};
 
 const INDEX_FILE_NAME: &str = "blocks.index";
 const DATA_FILE_NAME: &str = "blocks.data";
 const HASHES_FILE_NAME: &str = "blocks.hashes";
+const CHECKSUMS_FILE_NAME: &str = "blocks.checksums";
+const SYNCED_FILE_NAME: &str = "blocks.synced";
+const TX_INDEX_FILE_NAME: &str = "blocks.tx_index";
+const TX_HASHES_FILE_NAME: &str = "blocks.tx_hashes";
+const TX_AUTHORITIES_FILE_NAME: &str = "blocks.tx_authorities";
+const ACCOUNT_TRANSACTIONS_FILE_NAME: &str = "blocks.account_transactions";
 const LOCK_FILE_NAME: &str = "kura.lock";
+const LAYOUT_FILE_NAME: &str = "blocks.layout";
+
+/// Number of blocks in one segment of the block store, see [`SegmentLayout`]
+pub const SEGMENT_SIZE: u64 = 10_000;
 
 const SIZE_OF_BLOCK_HASH: u64 = Hash::LENGTH as u64;
+const SIZE_OF_BLOCK_CHECKSUM: u64 = std::mem::size_of::<u32>() as u64;
+const SIZE_OF_TX_INDEX: u64 = std::mem::size_of::<u64>() as u64;
+const SIZE_OF_TX_HASH: u64 = Hash::LENGTH as u64;
+const SIZE_OF_BLOCK_INDEX: u64 = 2 * std::mem::size_of::<u64>() as u64;
+/// The top byte of the length in a block index holds the [`BlockCodec`] of the block.
+const BLOCK_CODEC_SHIFT: u32 = 56;
+const BLOCK_LENGTH_MASK: u64 = (1 << BLOCK_CODEC_SHIFT) - 1;
 
 /// The interface of Kura subsystem
 #[derive(Debug)]
 pub struct Kura {
     /// The mode of initialisation of [`Kura`].
     mode: InitMode,
+    /// When written blocks are flushed to the storage device.
+    durability_mode: DurabilityMode,
+    /// Period of flushing in [`DurabilityMode::Interval`].
+    sync_interval: Duration,
+    /// What happens to sealed segments once a snapshot covers them.
+    pruning_mode: PruningMode,
+    /// Destination of segments pruned in [`PruningMode::Archive`].
+    archive_dir: PathBuf,
+    /// Assignment of blocks to data files, kept to look up pruned blocks without locking `block_store`.
+    segment_layout: RwLock<SegmentLayout>,
     /// The block storage
     block_store: Mutex<BlockStore>,
+    /// Read-only memory map of the block storage used to load blocks without locking `block_store`.
+    /// It is replaced by a bigger map once the files outgrow it.
+    block_map: RwLock<Arc<BlockStoreMap>>,
+    /// Directory of the block storage.
+    store_dir: PathBuf,
     /// The array of block hashes and a slot for an arc of the block. This is normally recovered from the index file.
-    #[allow(clippy::type_complexity)]
-    block_data: Mutex<Vec<(HashOf<SignedBlock>, Option<Arc<SignedBlock>>)>>,
+    /// The slot is only filled while the block is waiting to be written to disk.
+    block_data: Mutex<BlockData>,
+    /// Wakes up the writer thread when new blocks are stored or on shutdown. Paired with `block_data`.
+    block_stored: Condvar,
+    /// Time from storing to flushing blocks, observed once metrics are set up.
+    durable_latency: OnceLock<KuraDurableLatencyHistogram>,
+    /// Blocks which are already on disk but are kept in memory for faster access.
+    block_cache: Mutex<BlockCache>,
+    /// Locations of the transactions of every account. Persisted in the transaction index of the block store.
+    account_transactions: RwLock<AccountTransactions>,
     /// Path to file for plain text blocks.
     block_plain_text_path: Option<PathBuf>,
 }
@@ -51,7 +103,8 @@ impl Kura {
     /// path.
     pub fn new(config: &Config) -> Result<(Arc<Self>, BlockCount)> {
         let store_dir = config.store_dir.resolve_relative_path();
-        let mut block_store = BlockStore::new(&store_dir, LockStatus::Unlocked);
+        let mut block_store = BlockStore::new(&store_dir, LockStatus::Unlocked)
+            .with_compression(config.block_compression.into());
         block_store.create_files_if_they_do_not_exist()?;
 
         let block_plain_text_path = config
@@ -60,8 +113,19 @@ impl Kura {
 
         let kura = Arc::new(Self {
             mode: config.init_mode,
+            durability_mode: config.durability_mode,
+            sync_interval: config.sync_interval,
+            pruning_mode: config.pruning_mode,
+            archive_dir: config.archive_dir.resolve_relative_path(),
+            segment_layout: RwLock::new(SegmentLayout::LEGACY),
             block_store: Mutex::new(block_store),
-            block_data: Mutex::new(Vec::new()),
+            block_map: RwLock::new(Arc::new(BlockStoreMap::default())),
+            store_dir,
+            block_data: Mutex::new(BlockData::default()),
+            block_stored: Condvar::new(),
+            durable_latency: OnceLock::new(),
+            block_cache: Mutex::new(BlockCache::new(config.block_cache_size_bytes)),
+            account_transactions: RwLock::new(AccountTransactions::default()),
             block_plain_text_path,
         });
 
@@ -75,8 +139,21 @@ impl Kura {
     pub fn blank_kura_for_testing() -> Arc<Kura> {
         Arc::new(Self {
             mode: InitMode::Strict,
+            durability_mode: DurabilityMode::None,
+            sync_interval: iroha_config::parameters::defaults::kura::SYNC_INTERVAL,
+            pruning_mode: PruningMode::None,
+            archive_dir: PathBuf::new(),
+            segment_layout: RwLock::new(SegmentLayout::LEGACY),
             block_store: Mutex::new(BlockStore::new(PathBuf::new(), LockStatus::Locked)),
-            block_data: Mutex::new(Vec::new()),
+            block_map: RwLock::new(Arc::new(BlockStoreMap::default())),
+            store_dir: PathBuf::new(),
+            block_data: Mutex::new(BlockData::default()),
+            block_stored: Condvar::new(),
+            durable_latency: OnceLock::new(),
+            block_cache: Mutex::new(BlockCache::new(
+                iroha_config::parameters::defaults::kura::BLOCK_CACHE_SIZE,
+            )),
+            account_transactions: RwLock::new(AccountTransactions::default()),
             block_plain_text_path: None,
         })
     }
@@ -86,14 +163,21 @@ impl Kura {
         // Oneshot channel to allow forcefully stopping the thread.
         let (shutdown_sender, shutdown_receiver) = tokio::sync::oneshot::channel();
 
-        let thread_handle = std::thread::spawn(move || {
-            Self::kura_receive_blocks_loop(&kura, shutdown_receiver);
-        });
+        let thread_handle = {
+            let kura = Arc::clone(&kura);
+            std::thread::spawn(move || {
+                Self::kura_receive_blocks_loop(&kura, shutdown_receiver);
+            })
+        };
 
         let shutdown = move || {
             if let Err(error) = shutdown_sender.send(()) {
                 iroha_logger::error!(?error);
             }
+            // Notify under the lock so that the wakeup can't slip in between
+            // the writer checking for shutdown and going to sleep.
+            let _block_data_guard = kura.block_data.lock();
+            kura.block_stored.notify_one();
         };
 
         ThreadHandler::new(Box::new(shutdown), thread_handle)
@@ -114,22 +198,45 @@ impl Kura {
             .try_into()
             .expect("We don't have 4 billion blocks.");
 
+        let layout = block_store.layout()?;
+        *self.segment_layout.write() = layout;
         let block_hashes = match self.mode {
             InitMode::Fast => {
                 Kura::init_fast_mode(&block_store, block_index_count).or_else(|error| {
-                    warn!(%error, "Hashes file is broken. Falling back to strict init mode.");
-                    Kura::init_strict_mode(&mut block_store, block_index_count)
+                    // Sealed segments never change, so only the active one has to be recovered
+                    let trusted = Kura::sealed_blocks(&block_store, layout, block_index_count);
+                    warn!(%error, sealed_block_count=trusted.end, "Hashes file is broken. Falling back to strict init mode for blocks which are not sealed.");
+                    Kura::init_strict_mode(&mut block_store, block_index_count, trusted)
                 })
             }
-            InitMode::Strict => Kura::init_strict_mode(&mut block_store, block_index_count),
+            InitMode::Strict => {
+                let trusted = Kura::pruned_blocks(layout, block_index_count);
+                Kura::init_strict_mode(&mut block_store, block_index_count, trusted)
+            }
+            InitMode::Verify => Kura::init_verify_mode(&mut block_store, block_index_count),
         }?;
 
         let block_count = block_hashes.len();
+        if block_count != block_index_count {
+            // Drop the unreadable tail right away: once the index file is mapped it must never shrink.
+            block_store.write_index_count(block_count as u64)?;
+        }
+        let account_transactions = block_store
+            .read_account_transactions(block_count as u64)
+            .or_else(|error| {
+                warn!(%error, "Transaction index is broken. Collecting account transactions from blocks.");
+                let block_map = BlockStoreMap::new(&block_store.path_to_blockchain)?;
+                Ok::<_, Error>(AccountTransactions::from_blocks(&block_map, block_count as u64))
+            })?;
+        *self.account_transactions.write() = account_transactions;
         info!(mode=?self.mode, block_count, "Kura init complete");
 
         // The none value is set in order to indicate that the blocks exist on disk but
         // are not yet loaded.
-        *self.block_data.lock() = block_hashes.into_iter().map(|hash| (hash, None)).collect();
+        let mut block_data = self.block_data.lock();
+        for hash in block_hashes {
+            block_data.push(hash, None);
+        }
         Ok(BlockCount(block_count))
     }
 
@@ -148,42 +255,289 @@ impl Kura {
         }
     }
 
+    /// Check the stored checksums of all blocks and only decode the blocks which might not have
+    /// reached the storage device before the last shutdown, taking other hashes from the hashes file.
+    fn init_verify_mode(
+        block_store: &mut BlockStore,
+        block_index_count: usize,
+    ) -> Result<Vec<HashOf<SignedBlock>>, Error> {
+        let layout = block_store.layout()?;
+        let mut block_hashes = match Kura::init_fast_mode(block_store, block_index_count) {
+            Ok(block_hashes) => block_hashes,
+            Err(error) => {
+                let trusted = Kura::sealed_blocks(block_store, layout, block_index_count);
+                warn!(%error, sealed_block_count=trusted.end, "Hashes file is broken. Falling back to strict init mode for blocks which are not sealed.");
+                return Kura::init_strict_mode(block_store, block_index_count, trusted);
+            }
+        };
+        let Some(last_block) = block_index_count.checked_sub(1) else {
+            return Ok(block_hashes);
+        };
+
+        let block_map = BlockStoreMap::new(&block_store.path_to_blockchain)?;
+        let checksum_count = usize::try_from(block_store.read_checksums_count()?)
+            .expect("We don't have 4 billion blocks.")
+            .min(block_index_count);
+        let checksums = block_store.read_block_checksums(0, checksum_count)?;
+        let started_at = Instant::now();
+        let verified_count =
+            first_corrupted_block(&block_map, &checksums).unwrap_or(checksum_count);
+        if verified_count < checksum_count {
+            error!(
+                block_number = verified_count,
+                "Block doesn't match its checksum. Not trusting any blocks beyond this height."
+            );
+        }
+
+        // Without a flush the whole active segment might be torn
+        let synced_count = block_store
+            .read_synced_count()?
+            .unwrap_or_else(|| layout.file_start(last_block as u64));
+        let tail_start = usize::try_from(synced_count)
+            .expect("We don't have 4 billion blocks.")
+            .min(verified_count)
+            .min(last_block);
+        info!(
+            verified_count,
+            elapsed_ms = started_at.elapsed().as_millis(),
+            tail_length = block_index_count - tail_start,
+            "Checked block checksums, decoding the tail"
+        );
+
+        block_hashes.truncate(tail_start);
+        let mut buffer = Vec::new();
+        for block_number in tail_start..block_index_count {
+            match BlockLink::decode(&block_map, block_number, &mut buffer) {
+                Ok((link, _)) => {
+                    if block_hashes.last().copied() != link.previous_block_hash {
+                        error!("Block has wrong previous block hash. Not reading any blocks beyond this height.");
+                        break;
+                    }
+                    block_hashes.push(link.hash);
+                }
+                Err(error) => {
+                    error!(?error, "Encountered malformed block, malformed block index or corrupted block data file. Not reading any blocks beyond this height.");
+                    break;
+                }
+            }
+        }
+
+        if block_hashes.len() != block_index_count {
+            block_store.overwrite_block_hashes(&block_hashes)?;
+        }
+        Ok(block_hashes)
+    }
+
+    /// Blocks which can't be decoded because their segments were pruned.
+    fn pruned_blocks(layout: SegmentLayout, block_index_count: usize) -> Range<usize> {
+        let first_prunable = layout.legacy_block_count.max(SEGMENT_SIZE);
+        let start = usize::try_from(first_prunable)
+            .map_or(block_index_count, |start| start.min(block_index_count));
+        let end = usize::try_from(layout.pruned_below)
+            .expect("We don't have 4 billion blocks.")
+            .clamp(start, block_index_count);
+        start..end
+    }
+
+    /// Blocks in the sealed segments preceding the active one whose hashes can be taken from the
+    /// hashes file. Segments are only trusted up to the first one which doesn't match its checksum,
+    /// while blocks of the legacy data file have no segment checksum and are always decoded.
+    fn sealed_blocks(
+        block_store: &BlockStore,
+        layout: SegmentLayout,
+        block_index_count: usize,
+    ) -> Range<usize> {
+        let pruned = Kura::pruned_blocks(layout, block_index_count);
+        let active_file_start = block_index_count.checked_sub(1).map_or(0, |last_block| {
+            usize::try_from(layout.file_start(last_block as u64))
+                .expect("We don't have 4 billion blocks.")
+        });
+        let hashes_count = block_store
+            .read_hashes_count()
+            .map_or(0, |count| usize::try_from(count).unwrap_or(usize::MAX));
+        if hashes_count < active_file_start {
+            return pruned;
+        }
+
+        let segments_start = usize::try_from(layout.legacy_block_count)
+            .map_or(active_file_start, |start| start.min(active_file_start));
+        let segment_of = |block_number: usize| {
+            layout
+                .segment(block_number as u64)
+                .expect("Blocks after the legacy ones are stored in segments")
+        };
+        let sealed_segments: Vec<_> = if segments_start < active_file_start {
+            (segment_of(segments_start)..=segment_of(active_file_start - 1))
+                .filter(|segment| !layout.is_pruned((segment + 1) * SEGMENT_SIZE - 1))
+                .collect()
+        } else {
+            Vec::new()
+        };
+        let verified = Kura::verify_segments(block_store, &sealed_segments);
+
+        let mut trusted = segments_start..segments_start;
+        while trusted.end < active_file_start {
+            let segment = segment_of(trusted.end);
+            if !pruned.contains(&trusted.end) && verified.get(&segment) != Some(&true) {
+                warn!(
+                    segment,
+                    "Sealed segment doesn't match its checksum, decoding it."
+                );
+                break;
+            }
+            trusted.end = usize::try_from((segment + 1) * SEGMENT_SIZE)
+                .map_or(active_file_start, |end| end.min(active_file_start));
+        }
+        // Pruned blocks can't be decoded, so they are trusted even after a broken segment
+        if trusted.end < pruned.end {
+            pruned
+        } else {
+            trusted
+        }
+    }
+
+    /// Check sealed `segments` against their stored checksums in parallel.
+    fn verify_segments(block_store: &BlockStore, segments: &[u64]) -> BTreeMap<u64, bool> {
+        let worker_count = std::thread::available_parallelism()
+            .map_or(1, std::num::NonZeroUsize::get)
+            .min(segments.len());
+        let next_segment = AtomicUsize::new(0);
+
+        std::thread::scope(|scope| {
+            let workers: Vec<_> = (0..worker_count)
+                .map(|_| {
+                    scope.spawn(|| {
+                        let mut verified = Vec::new();
+                        while let Some(&segment) =
+                            segments.get(next_segment.fetch_add(1, Ordering::Relaxed))
+                        {
+                            let is_valid =
+                                block_store.verify_segment(segment).unwrap_or_else(|error| {
+                                    warn!(%error, segment, "Failed to verify sealed segment");
+                                    false
+                                });
+                            verified.push((segment, is_valid));
+                        }
+                        verified
+                    })
+                })
+                .collect();
+
+            workers
+                .into_iter()
+                .flat_map(|worker| worker.join().expect("Kura init worker panicked"))
+                .collect()
+        })
+    }
+
+    /// Decode and validate all blocks in parallel, then check that they form a chain.
+    /// Hashes of `trusted` blocks are taken from the hashes file instead.
+    ///
+    /// Blocks are split into chunks of consecutive heights which worker threads decode straight
+    /// from the memory mapped block store. Only hashes are kept, so linking them up afterwards
+    /// is a cheap sequential pass.
     fn init_strict_mode(
         block_store: &mut BlockStore,
         block_index_count: usize,
+        trusted: Range<usize>,
     ) -> Result<Vec<HashOf<SignedBlock>>, Error> {
-        let mut block_hashes = Vec::with_capacity(block_index_count);
+        let block_map = BlockStoreMap::new(&block_store.path_to_blockchain)?;
+        let trusted_hashes = block_store.read_block_hashes(trusted.start as u64, trusted.len())?;
+        let progress = StrictInitProgress::new(block_index_count - trusted.len());
+
+        let chunks_to_decode: Vec<_> = [0..trusted.start, trusted.end..block_index_count]
+            .into_iter()
+            .flat_map(|range| {
+                range
+                    .clone()
+                    .step_by(STRICT_INIT_CHUNK_SIZE)
+                    .map(move |start| start..(start + STRICT_INIT_CHUNK_SIZE).min(range.end))
+            })
+            .collect();
+        let chunk_count = chunks_to_decode.len();
+        let worker_count = std::thread::available_parallelism()
+            .map_or(1, std::num::NonZeroUsize::get)
+            .min(chunk_count);
+        let next_chunk = AtomicUsize::new(0);
+        // Chunks above the first broken block don't have to be decoded
+        let first_broken_block = AtomicUsize::new(usize::MAX);
+
+        let mut chunks = std::thread::scope(|scope| {
+            let workers: Vec<_> = (0..worker_count)
+                .map(|_| {
+                    scope.spawn(|| {
+                        let mut chunks = Vec::new();
+                        let mut buffer = Vec::new();
+                        loop {
+                            let chunk = next_chunk.fetch_add(1, Ordering::Relaxed);
+                            let Some(range) = chunks_to_decode.get(chunk) else {
+                                return chunks;
+                            };
+                            if range.start > first_broken_block.load(Ordering::Relaxed) {
+                                return chunks;
+                            }
+
+                            let mut links = Vec::with_capacity(range.len());
+                            let mut bytes = 0;
+                            for block_number in range.clone() {
+                                let link = BlockLink::decode(&block_map, block_number, &mut buffer);
+                                match link {
+                                    Ok((link, size)) => {
+                                        links.push(Ok(link));
+                                        bytes += size;
+                                    }
+                                    Err(error) => {
+                                        first_broken_block
+                                            .fetch_min(block_number, Ordering::Relaxed);
+                                        links.push(Err(error));
+                                        break;
+                                    }
+                                }
+                            }
+                            progress.advance(links.len(), bytes);
+                            chunks.push((chunk, links));
+                        }
+                    })
+                })
+                .collect();
 
-        let mut block_indices = vec![BlockIndex::default(); block_index_count];
-        block_store.read_block_indices(0, &mut block_indices)?;
+            workers
+                .into_iter()
+                .flat_map(|worker| worker.join().expect("Kura init worker panicked"))
+                .collect::<Vec<_>>()
+        });
+        chunks.sort_unstable_by_key(|(chunk, _)| *chunk);
 
+        let mut block_hashes = Vec::with_capacity(block_index_count);
         let mut prev_block_hash = None;
-        for block in block_indices {
-            // This is re-allocated every iteration. This could cause a problem.
-            let mut block_data_buffer = vec![0_u8; block.length.try_into()?];
-
-            match block_store.read_block_data(block.start, &mut block_data_buffer) {
-                Ok(()) => match SignedBlock::decode_all_versioned(&block_data_buffer) {
-                    Ok(decoded_block) => {
-                        if prev_block_hash != decoded_block.header().previous_block_hash {
-                            error!("Block has wrong previous block hash. Not reading any blocks beyond this height.");
-                            break;
-                        }
-                        let decoded_block_hash = decoded_block.hash();
-                        block_hashes.push(decoded_block_hash);
-                        prev_block_hash = Some(decoded_block_hash);
-                    }
-                    Err(error) => {
-                        error!(?error, "Encountered malformed block. Not reading any blocks beyond this height.");
+        let mut links = chunks.into_iter().flat_map(|(_, links)| links);
+        for block_number in 0..block_index_count {
+            if trusted.contains(&block_number) {
+                let hash = trusted_hashes[block_number - trusted.start];
+                block_hashes.push(hash);
+                prev_block_hash = Some(hash);
+                continue;
+            }
+            // Chunks are only skipped above a broken block
+            let Some(link) = links.next() else {
+                break;
+            };
+            match link {
+                Ok(link) => {
+                    if prev_block_hash != link.previous_block_hash {
+                        error!("Block has wrong previous block hash. Not reading any blocks beyond this height.");
                         break;
                     }
-                },
+                    block_hashes.push(link.hash);
+                    prev_block_hash = Some(link.hash);
+                }
                 Err(error) => {
-                    error!(?error, "Malformed block index or corrupted block data file. Not reading any blocks beyond this height.");
+                    error!(?error, "Encountered malformed block, malformed block index or corrupted block data file. Not reading any blocks beyond this height.");
                     break;
                 }
             }
         }
+        progress.finish();
 
         block_store.overwrite_block_hashes(&block_hashes)?;
 
@@ -199,16 +553,20 @@ impl Kura {
             let block_data_guard = kura.block_data.lock();
             (block_data_guard.len(), block_data_guard.last().map(|d| d.0))
         };
+        let mut account_checkpoint_count = Self::account_checkpoint_count(written_block_count);
         let mut should_exit = false;
+        // Times at which the blocks written since the last flush were stored
+        let mut unsynced_blocks = Vec::new();
+        let mut last_sync = Instant::now();
         loop {
+            let mut block_data_guard = kura.block_data.lock();
+
             // If kura receive shutdown then close block channel and write remaining blocks to the storage
-            if shutdown_receiver.try_recv().is_ok() {
+            if !should_exit && shutdown_receiver.try_recv().is_ok() {
                 info!("Kura block thread is being shut down. Writing remaining blocks to store.");
                 should_exit = true;
             }
 
-            let block_data_guard = kura.block_data.lock();
-
             let new_latest_block_hash = block_data_guard.last().map(|d| d.0);
             if block_data_guard.len() == written_block_count
                 && new_latest_block_hash != latest_block_hash
@@ -218,14 +576,31 @@ impl Kura {
             latest_block_hash = new_latest_block_hash;
 
             if written_block_count >= block_data_guard.len() {
+                written_block_count = block_data_guard.len();
+
                 if should_exit {
+                    drop(block_data_guard);
+                    kura.sync_written_blocks(&mut unsynced_blocks);
                     info!("Kura has written remaining blocks to disk and is shutting down.");
                     return;
                 }
 
-                written_block_count = block_data_guard.len();
-                drop(block_data_guard);
-                std::thread::sleep(std::time::Duration::from_millis(1));
+                // Sleep until new blocks are stored, shutdown is requested or the pending flush is due
+                match kura.durability_mode {
+                    DurabilityMode::Interval if !unsynced_blocks.is_empty() => {
+                        let sync_at = last_sync + kura.sync_interval;
+                        if kura
+                            .block_stored
+                            .wait_until(&mut block_data_guard, sync_at)
+                            .timed_out()
+                        {
+                            drop(block_data_guard);
+                            kura.sync_written_blocks(&mut unsynced_blocks);
+                            last_sync = Instant::now();
+                        }
+                    }
+                    _ => kura.block_stored.wait(&mut block_data_guard),
+                }
                 continue;
             }
 
@@ -238,6 +613,9 @@ impl Kura {
                     .as_ref()
                     .expect("The block to be written cannot be None, see store_block function.");
                 blocks_to_be_written.push(Arc::clone(block_ref));
+                if let Some(stored_at) = block_data_guard.take_stored_at(written_block_count) {
+                    unsynced_blocks.push(stored_at);
+                }
                 written_block_count += 1;
             }
 
@@ -257,21 +635,152 @@ impl Kura {
                 }
             }
 
-            let mut block_store_guard = kura.block_store.lock();
-            if let Err(error) = block_store_guard.write_index_count(start_height as u64) {
-                error!(?error, "Failed to write index count");
+            // All blocks which piled up since the last iteration are written as one batch.
+            // Blocks are written at explicit heights instead of truncating the index first,
+            // so that a soft-fork never shrinks files which are mapped by readers.
+            if let Err(error) = kura.block_store.lock().write_blocks_at_height(
+                start_height as u64,
+                blocks_to_be_written.iter().map(|block| &**block),
+            ) {
+                error!(?error, "Failed to store blocks");
                 panic!("Kura has encountered a fatal IO error.");
             }
 
-            for block in blocks_to_be_written {
-                if let Err(error) = block_store_guard.append_block_to_chain(&block) {
-                    error!(?error, "Failed to store block");
-                    panic!("Kura has encountered a fatal IO error.");
+            kura.release_written_blocks(start_height, blocks_to_be_written);
+
+            let checkpoint_count = Self::account_checkpoint_count(written_block_count);
+            if checkpoint_count > account_checkpoint_count {
+                kura.checkpoint_account_transactions(checkpoint_count);
+                account_checkpoint_count = checkpoint_count;
+            }
+
+            match kura.durability_mode {
+                DurabilityMode::Interval if last_sync.elapsed() < kura.sync_interval => {}
+                DurabilityMode::Batch | DurabilityMode::Interval => {
+                    kura.sync_written_blocks(&mut unsynced_blocks);
+                    last_sync = Instant::now();
                 }
+                DurabilityMode::None => kura.report_durable_blocks(&mut unsynced_blocks),
+            }
+        }
+    }
+
+    /// Flush written blocks to the storage device according to the durability mode.
+    fn sync_written_blocks(&self, unsynced_blocks: &mut Vec<Instant>) {
+        if unsynced_blocks.is_empty() {
+            return;
+        }
+        if self.durability_mode != DurabilityMode::None {
+            if let Err(error) = self.block_store.lock().sync() {
+                error!(?error, "Failed to flush blocks");
+                panic!("Kura has encountered a fatal IO error.");
+            }
+        }
+        self.report_durable_blocks(unsynced_blocks);
+    }
+
+    fn report_durable_blocks(&self, unsynced_blocks: &mut Vec<Instant>) {
+        let latencies = unsynced_blocks
+            .drain(..)
+            .map(|stored_at| stored_at.elapsed());
+        if let Some(histogram) = self.durable_latency.get() {
+            for latency in latencies {
+                histogram.observe(latency.as_secs_f64());
+            }
+        }
+    }
+
+    /// Observe the time it takes stored blocks to become durable in `histogram`.
+    /// Only the first histogram is used and blocks which became durable before are not observed.
+    ///
+    /// Without a durability mode this is the time until the blocks are handed over to the operating system.
+    pub fn observe_durable_latency(&self, histogram: KuraDurableLatencyHistogram) {
+        let _ = self.durable_latency.set(histogram);
+    }
+
+    /// Number of blocks covered by the checkpoint of account transactions once `block_count`
+    /// blocks are written. Checkpoints are taken every [`SEGMENT_SIZE`] blocks and never
+    /// include the top block, which might still be replaced by a soft-fork.
+    fn account_checkpoint_count(block_count: usize) -> u64 {
+        (block_count as u64).saturating_sub(1) / SEGMENT_SIZE * SEGMENT_SIZE
+    }
+
+    /// Persist the account transactions of the first `block_count` blocks,
+    /// so that init only has to read the transaction index of the blocks after them.
+    fn checkpoint_account_transactions(&self, block_count: u64) {
+        let bytes = AccountTransactions::encode_checkpoint(&self.account_transactions, block_count);
+        if let Err(error) = self
+            .block_store
+            .lock()
+            .write_account_transactions_checkpoint(&bytes)
+        {
+            // Init falls back to reading the whole transaction index
+            warn!(?error, "Failed to persist account transactions");
+        }
+    }
+
+    /// Hand blocks which are now on disk over from the write slots to the bounded block cache.
+    fn release_written_blocks(&self, start_height: usize, blocks: Vec<Arc<SignedBlock>>) {
+        let mut block_data_guard = self.block_data.lock();
+        let mut block_cache_guard = self.block_cache.lock();
+        for (block_number, block) in (start_height..).zip(blocks) {
+            let Some((_, slot)) = block_data_guard.get_mut(block_number) else {
+                break;
+            };
+            // The block might have been replaced by a soft-fork in the meantime
+            if slot
+                .as_ref()
+                .is_some_and(|pending| Arc::ptr_eq(pending, &block))
+            {
+                *slot = None;
+                let size = block.encoded_size() as u64;
+                block_cache_guard.insert(block_number, block, size);
+            }
+        }
+    }
+
+    /// Prune sealed segments which only contain blocks below `block_height` according to the pruning mode.
+    ///
+    /// Pruned blocks can't be loaded anymore, so this should only be called for blocks covered by a snapshot.
+    pub fn prune_blocks_below(&self, block_height: u64) {
+        let archive_dir = match self.pruning_mode {
+            PruningMode::None => return,
+            PruningMode::Archive => Some(self.archive_dir.as_path()),
+            PruningMode::Delete => None,
+        };
+        // Heights start at 1 while block numbers start at 0
+        let Some(block_number) = block_height.checked_sub(1) else {
+            return;
+        };
+        let mut block_store = self.block_store.lock();
+        let pruned = block_store.prune_segments_below(block_number, archive_dir);
+        // The layout is updated even on failure since some segments might have been pruned
+        if let Ok(layout) = block_store.layout() {
+            *self.segment_layout.write() = layout;
+        }
+        drop(block_store);
+        match pruned {
+            Ok(0) => {}
+            Ok(pruned_count) => {
+                info!(mode=%self.pruning_mode, pruned_count, block_height, "Pruned block segments");
             }
+            Err(error) => error!(?error, "Failed to prune block segments"),
         }
     }
 
+    /// Heights of the blocks which were pruned and can't be loaded anymore,
+    /// see [`Self::prune_blocks_below`].
+    pub fn pruned_block_heights(&self) -> Range<u64> {
+        let pruned = self.segment_layout.read().pruned_blocks();
+        // Heights start at 1 while block numbers start at 0
+        pruned.start.saturating_add(1)..pruned.end.saturating_add(1)
+    }
+
+    /// Get the statistics of the block cache.
+    pub fn block_cache_stats(&self) -> BlockCacheStats {
+        self.block_cache.lock().stats()
+    }
+
     /// Get the hash of the block at the provided height.
     pub fn get_block_hash(&self, block_height: u64) -> Option<HashOf<SignedBlock>> {
         let hash_data_guard = self.block_data.lock();
@@ -284,59 +793,190 @@ impl Kura {
         Some(hash_data_guard[index].0)
     }
 
-    /// Search through blocks for the height of the block with the given hash.
+    /// Look up the height of the block with the given hash.
     pub fn get_block_height_by_hash(&self, hash: &HashOf<SignedBlock>) -> Option<u64> {
         self.block_data
             .lock()
-            .iter()
-            .position(|(block_hash, _block_arc)| block_hash == hash)
+            .block_number(hash)
             .map(|index| index as u64 + 1)
     }
 
     /// Get a reference to block by height, loading it from disk if needed.
-    // The below lint suggests changing the code into something that does not compile due
-    // to the borrow checker.
+    ///
+    /// Blocks which are not in memory are decoded straight from the memory
+    /// mapped block store, so concurrent readers don't contend on a lock.
+    /// Returns [`None`] for blocks whose segment was pruned.
     pub fn get_block_by_height(&self, block_height: u64) -> Option<Arc<SignedBlock>> {
-        let mut data_array_guard = self.block_data.lock();
-        if block_height == 0 || block_height > data_array_guard.len() as u64 {
-            return None;
-        }
-        let block_number: usize = (block_height - 1)
-            .try_into()
-            .expect("Failed to cast to u32.");
+        let block_number = {
+            let data_array_guard = self.block_data.lock();
+            if block_height == 0 || block_height > data_array_guard.len() as u64 {
+                return None;
+            }
+            let block_number: usize = (block_height - 1)
+                .try_into()
+                .expect("Failed to cast to u32.");
 
-        if let Some(block_arc) = data_array_guard[block_number].1.as_ref() {
-            return Some(Arc::clone(block_arc));
+            if let Some(block_arc) = data_array_guard[block_number].1.as_ref() {
+                return Some(Arc::clone(block_arc));
+            };
+            block_number
         };
 
-        let block_store = self.block_store.lock();
-        let BlockIndex { start, length } = block_store
-            .read_block_index(block_number as u64)
-            .expect("Failed to read block index from disk.");
-
-        let mut block_buf =
-            vec![0_u8; usize::try_from(length).expect("index_len didn't fit in 32-bits")];
-        block_store
-            .read_block_data(start, &mut block_buf)
-            .expect("Failed to read block data.");
-        let block = SignedBlock::decode_all_versioned(&block_buf).expect("Failed to decode block");
+        if let Some(block_arc) = self.block_cache.lock().get(block_number) {
+            return Some(block_arc);
+        }
 
+        let (block, size) = self.read_block_from_disk(block_number as u64)?;
         let block_arc = Arc::new(block);
-        data_array_guard[block_number].1 = Some(Arc::clone(&block_arc));
+        // The block might have been replaced by a soft-fork while it was read,
+        // in which case it must not end up in the cache
+        let block_data_guard = self.block_data.lock();
+        if block_data_guard
+            .get(block_number)
+            .is_some_and(|(hash, slot)| slot.is_none() && *hash == block_arc.hash())
+        {
+            self.block_cache
+                .lock()
+                .insert(block_number, Arc::clone(&block_arc), size);
+        }
         Some(block_arc)
     }
 
+    /// Decode the block with the given number straight from the memory mapped block store
+    /// together with the size of its encoding. Returns [`None`] if the block was pruned.
+    ///
+    /// The top block can be replaced by a soft-fork during the read. The replacement is appended
+    /// to its data file before the index is switched to it, so the read is retried once on a fresh
+    /// map if the indexed frame is not mapped yet or doesn't decode.
+    fn read_block_from_disk(&self, block_number: u64) -> Option<(SignedBlock, u64)> {
+        let mut block_map = self.block_map_with(block_number);
+        let mut is_retry = false;
+        loop {
+            if block_map.is_pruned(block_number) {
+                return None;
+            }
+            let block = block_map
+                .block_frame(block_number)
+                .ok_or(Error::OutOfBoundsBlockRead {
+                    start_block_height: block_number,
+                    block_count: 1,
+                })
+                .and_then(|(codec, frame)| {
+                    let bytes = codec.decompress(frame)?;
+                    let block = SignedBlock::decode_all_versioned(&bytes)?;
+                    Ok((block, bytes.len() as u64))
+                });
+            match block {
+                Ok(block) => return Some(block),
+                Err(_) if !is_retry => {
+                    is_retry = true;
+                    block_map = self.refresh_block_map();
+                }
+                Err(error) => {
+                    error!(?error, block_number, "Failed to read block");
+                    panic!("Block which is not in memory must be present on disk.");
+                }
+            }
+        }
+    }
+
+    /// Get the memory map of the block store which contains the block with the given number,
+    /// remapping the files if they have grown since the last mapping.
+    fn block_map_with(&self, block_number: u64) -> Arc<BlockStoreMap> {
+        let block_map = Arc::clone(&*self.block_map.read());
+        if block_map.contains(block_number) || block_map.is_pruned(block_number) {
+            return block_map;
+        }
+
+        let mut block_map = self.block_map.write();
+        if !block_map.contains(block_number) && !block_map.is_pruned(block_number) {
+            // Segments which are already mapped are shared with the new map
+            *block_map = Arc::new(
+                block_map
+                    .refresh(&self.store_dir)
+                    .expect("Failed to map block store files."),
+            );
+        }
+        Arc::clone(&*block_map)
+    }
+
+    /// Map the block store files anew regardless of the blocks covered by the current map.
+    fn refresh_block_map(&self) -> Arc<BlockStoreMap> {
+        let mut block_map = self.block_map.write();
+        *block_map = Arc::new(
+            block_map
+                .refresh(&self.store_dir)
+                .expect("Failed to map block store files."),
+        );
+        Arc::clone(&*block_map)
+    }
+
+    /// Get the block at the provided height which contains the transaction with the given hash
+    /// together with the position of the transaction in the block.
+    ///
+    /// The position is looked up in the transaction index written next to the block,
+    /// so transactions don't have to be hashed again.
+    pub fn get_block_with_transaction(
+        &self,
+        block_height: u64,
+        tx_hash: &HashOf<SignedTransaction>,
+    ) -> Option<(Arc<SignedBlock>, usize)> {
+        let block = self.get_block_by_height(block_height)?;
+        let block_number = block_height - 1;
+
+        let is_on_disk = self
+            .block_data
+            .lock()
+            .get(block_number as usize)
+            .is_some_and(|(_, slot)| slot.is_none());
+        let indexed_position = is_on_disk
+            .then(|| self.block_map_with(block_number))
+            .filter(|block_map| {
+                block_map.transaction_count(block_number) == Some(block.transactions().len())
+            })
+            .and_then(|block_map| block_map.transaction_position(block_number, tx_hash));
+        let position = indexed_position.or_else(|| {
+            block
+                .transactions()
+                .position(|tx| tx.as_ref().hash() == *tx_hash)
+        })?;
+        Some((block, position))
+    }
+
+    /// Iterate over the locations of all transactions submitted by the given account
+    /// in chain order, so that they can be paged through without loading unrelated blocks.
+    ///
+    /// Locations are copied out a page at a time, so the index is never locked while iterating.
+    pub fn get_account_transactions(
+        &self,
+        account_id: &AccountId,
+    ) -> impl Iterator<Item = TransactionLocation> + '_ {
+        const PAGE_SIZE: usize = 256;
+
+        let key = account_key(account_id);
+        let mut next_position = 0;
+        let mut page = Vec::new().into_iter();
+        std::iter::from_fn(move || {
+            if let Some(location) = page.next() {
+                return Some(location);
+            }
+            page = self
+                .account_transactions
+                .read()
+                .page(&key, next_position, PAGE_SIZE)
+                .into_iter();
+            next_position += page.len();
+            page.next()
+        })
+    }
+
     /// Get a reference to block by hash, loading it from disk if needed.
     ///
-    /// Internally this function searches linearly for the block's height and
+    /// Internally this function looks up the block's height and
     /// then calls `get_block_by_height`. If you know the height of the block,
     /// call `get_block_by_height` directly.
     pub fn get_block_by_hash(&self, block_hash: &HashOf<SignedBlock>) -> Option<Arc<SignedBlock>> {
-        let index = self
-            .block_data
-            .lock()
-            .iter()
-            .position(|(hash, _arc)| hash == block_hash);
+        let index = self.block_data.lock().block_number(block_hash);
 
         index.and_then(|index| self.get_block_by_height(index as u64 + 1))
     }
@@ -344,105 +984,1147 @@ impl Kura {
     /// Put a block in kura's in memory block store.
     pub fn store_block(&self, block: CommittedBlock) {
         let block = Arc::new(SignedBlock::from(block));
-        self.block_data.lock().push((block.hash(), Some(block)));
+        // Hashing is done before locking, so that readers and the writer thread aren't held up
+        let hash = block.hash();
+        let account_keys = AccountTransactions::block_keys(&block);
+        let mut data = self.block_data.lock();
+        self.account_transactions
+            .write()
+            .push_block(data.len() as u64 + 1, &account_keys);
+        data.push(hash, Some(block));
+        self.block_stored.notify_one();
     }
 
     /// Replace the block in `Kura`'s in memory block store.
     pub fn replace_top_block(&self, block: CommittedBlock) {
         let block = Arc::new(SignedBlock::from(block));
+        let hash = block.hash();
+        let account_keys = AccountTransactions::block_keys(&block);
         let mut data = self.block_data.lock();
         data.pop();
-        data.push((block.hash(), Some(block)));
+        self.block_cache.lock().remove(data.len());
+        let mut account_transactions = self.account_transactions.write();
+        account_transactions.pop_top_block(data.len() as u64 + 1);
+        account_transactions.push_block(data.len() as u64 + 1, &account_keys);
+        drop(account_transactions);
+        data.push(hash, Some(block));
+        self.block_stored.notify_one();
     }
 }
 
-/// Loaded block count
-#[derive(Clone, Copy, Debug)]
-pub struct BlockCount(pub usize);
+#[allow(clippy::disallowed_types)]
+type BlockNumbers = std::collections::HashMap<HashOf<SignedBlock>, usize>;
 
-/// An implementation of a block store for `Kura`
-/// that uses `std::fs`, the default IO file in Rust.
-#[derive(Debug)]
-pub struct BlockStore {
-    path_to_blockchain: PathBuf,
+/// Location of a committed transaction in the chain.
+#[derive(Debug, Clone, Copy, PartialEq, Eq)]
+pub struct TransactionLocation {
+    /// Height of the block containing the transaction
+    pub block_height: u64,
+    /// Position of the transaction in its block
+    pub index: usize,
 }
 
-impl Drop for BlockStore {
-    fn drop(&mut self) {
-        let path = self.path_to_blockchain.join(LOCK_FILE_NAME);
-        let _ = fs::remove_file(path); // we don't care if this succeeds or not
-    }
-}
+/// Hash of the encoded [`AccountId`] under which its transactions are indexed.
+type AccountKey = [u8; Hash::LENGTH];
 
-#[derive(Default, Debug, Clone, Copy)]
-/// Lightweight wrapper for block indices in the block index file
-pub struct BlockIndex {
-    /// Start of block in bytes
-    pub start: u64,
-    /// Length of block section in bytes
-    pub length: u64,
+fn account_key(account_id: &AccountId) -> AccountKey {
+    *Hash::new(account_id.encode()).as_ref()
 }
 
-/// Locked Status
-#[derive(Clone, Copy)]
-pub enum LockStatus {
-    /// Is locked
-    Locked,
-    /// Is unlocked
-    Unlocked,
+#[allow(clippy::disallowed_types)]
+type AccountTransactionMap = std::collections::HashMap<AccountKey, Vec<TransactionLocation>>;
+
+/// Append-only lists of transaction locations of every account in chain order.
+#[derive(Debug, Default)]
+struct AccountTransactions {
+    transactions: AccountTransactionMap,
+    /// Height of the top block and the accounts with transactions in it, needed to replace the block
+    top_block: (u64, Vec<AccountKey>),
 }
 
-impl BlockStore {
-    /// Create a new read-only block store in `path`.
-    ///
-    /// # Panics
-    /// * if you pass in `LockStatus::Unlocked` and it is unable to lock the block store.
-    pub fn new(store_path: impl AsRef<Path>, already_locked: LockStatus) -> Self {
-        if matches!(already_locked, LockStatus::Unlocked) {
-            let lock_path = store_path.as_ref().join(LOCK_FILE_NAME);
-            if let Err(e) = fs::File::options()
-                .read(true)
-                .write(true)
-                .create_new(true)
-                .open(&lock_path)
-            {
-                match e.kind() {
-                    std::io::ErrorKind::AlreadyExists => Err(Error::Locked(lock_path)),
-                    std::io::ErrorKind::NotFound => {
-                        match std::fs::create_dir_all(store_path.as_ref())
-                            .map_err(|e| Error::MkDir(e, store_path.as_ref().to_path_buf()))
-                        {
-                            Err(e) => Err(e),
-                            Ok(()) => {
-                                if let Err(e) = fs::File::options()
-                                    .read(true)
-                                    .write(true)
-                                    .create_new(true)
-                                    .open(&lock_path)
-                                {
-                                    Err(Error::IO(e, lock_path))
-                                } else {
-                                    Ok(())
-                                }
-                            }
-                        }
-                    }
-                    _ => Err(Error::IO(e, lock_path)),
-                }
-                .expect("Kura must be able to lock the blockstore");
+impl AccountTransactions {
+    /// Collect account transactions of the first `block_count` blocks by decoding them.
+    fn from_blocks(block_map: &BlockStoreMap, block_count: u64) -> Self {
+        let mut account_transactions = Self::default();
+        for block_number in 0..block_count {
+            if let Some(Ok(block)) = block_map.read_block(block_number) {
+                account_transactions.push_block(block_number + 1, &Self::block_keys(&block));
             }
         }
-        BlockStore {
-            path_to_blockchain: store_path.as_ref().to_path_buf(),
+        account_transactions
+    }
+
+    fn push(&mut self, key: AccountKey, location: TransactionLocation) {
+        if self.top_block.0 != location.block_height {
+            self.top_block = (location.block_height, Vec::new());
+        }
+        if self.top_block.1.last() != Some(&key) {
+            self.top_block.1.push(key);
         }
+        self.transactions.entry(key).or_default().push(location);
     }
 
-    /// Read a series of block indices from the block index file and
-    /// attempt to fill all of `dest_buffer`.
-    ///
-    /// # Errors
-    /// IO Error.
-    pub fn read_block_indices(
+    /// Keys of the authorities of the transactions in `block` in order.
+    fn block_keys(block: &SignedBlock) -> Vec<AccountKey> {
+        block
+            .transactions()
+            .map(|tx| account_key(tx.as_ref().authority()))
+            .collect()
+    }
+
+    fn push_block(&mut self, block_height: u64, account_keys: &[AccountKey]) {
+        for (index, key) in account_keys.iter().enumerate() {
+            let location = TransactionLocation {
+                block_height,
+                index,
+            };
+            self.push(*key, location);
+        }
+    }
+
+    /// Remove transactions of the block at `block_height` if it's the top one.
+    fn pop_top_block(&mut self, block_height: u64) {
+        if self.top_block.0 != block_height {
+            return;
+        }
+        let (_, keys) = core::mem::take(&mut self.top_block);
+        for key in keys {
+            let Some(locations) = self.transactions.get_mut(&key) else {
+                continue;
+            };
+            while locations
+                .last()
+                .is_some_and(|location| location.block_height == block_height)
+            {
+                locations.pop();
+            }
+            if locations.is_empty() {
+                self.transactions.remove(&key);
+            }
+        }
+    }
+
+    fn get(&self, account_id: &AccountId) -> Option<&[TransactionLocation]> {
+        self.transactions
+            .get(&account_key(account_id))
+            .map(Vec::as_slice)
+    }
+
+    /// Up to `page_size` locations of the account with `key` starting with the one at `start`.
+    fn page(&self, key: &AccountKey, start: usize, page_size: usize) -> Vec<TransactionLocation> {
+        self.transactions
+            .get(key)
+            .and_then(|locations| locations.get(start..))
+            .map_or_else(Vec::new, |locations| {
+                locations.iter().take(page_size).copied().collect()
+            })
+    }
+
+    /// Encode the locations of transactions in the first `block_count` blocks,
+    /// locking the index only while copying the locations of one account.
+    fn encode_checkpoint(this: &RwLock<Self>, block_count: u64) -> Vec<u8> {
+        let keys: Vec<_> = this.read().transactions.keys().copied().collect();
+        let accounts: Vec<_> = keys
+            .into_iter()
+            .filter_map(|key| {
+                let guard = this.read();
+                let locations = guard.transactions.get(&key)?;
+                let end =
+                    locations.partition_point(|location| location.block_height <= block_count);
+                let locations: Vec<_> = locations[..end]
+                    .iter()
+                    .map(|location| (location.block_height, location.index as u64))
+                    .collect();
+                (!locations.is_empty()).then_some((key, locations))
+            })
+            .collect();
+        (block_count, accounts).encode()
+    }
+
+    /// Decode a checkpoint written by [`Self::encode_checkpoint`] with its block count.
+    fn decode_checkpoint(mut bytes: &[u8]) -> Option<(u64, Self)> {
+        #[allow(clippy::type_complexity)]
+        let (block_count, accounts): (u64, Vec<(AccountKey, Vec<(u64, u64)>)>) =
+            DecodeAll::decode_all(&mut bytes).ok()?;
+        let mut account_transactions = Self::default();
+        for (key, locations) in accounts {
+            let locations = locations
+                .into_iter()
+                .map(|(block_height, index)| {
+                    Some(TransactionLocation {
+                        block_height,
+                        index: usize::try_from(index).ok()?,
+                    })
+                })
+                .collect::<Option<_>>()?;
+            account_transactions.transactions.insert(key, locations);
+        }
+        Some((block_count, account_transactions))
+    }
+}
+
+/// Hashes of all blocks in the chain together with slots for blocks which are not yet written to disk.
+///
+/// Dereferences to the slice of `(hash, slot)` pairs ordered by height, while keeping an index
+/// from block hash to block number (height - 1) in sync with it.
+#[derive(Debug, Default)]
+struct BlockData {
+    #[allow(clippy::type_complexity)]
+    blocks: Vec<(HashOf<SignedBlock>, Option<Arc<SignedBlock>>)>,
+    numbers: BlockNumbers,
+    /// Time at which blocks which are not yet picked up by the writer were stored
+    stored_at: BTreeMap<usize, Instant>,
+}
+
+impl BlockData {
+    fn push(&mut self, hash: HashOf<SignedBlock>, block: Option<Arc<SignedBlock>>) {
+        if block.is_some() {
+            self.stored_at.insert(self.blocks.len(), Instant::now());
+        }
+        self.numbers.entry(hash).or_insert(self.blocks.len());
+        self.blocks.push((hash, block));
+    }
+
+    fn pop(&mut self) -> Option<(HashOf<SignedBlock>, Option<Arc<SignedBlock>>)> {
+        let (hash, block) = self.blocks.pop()?;
+        self.stored_at.remove(&self.blocks.len());
+        if self.numbers.get(&hash) == Some(&self.blocks.len()) {
+            self.numbers.remove(&hash);
+        }
+        Some((hash, block))
+    }
+
+    fn block_number(&self, hash: &HashOf<SignedBlock>) -> Option<usize> {
+        self.numbers.get(hash).copied()
+    }
+
+    fn take_stored_at(&mut self, block_number: usize) -> Option<Instant> {
+        self.stored_at.remove(&block_number)
+    }
+}
+
+impl Deref for BlockData {
+    type Target = [(HashOf<SignedBlock>, Option<Arc<SignedBlock>>)];
+
+    fn deref(&self) -> &Self::Target {
+        &self.blocks
+    }
+}
+
+impl DerefMut for BlockData {
+    fn deref_mut(&mut self) -> &mut Self::Target {
+        &mut self.blocks
+    }
+}
+
+/// Number of consecutive blocks decoded by one worker at a time during strict initialisation
+const STRICT_INIT_CHUNK_SIZE: usize = 256;
+/// Number of decoded blocks between progress reports during strict initialisation
+const STRICT_INIT_PROGRESS_STEP: usize = 10_000;
+
+/// Part of a block needed to check that blocks form a chain
+struct BlockLink {
+    previous_block_hash: Option<HashOf<SignedBlock>>,
+    hash: HashOf<SignedBlock>,
+}
+
+impl BlockLink {
+    /// Decode (and thereby validate) the block with the given number and return its link
+    /// together with the size of its encoding.
+    fn decode(
+        block_map: &BlockStoreMap,
+        block_number: usize,
+        buffer: &mut Vec<u8>,
+    ) -> Result<(Self, usize)> {
+        let (codec, frame) =
+            block_map
+                .block_frame(block_number as u64)
+                .ok_or(Error::OutOfBoundsBlockRead {
+                    start_block_height: block_number as u64,
+                    block_count: 1,
+                })?;
+        let bytes = codec.decompress_into(frame, buffer)?;
+        let block = SignedBlock::decode_all_versioned(bytes)?;
+        let link = Self {
+            previous_block_hash: block.header().previous_block_hash,
+            hash: block.hash(),
+        };
+        Ok((link, bytes.len()))
+    }
+}
+
+/// Find the first block whose stored bytes don't match its checksum.
+///
+/// Blocks are split between worker threads in contiguous ranges, so checksums are computed at
+/// memory bandwidth. Pruned blocks are skipped.
+fn first_corrupted_block(block_map: &BlockStoreMap, checksums: &[u32]) -> Option<usize> {
+    let worker_count = std::thread::available_parallelism().map_or(1, std::num::NonZeroUsize::get);
+    let range_size = checksums.len().div_ceil(worker_count).max(1);
+    let first_corrupted_block = AtomicUsize::new(usize::MAX);
+
+    std::thread::scope(|scope| {
+        for (range_idx, range) in checksums.chunks(range_size).enumerate() {
+            let first_corrupted_block = &first_corrupted_block;
+            scope.spawn(move || {
+                let range_start = range_idx * range_size;
+                for (block_number, checksum) in (range_start..).zip(range) {
+                    if block_number > first_corrupted_block.load(Ordering::Relaxed) {
+                        return;
+                    }
+                    let block_number_u64 = block_number as u64;
+                    if block_map.is_pruned(block_number_u64) {
+                        continue;
+                    }
+                    if block_map.block_checksum(block_number_u64) != Some(*checksum) {
+                        first_corrupted_block.fetch_min(block_number, Ordering::Relaxed);
+                        return;
+                    }
+                }
+            });
+        }
+    });
+
+    let first_corrupted_block = first_corrupted_block.into_inner();
+    (first_corrupted_block != usize::MAX).then_some(first_corrupted_block)
+}
+
+/// Checksums of the stored bytes of the blocks which decode and match their `hashes`,
+/// up to the first block which doesn't. Pruned blocks can't be checked and get a zero checksum.
+///
+/// Blocks are split between worker threads in contiguous ranges like in [`first_corrupted_block`].
+fn verified_checksums(block_map: &BlockStoreMap, hashes: &[HashOf<SignedBlock>]) -> Vec<u32> {
+    let worker_count = std::thread::available_parallelism().map_or(1, std::num::NonZeroUsize::get);
+    let range_size = hashes.len().div_ceil(worker_count).max(1);
+
+    let ranges: Vec<Vec<u32>> = std::thread::scope(|scope| {
+        let workers: Vec<_> = hashes
+            .chunks(range_size)
+            .enumerate()
+            .map(|(range_idx, range)| {
+                scope.spawn(move || {
+                    let mut buffer = Vec::new();
+                    let mut checksums = Vec::with_capacity(range.len());
+                    for (block_number, hash) in (range_idx * range_size..).zip(range) {
+                        let block_number = block_number as u64;
+                        if block_map.is_pruned(block_number) {
+                            checksums.push(0);
+                            continue;
+                        }
+                        let Some((codec, frame)) = block_map.block_frame(block_number) else {
+                            break;
+                        };
+                        let is_valid = codec
+                            .decompress_into(frame, &mut buffer)
+                            .ok()
+                            .and_then(|bytes| SignedBlock::decode_all_versioned(bytes).ok())
+                            .is_some_and(|block| block.hash() == *hash);
+                        if !is_valid {
+                            break;
+                        }
+                        checksums.push(crc32fast::hash(frame));
+                    }
+                    checksums
+                })
+            })
+            .collect();
+
+        workers
+            .into_iter()
+            .map(|worker| worker.join().expect("Kura checksum worker panicked"))
+            .collect()
+    });
+
+    let mut checksums = Vec::with_capacity(hashes.len());
+    for (range, range_checksums) in hashes.chunks(range_size).zip(ranges) {
+        let is_complete = range_checksums.len() == range.len();
+        checksums.extend(range_checksums);
+        if !is_complete {
+            break;
+        }
+    }
+    checksums
+}
+
+/// Progress and throughput of strict initialisation shared by its workers
+struct StrictInitProgress {
+    started_at: Instant,
+    block_count: usize,
+    decoded_blocks: AtomicUsize,
+    decoded_bytes: AtomicUsize,
+}
+
+impl StrictInitProgress {
+    fn new(block_count: usize) -> Self {
+        Self {
+            started_at: Instant::now(),
+            block_count,
+            decoded_blocks: AtomicUsize::new(0),
+            decoded_bytes: AtomicUsize::new(0),
+        }
+    }
+
+    fn advance(&self, blocks: usize, bytes: usize) {
+        let decoded_bytes = self.decoded_bytes.fetch_add(bytes, Ordering::Relaxed) + bytes;
+        let decoded_blocks = self.decoded_blocks.fetch_add(blocks, Ordering::Relaxed) + blocks;
+        #[allow(clippy::integer_division)]
+        if (decoded_blocks - blocks) / STRICT_INIT_PROGRESS_STEP
+            != decoded_blocks / STRICT_INIT_PROGRESS_STEP
+        {
+            self.report(decoded_blocks, decoded_bytes, "Kura init in progress");
+        }
+    }
+
+    fn finish(&self) {
+        self.report(
+            self.decoded_blocks.load(Ordering::Relaxed),
+            self.decoded_bytes.load(Ordering::Relaxed),
+            "Kura decoded all blocks",
+        );
+    }
+
+    #[allow(clippy::cast_precision_loss)]
+    fn report(&self, decoded_blocks: usize, decoded_bytes: usize, message: &str) {
+        let elapsed = self.started_at.elapsed().as_secs_f64().max(f64::EPSILON);
+        info!(
+            decoded_blocks,
+            block_count = self.block_count,
+            blocks_per_sec = decoded_blocks as f64 / elapsed,
+            mib_per_sec = decoded_bytes as f64 / elapsed / f64::from(1 << 20),
+            "{message}"
+        );
+    }
+}
+
+/// Statistics of the [`Kura`] block cache
+#[derive(Debug, Default, Clone, Copy, PartialEq, Eq)]
+pub struct BlockCacheStats {
+    /// Number of lookups served from the cache
+    pub hits: u64,
+    /// Number of lookups which had to go to disk
+    pub misses: u64,
+    /// Number of blocks evicted to stay within the budget
+    pub evictions: u64,
+    /// Total size of cached blocks in bytes
+    pub size_bytes: u64,
+}
+
+/// Byte-budgeted cache of blocks which are already on disk.
+///
+/// It is a segmented LRU: blocks enter the probationary segment and are only promoted to
+/// the protected segment when they are hit again. A sequential scan over the chain thus
+/// only cycles through the probationary segment and doesn't flush frequently used blocks
+/// (e.g. the top of the chain) from the protected one.
+#[derive(Debug)]
+struct BlockCache {
+    capacity: u64,
+    protected_capacity: u64,
+    /// Cached blocks by block number (height - 1)
+    entries: BTreeMap<usize, BlockCacheEntry>,
+    /// Probationary segment ordered by the time of insertion
+    probation: BTreeMap<u64, usize>,
+    /// Protected segment ordered by the time of the latest access
+    protected: BTreeMap<u64, usize>,
+    probation_bytes: u64,
+    protected_bytes: u64,
+    tick: u64,
+    hits: u64,
+    misses: u64,
+    evictions: u64,
+}
+
+#[derive(Debug)]
+struct BlockCacheEntry {
+    block: Arc<SignedBlock>,
+    size: u64,
+    tick: u64,
+    protected: bool,
+}
+
+impl BlockCache {
+    /// Share of the capacity available to the protected segment (in percent)
+    const PROTECTED_SHARE: u64 = 80;
+
+    fn new(capacity: u64) -> Self {
+        Self {
+            capacity,
+            protected_capacity: capacity / 100 * Self::PROTECTED_SHARE,
+            entries: BTreeMap::new(),
+            probation: BTreeMap::new(),
+            protected: BTreeMap::new(),
+            probation_bytes: 0,
+            protected_bytes: 0,
+            tick: 0,
+            hits: 0,
+            misses: 0,
+            evictions: 0,
+        }
+    }
+
+    fn next_tick(&mut self) -> u64 {
+        self.tick += 1;
+        self.tick
+    }
+
+    fn get(&mut self, block_number: usize) -> Option<Arc<SignedBlock>> {
+        let tick = self.next_tick();
+        let Some(entry) = self.entries.get_mut(&block_number) else {
+            self.misses += 1;
+            return None;
+        };
+        self.hits += 1;
+
+        if entry.protected {
+            self.protected.remove(&entry.tick);
+        } else {
+            self.probation.remove(&entry.tick);
+            self.probation_bytes -= entry.size;
+            self.protected_bytes += entry.size;
+            entry.protected = true;
+        }
+        entry.tick = tick;
+        self.protected.insert(tick, block_number);
+        let block = Arc::clone(&entry.block);
+
+        self.shrink();
+        Some(block)
+    }
+
+    fn insert(&mut self, block_number: usize, block: Arc<SignedBlock>, size: u64) {
+        self.remove(block_number);
+        if size > self.capacity {
+            return;
+        }
+
+        let tick = self.next_tick();
+        self.entries.insert(
+            block_number,
+            BlockCacheEntry {
+                block,
+                size,
+                tick,
+                protected: false,
+            },
+        );
+        self.probation.insert(tick, block_number);
+        self.probation_bytes += size;
+
+        self.shrink();
+    }
+
+    fn remove(&mut self, block_number: usize) {
+        if let Some(entry) = self.entries.remove(&block_number) {
+            if entry.protected {
+                self.protected.remove(&entry.tick);
+                self.protected_bytes -= entry.size;
+            } else {
+                self.probation.remove(&entry.tick);
+                self.probation_bytes -= entry.size;
+            }
+        }
+    }
+
+    /// Demote least recently used protected blocks which don't fit into the protected segment
+    /// and evict the oldest probationary blocks until the cache is within its budget.
+    fn shrink(&mut self) {
+        while self.protected_bytes > self.protected_capacity {
+            let Some((_, block_number)) = self.protected.pop_first() else {
+                break;
+            };
+            let tick = self.next_tick();
+            let entry = self
+                .entries
+                .get_mut(&block_number)
+                .expect("Segments and entries are in sync");
+            entry.protected = false;
+            entry.tick = tick;
+            self.protected_bytes -= entry.size;
+            self.probation_bytes += entry.size;
+            self.probation.insert(tick, block_number);
+        }
+
+        while self.probation_bytes + self.protected_bytes > self.capacity {
+            let Some((_, block_number)) = self
+                .probation
+                .pop_first()
+                .or_else(|| self.protected.pop_first())
+            else {
+                break;
+            };
+            let entry = self
+                .entries
+                .remove(&block_number)
+                .expect("Segments and entries are in sync");
+            if entry.protected {
+                self.protected_bytes -= entry.size;
+            } else {
+                self.probation_bytes -= entry.size;
+            }
+            self.evictions += 1;
+        }
+    }
+
+    fn stats(&self) -> BlockCacheStats {
+        BlockCacheStats {
+            hits: self.hits,
+            misses: self.misses,
+            evictions: self.evictions,
+            size_bytes: self.probation_bytes + self.protected_bytes,
+        }
+    }
+}
+
+/// Loaded block count
+#[derive(Clone, Copy, Debug)]
+pub struct BlockCount(pub usize);
+
+/// An implementation of a block store for `Kura`
+/// that uses `std::fs`, the default IO file in Rust.
+#[derive(Debug)]
+pub struct BlockStore {
+    path_to_blockchain: PathBuf,
+    /// Codec of newly written blocks
+    compression: BlockCodec,
+    /// Assignment of blocks to data files, read on first use
+    layout: OnceLock<SegmentLayout>,
+    /// Data files written since the last [`Self::sync`]
+    unsynced_data_files: BTreeSet<String>,
+}
+
+impl Drop for BlockStore {
+    fn drop(&mut self) {
+        let path = self.path_to_blockchain.join(LOCK_FILE_NAME);
+        let _ = fs::remove_file(path); // we don't care if this succeeds or not
+    }
+}
+
+#[derive(Default, Debug, Clone, Copy)]
+/// Lightweight wrapper for block indices in the block index file
+pub struct BlockIndex {
+    /// Start of block in bytes
+    pub start: u64,
+    /// Length of block section in bytes
+    pub length: u64,
+    /// Codec of the block section
+    pub codec: BlockCodec,
+}
+
+impl BlockIndex {
+    /// Parse an index entry as stored in the block index file.
+    ///
+    /// # Errors
+    /// Fails if the entry refers to an unknown codec.
+    pub fn from_le_bytes(start: [u8; 8], length: [u8; 8]) -> Result<Self> {
+        let length = u64::from_le_bytes(length);
+        let codec = u8::try_from(length >> BLOCK_CODEC_SHIFT).expect("Shifted by 56 bits");
+        Ok(Self {
+            start: u64::from_le_bytes(start),
+            length: length & BLOCK_LENGTH_MASK,
+            codec: BlockCodec::try_from(codec)?,
+        })
+    }
+
+    /// Encode the entry as stored in the block index file.
+    pub fn to_le_bytes(self) -> [u8; SIZE_OF_BLOCK_INDEX as usize] {
+        let length = self.length | u64::from(self.codec as u8) << BLOCK_CODEC_SHIFT;
+        let mut bytes = [0; SIZE_OF_BLOCK_INDEX as usize];
+        bytes[..8].copy_from_slice(&self.start.to_le_bytes());
+        bytes[8..].copy_from_slice(&length.to_le_bytes());
+        bytes
+    }
+}
+
+/// Format of the block section in the block data file.
+///
+/// Stores written before compression was introduced have zero in place of the codec,
+/// so their blocks are read as [`BlockCodec::None`].
+#[derive(Debug, Default, Clone, Copy, PartialEq, Eq)]
+#[repr(u8)]
+pub enum BlockCodec {
+    /// Plain versioned SCALE encoding
+    #[default]
+    None = 0,
+    /// Zstandard frame of the versioned SCALE encoding
+    Zstd = 1,
+}
+
+impl BlockCodec {
+    /// Compress versioned block `bytes` into a block section.
+    ///
+    /// # Errors
+    /// Compression failed.
+    pub fn compress(self, bytes: Vec<u8>) -> Result<Vec<u8>> {
+        match self {
+            Self::None => Ok(bytes),
+            Self::Zstd => zstd::bulk::compress(&bytes, zstd::DEFAULT_COMPRESSION_LEVEL)
+                .map_err(Error::Compression),
+        }
+    }
+
+    /// Decompress a block section into versioned block bytes.
+    ///
+    /// # Errors
+    /// The section is not a valid frame of this codec.
+    pub fn decompress(self, frame: &[u8]) -> Result<Cow<'_, [u8]>> {
+        match self {
+            Self::None => Ok(Cow::Borrowed(frame)),
+            Self::Zstd => zstd::decode_all(frame)
+                .map(Cow::Owned)
+                .map_err(Error::Compression),
+        }
+    }
+
+    /// Decompress a block section reusing `buffer` for the decompressed bytes.
+    ///
+    /// # Errors
+    /// The section is not a valid frame of this codec.
+    pub fn decompress_into<'bytes>(
+        self,
+        frame: &'bytes [u8],
+        buffer: &'bytes mut Vec<u8>,
+    ) -> Result<&'bytes [u8]> {
+        match self {
+            Self::None => Ok(frame),
+            Self::Zstd => {
+                buffer.clear();
+                zstd::stream::copy_decode(frame, &mut *buffer).map_err(Error::Compression)?;
+                Ok(buffer)
+            }
+        }
+    }
+
+    /// Decompress and decode a block section.
+    ///
+    /// # Errors
+    /// The section is not a valid frame of this codec or doesn't contain a block.
+    pub fn decode_block(self, frame: &[u8]) -> Result<SignedBlock> {
+        let bytes = self.decompress(frame)?;
+        Ok(SignedBlock::decode_all_versioned(&bytes)?)
+    }
+}
+
+impl TryFrom<u8> for BlockCodec {
+    type Error = Error;
+
+    fn try_from(codec: u8) -> Result<Self> {
+        match codec {
+            0 => Ok(Self::None),
+            1 => Ok(Self::Zstd),
+            _ => Err(Error::UnknownBlockCodec(codec)),
+        }
+    }
+}
+
+impl From<BlockCompression> for BlockCodec {
+    fn from(compression: BlockCompression) -> Self {
+        match compression {
+            BlockCompression::None => Self::None,
+            BlockCompression::Zstd => Self::Zstd,
+        }
+    }
+}
+
+/// Assignment of blocks to the files holding their data.
+///
+/// Blocks are stored in segment files of [`SEGMENT_SIZE`] consecutive blocks, so that only
+/// the active segment is ever written to. Once the first block of the next segment is written
+/// the segment is sealed: it is never modified again and its checksum is stored next to it.
+///
+/// Stores created before segments were introduced keep their blocks in the single legacy data
+/// file and the segments only start after them.
+#[derive(Debug, Clone, Copy, PartialEq, Eq)]
+pub struct SegmentLayout {
+    /// Number of blocks stored in the legacy data file
+    pub legacy_block_count: u64,
+    /// Segments (except the first one holding the genesis block) which only contain blocks
+    /// below this block number are pruned
+    pub pruned_below: u64,
+}
+
+impl SegmentLayout {
+    /// Layout of a store which was never opened for writing since segments were introduced
+    const LEGACY: Self = Self {
+        legacy_block_count: u64::MAX,
+        pruned_below: 0,
+    };
+
+    /// Segment of the block with the given number or `None` if it's stored in the legacy data file.
+    #[allow(clippy::integer_division)]
+    pub fn segment(self, block_number: u64) -> Option<u64> {
+        (block_number >= self.legacy_block_count).then_some(block_number / SEGMENT_SIZE)
+    }
+
+    /// Number of the first block stored in the same file as the block with the given number.
+    pub fn file_start(self, block_number: u64) -> u64 {
+        self.segment(block_number).map_or(0, |segment| {
+            (segment * SEGMENT_SIZE).max(self.legacy_block_count)
+        })
+    }
+
+    /// Name of the file storing the data of the block with the given number.
+    pub fn data_file_name(self, block_number: u64) -> String {
+        self.segment(block_number)
+            .map_or_else(|| DATA_FILE_NAME.to_owned(), segment_file_name)
+    }
+
+    /// Numbers of the pruned blocks. The first segment holding the genesis block is never pruned.
+    pub fn pruned_blocks(self) -> Range<u64> {
+        let start = self.legacy_block_count.max(SEGMENT_SIZE);
+        start..self.pruned_below.max(start)
+    }
+
+    /// Check if the block with the given number was pruned.
+    pub fn is_pruned(self, block_number: u64) -> bool {
+        self.pruned_blocks().contains(&block_number)
+    }
+
+    fn read(store_path: &Path) -> Result<Self> {
+        let path = store_path.join(LAYOUT_FILE_NAME);
+        let bytes = match fs::read(&path) {
+            Ok(bytes) => bytes,
+            Err(error) if error.kind() == std::io::ErrorKind::NotFound => return Ok(Self::LEGACY),
+            Err(error) => return Err(Error::IO(error, path)),
+        };
+        let bytes: [u8; 16] = bytes.try_into().map_err(|_| Error::MalformedLayout(path))?;
+        let (legacy_block_count, pruned_below) = bytes.split_at(8);
+        Ok(Self {
+            legacy_block_count: u64::from_le_bytes(
+                legacy_block_count
+                    .try_into()
+                    .expect("Slice is 8 bytes long"),
+            ),
+            pruned_below: u64::from_le_bytes(
+                pruned_below.try_into().expect("Slice is 8 bytes long"),
+            ),
+        })
+    }
+
+    fn write(self, store_path: &Path) -> Result<()> {
+        let mut bytes = self.legacy_block_count.to_le_bytes().to_vec();
+        bytes.extend_from_slice(&self.pruned_below.to_le_bytes());
+        write_file_durably(store_path, LAYOUT_FILE_NAME, &bytes)
+    }
+}
+
+fn segment_file_name(segment: u64) -> String {
+    format!("segment_{segment:08}.data")
+}
+
+fn segment_checksum_file_name(segment: u64) -> String {
+    format!("segment_{segment:08}.checksum")
+}
+
+/// Read-only memory map of the block index and block data files.
+///
+/// Files only ever grow while mapped (see [`BlockStore::write_block_at_height`]),
+/// so a map stays valid for all blocks it covers. Blocks beyond the mapped
+/// length require a fresh map.
+#[derive(Debug)]
+pub struct BlockStoreMap {
+    layout: SegmentLayout,
+    index: Option<Mmap>,
+    legacy_data: Option<Mmap>,
+    segments: BTreeMap<u64, Arc<Mmap>>,
+    tx_index: Option<Mmap>,
+    tx_hashes: Option<Mmap>,
+}
+
+impl Default for BlockStoreMap {
+    fn default() -> Self {
+        Self {
+            layout: SegmentLayout::LEGACY,
+            index: None,
+            legacy_data: None,
+            segments: BTreeMap::new(),
+            tx_index: None,
+            tx_hashes: None,
+        }
+    }
+}
+
+impl BlockStoreMap {
+    /// Map the index and data files of the block store in `store_path`.
+    ///
+    /// # Errors
+    /// IO Error.
+    pub fn new(store_path: impl AsRef<Path>) -> Result<Self> {
+        Self::default().refresh(store_path)
+    }
+
+    /// Map the files of the block store in `store_path` anew to cover blocks written since this map
+    /// was created. Maps of sealed segments are shared with this map.
+    ///
+    /// # Errors
+    /// IO Error.
+    pub fn refresh(&self, store_path: impl AsRef<Path>) -> Result<Self> {
+        let store_path = store_path.as_ref();
+        let layout = SegmentLayout::read(store_path)?;
+        let index = Self::map_file(&store_path.join(INDEX_FILE_NAME))?;
+        let index_count = index
+            .as_ref()
+            .map_or(0, |index| index.len() as u64 / SIZE_OF_BLOCK_INDEX);
+
+        let legacy_data = if layout.legacy_block_count > 0 {
+            Self::map_file(&store_path.join(DATA_FILE_NAME))?
+        } else {
+            None
+        };
+
+        let mut segments = BTreeMap::new();
+        let last_segment = index_count
+            .checked_sub(1)
+            .and_then(|last_block_number| layout.segment(last_block_number));
+        if let Some(last_segment) = last_segment {
+            let first_segment = layout
+                .segment(layout.legacy_block_count)
+                .expect("Blocks after the legacy ones are stored in segments");
+            // All but the last segment of the previous map were sealed and didn't change since
+            let sealed_below = self
+                .segments
+                .last_key_value()
+                .map_or(0, |(segment, _)| *segment);
+            for segment in first_segment..=last_segment {
+                if layout.is_pruned((segment + 1) * SEGMENT_SIZE - 1) {
+                    continue;
+                }
+                let sealed_map = self
+                    .segments
+                    .get(&segment)
+                    .filter(|_| segment < sealed_below);
+                if let Some(map) = sealed_map {
+                    segments.insert(segment, Arc::clone(map));
+                } else if let Some(map) =
+                    Self::map_file(&store_path.join(segment_file_name(segment)))?
+                {
+                    segments.insert(segment, Arc::new(map));
+                }
+            }
+        }
+
+        // Transactions are indexed before their block, so the index covers all mapped blocks
+        let tx_hashes = Self::map_file(&store_path.join(TX_HASHES_FILE_NAME))?;
+        let tx_index = Self::map_file(&store_path.join(TX_INDEX_FILE_NAME))?;
+
+        Ok(Self {
+            layout,
+            index,
+            legacy_data,
+            segments,
+            tx_index,
+            tx_hashes,
+        })
+    }
+
+    fn map_file(path: &Path) -> Result<Option<Mmap>> {
+        let file = match fs::File::open(path) {
+            Ok(file) => file,
+            Err(error) if error.kind() == std::io::ErrorKind::NotFound => return Ok(None),
+            Err(error) => return Err(Error::IO(error, path.to_path_buf())),
+        };
+        if file.metadata().add_err_context(&path.to_path_buf())?.len() == 0 {
+            return Ok(None);
+        }
+        // SAFETY: Kura holds the lock on the block store and only appends to
+        // the mapped data files or overwrites fixed-size index entries, it never
+        // truncates them below the length of the blocks read through this map.
+        #[allow(unsafe_code)]
+        let map = unsafe { Mmap::map(&file) }.add_err_context(&path.to_path_buf())?;
+        Ok(Some(map))
+    }
+
+    /// Number of block indices covered by this map.
+    #[allow(clippy::integer_division)]
+    pub fn index_count(&self) -> u64 {
+        self.index
+            .as_ref()
+            .map_or(0, |index| index.len() as u64 / SIZE_OF_BLOCK_INDEX)
+    }
+
+    /// Layout of the mapped block store.
+    pub fn layout(&self) -> SegmentLayout {
+        self.layout
+    }
+
+    /// Read the index of the block with the given number (counting from 0)
+    /// if it is covered by this map.
+    pub fn block_index(&self, block_number: u64) -> Option<BlockIndex> {
+        let start = usize::try_from(block_number.checked_mul(SIZE_OF_BLOCK_INDEX)?).ok()?;
+        let entry = self
+            .index
+            .as_ref()?
+            .get(start..start + SIZE_OF_BLOCK_INDEX as usize)?;
+        let (start, length) = entry.split_at(std::mem::size_of::<u64>());
+        BlockIndex::from_le_bytes(
+            start.try_into().expect("Slice is 8 bytes long"),
+            length.try_into().expect("Slice is 8 bytes long"),
+        )
+        .ok()
+    }
+
+    /// Codec and stored bytes of the block with the given number (counting from 0)
+    /// if both its index and data are covered by this map.
+    pub fn block_frame(&self, block_number: u64) -> Option<(BlockCodec, &[u8])> {
+        let BlockIndex {
+            start,
+            length,
+            codec,
+        } = self.block_index(block_number)?;
+        let data = match self.layout.segment(block_number) {
+            None => self.legacy_data.as_ref()?,
+            Some(segment) => self.segments.get(&segment)?,
+        };
+        let start = usize::try_from(start).ok()?;
+        let end = start.checked_add(usize::try_from(length).ok()?)?;
+        Some((codec, data.get(start..end)?))
+    }
+
+    /// Checksum of the stored bytes of the block with the given number if it's covered by this map.
+    pub fn block_checksum(&self, block_number: u64) -> Option<u32> {
+        self.block_frame(block_number)
+            .map(|(_, frame)| crc32fast::hash(frame))
+    }
+
+    /// Hashes of the transactions of the block with the given number one after another
+    /// if they are covered by this map.
+    fn transaction_hashes(&self, block_number: u64) -> Option<&[u8]> {
+        let tx_end = |block_number: u64| {
+            let start = usize::try_from(block_number.checked_mul(SIZE_OF_TX_INDEX)?).ok()?;
+            let entry = self
+                .tx_index
+                .as_ref()?
+                .get(start..start + SIZE_OF_TX_INDEX as usize)?;
+            usize::try_from(u64::from_le_bytes(
+                entry.try_into().expect("Slice is 8 bytes long"),
+            ))
+            .ok()
+        };
+        let tx_start = block_number.checked_sub(1).map_or(Some(0), tx_end)?;
+        let tx_end = tx_end(block_number)?;
+        self.tx_hashes
+            .as_deref()
+            .unwrap_or_default()
+            .get(tx_start.checked_mul(Hash::LENGTH)?..tx_end.checked_mul(Hash::LENGTH)?)
+    }
+
+    /// Number of transactions of the block with the given number according to the transaction index.
+    #[allow(clippy::integer_division)]
+    pub fn transaction_count(&self, block_number: u64) -> Option<usize> {
+        self.transaction_hashes(block_number)
+            .map(|tx_hashes| tx_hashes.len() / Hash::LENGTH)
+    }
+
+    /// Position of the transaction with the given hash in the block with the given number
+    /// according to the transaction index.
+    pub fn transaction_position(
+        &self,
+        block_number: u64,
+        tx_hash: &HashOf<SignedTransaction>,
+    ) -> Option<usize> {
+        let tx_hash: &[u8; Hash::LENGTH] = tx_hash.as_ref();
+        self.transaction_hashes(block_number)?
+            .chunks_exact(Hash::LENGTH)
+            .position(|hash| hash == tx_hash)
+    }
+
+    /// Check if the block with the given number is fully covered by this map.
+    pub fn contains(&self, block_number: u64) -> bool {
+        self.block_frame(block_number).is_some()
+    }
+
+    /// Check if the block with the given number was pruned from the store.
+    pub fn is_pruned(&self, block_number: u64) -> bool {
+        self.layout.is_pruned(block_number)
+    }
+
+    /// Decode the block with the given number (counting from 0) directly from the mapped data.
+    /// Returns `None` if the block is not covered by this map.
+    pub fn read_block(&self, block_number: u64) -> Option<Result<SignedBlock>> {
+        self.block_frame(block_number)
+            .map(|(codec, frame)| codec.decode_block(frame))
+    }
+}
+
+/// Locked Status
+#[derive(Clone, Copy)]
+pub enum LockStatus {
+    /// Is locked
+    Locked,
+    /// Is unlocked
+    Unlocked,
+}
+
+impl BlockStore {
+    /// Create a new read-only block store in `path`.
+    ///
+    /// # Panics
+    /// * if you pass in `LockStatus::Unlocked` and it is unable to lock the block store.
+    pub fn new(store_path: impl AsRef<Path>, already_locked: LockStatus) -> Self {
+        if matches!(already_locked, LockStatus::Unlocked) {
+            let lock_path = store_path.as_ref().join(LOCK_FILE_NAME);
+            if let Err(e) = fs::File::options()
+                .read(true)
+                .write(true)
+                .create_new(true)
+                .open(&lock_path)
+            {
+                match e.kind() {
+                    std::io::ErrorKind::AlreadyExists => Err(Error::Locked(lock_path)),
+                    std::io::ErrorKind::NotFound => {
+                        match std::fs::create_dir_all(store_path.as_ref())
+                            .map_err(|e| Error::MkDir(e, store_path.as_ref().to_path_buf()))
+                        {
+                            Err(e) => Err(e),
+                            Ok(()) => {
+                                if let Err(e) = fs::File::options()
+                                    .read(true)
+                                    .write(true)
+                                    .create_new(true)
+                                    .open(&lock_path)
+                                {
+                                    Err(Error::IO(e, lock_path))
+                                } else {
+                                    Ok(())
+                                }
+                            }
+                        }
+                    }
+                    _ => Err(Error::IO(e, lock_path)),
+                }
+                .expect("Kura must be able to lock the blockstore");
+            }
+        }
+        BlockStore {
+            path_to_blockchain: store_path.as_ref().to_path_buf(),
+            compression: BlockCodec::None,
+            layout: OnceLock::new(),
+            unsynced_data_files: BTreeSet::new(),
+        }
+    }
+
+    /// Get the assignment of blocks to data files.
+    ///
+    /// # Errors
+    /// IO Error or malformed layout file.
+    pub fn layout(&self) -> Result<SegmentLayout> {
+        if let Some(layout) = self.layout.get() {
+            return Ok(*layout);
+        }
+        let layout = SegmentLayout::read(&self.path_to_blockchain)?;
+        Ok(*self.layout.get_or_init(|| layout))
+    }
+
+    /// Write new blocks with the given codec. Blocks already in the store keep their codec.
+    #[must_use]
+    pub fn with_compression(mut self, compression: BlockCodec) -> Self {
+        self.compression = compression;
+        self
+    }
+
+    /// Read a series of block indices from the block index file and
+    /// attempt to fill all of `dest_buffer`.
+    ///
+    /// # Errors
+    /// IO Error.
+    pub fn read_block_indices(
         &self,
         start_block_height: u64,
         dest_buffer: &mut [BlockIndex],
@@ -468,18 +2150,12 @@ impl BlockStore {
             .add_err_context(&path)?;
         // (start, length), (start,length) ...
         for current_buffer in dest_buffer.iter_mut() {
-            let mut buffer = [0; core::mem::size_of::<u64>()];
-
-            *current_buffer = BlockIndex {
-                start: {
-                    index_file.read_exact(&mut buffer).add_err_context(&path)?;
-                    u64::from_le_bytes(buffer)
-                },
-                length: {
-                    index_file.read_exact(&mut buffer).add_err_context(&path)?;
-                    u64::from_le_bytes(buffer)
-                },
-            };
+            let mut start = [0; core::mem::size_of::<u64>()];
+            let mut length = [0; core::mem::size_of::<u64>()];
+            index_file.read_exact(&mut start).add_err_context(&path)?;
+            index_file.read_exact(&mut length).add_err_context(&path)?;
+
+            *current_buffer = BlockIndex::from_le_bytes(start, length)?;
         }
 
         Ok(())
@@ -490,10 +2166,7 @@ impl BlockStore {
     /// # Errors
     /// IO Error.
     pub fn read_block_index(&self, block_height: u64) -> Result<BlockIndex> {
-        let mut index = BlockIndex {
-            start: 0,
-            length: 0,
-        };
+        let mut index = BlockIndex::default();
         self.read_block_indices(block_height, std::slice::from_mut(&mut index))?;
         Ok(index)
     }
@@ -581,18 +2254,87 @@ impl BlockStore {
         Ok(hashes_file.metadata().add_err_context(&path)?.len() / SIZE_OF_BLOCK_HASH)
     }
 
-    /// Read block data starting from the
-    /// `start_location_in_data_file` in data file in order to fill
+    /// Read a series of block checksums from the checksums file.
+    ///
+    /// # Errors
+    /// IO Error.
+    pub fn read_block_checksums(
+        &self,
+        start_block_height: u64,
+        block_count: usize,
+    ) -> Result<Vec<u32>> {
+        let path = self.path_to_blockchain.join(CHECKSUMS_FILE_NAME);
+        let mut checksums_file = std::fs::OpenOptions::new()
+            .read(true)
+            .open(path.clone())
+            .add_err_context(&path)?;
+        let start_location = start_block_height * SIZE_OF_BLOCK_CHECKSUM;
+
+        if start_location + SIZE_OF_BLOCK_CHECKSUM * block_count as u64
+            > checksums_file.metadata().add_err_context(&path)?.len()
+        {
+            return Err(Error::OutOfBoundsBlockRead {
+                start_block_height,
+                block_count,
+            });
+        }
+        checksums_file
+            .seek(SeekFrom::Start(start_location))
+            .add_err_context(&path)?;
+
+        let mut bytes = vec![0; block_count * SIZE_OF_BLOCK_CHECKSUM as usize];
+        checksums_file
+            .read_exact(&mut bytes)
+            .add_err_context(&path)?;
+        Ok(bytes
+            .chunks_exact(SIZE_OF_BLOCK_CHECKSUM as usize)
+            .map(|checksum| u32::from_le_bytes(checksum.try_into().expect("Chunk is 4 bytes long")))
+            .collect())
+    }
+
+    /// Get the number of checksums in the checksums file.
+    ///
+    /// # Errors
+    /// IO Error.
+    #[allow(clippy::integer_division)]
+    pub fn read_checksums_count(&self) -> Result<u64> {
+        let path = self.path_to_blockchain.join(CHECKSUMS_FILE_NAME);
+        let checksums_file = std::fs::OpenOptions::new()
+            .read(true)
+            .open(path.clone())
+            .add_err_context(&path)?;
+        Ok(checksums_file.metadata().add_err_context(&path)?.len() / SIZE_OF_BLOCK_CHECKSUM)
+    }
+
+    /// Get the number of blocks which were flushed to the storage device by the last [`Self::sync`]
+    /// or `None` if the store was never synced.
+    ///
+    /// # Errors
+    /// IO Error.
+    pub fn read_synced_count(&self) -> Result<Option<u64>> {
+        let path = self.path_to_blockchain.join(SYNCED_FILE_NAME);
+        match fs::read(&path) {
+            Ok(bytes) => Ok(bytes.try_into().ok().map(u64::from_le_bytes)),
+            Err(error) if error.kind() == std::io::ErrorKind::NotFound => Ok(None),
+            Err(error) => Err(Error::IO(error, path)),
+        }
+    }
+
+    /// Read block data of the block number `block_height` starting from the
+    /// `start_location_in_data_file` in its data file in order to fill
     /// `dest_buffer`.
     ///
     /// # Errors
     /// IO Error.
     pub fn read_block_data(
         &self,
+        block_height: u64,
         start_location_in_data_file: u64,
         dest_buffer: &mut [u8],
     ) -> Result<()> {
-        let path = self.path_to_blockchain.join(DATA_FILE_NAME);
+        let path = self
+            .path_to_blockchain
+            .join(self.layout()?.data_file_name(block_height));
         let mut data_file = std::fs::OpenOptions::new()
             .read(true)
             .open(path.clone())
@@ -662,33 +2404,30 @@ impl BlockStore {
         Ok(())
     }
 
-    /// Write `block_data` into the data file starting at
-    /// `start_location_in_data_file`. Extend the file if
+    /// Write `block_data` of the block number `block_height` into its data file
+    /// starting at `start_location_in_data_file`. Extend the file if
     /// necessary.
     ///
     /// # Errors
     /// IO Error.
     pub fn write_block_data(
         &mut self,
+        block_height: u64,
         start_location_in_data_file: u64,
         block_data: &[u8],
     ) -> Result<()> {
-        let path = self.path_to_blockchain.join(DATA_FILE_NAME);
+        let file_name = self.layout()?.data_file_name(block_height);
+        let path = self.path_to_blockchain.join(&file_name);
         let mut data_file = std::fs::OpenOptions::new()
             .write(true)
+            .create(true)
             .open(path.clone())
             .add_err_context(&path)?;
-        if start_location_in_data_file + block_data.len() as u64
-            > data_file.metadata().add_err_context(&path)?.len()
-        {
-            data_file
-                .set_len(start_location_in_data_file + block_data.len() as u64)
-                .add_err_context(&path)?;
-        }
         data_file
             .seek(SeekFrom::Start(start_location_in_data_file))
             .add_err_context(&path)?;
         data_file.write_all(block_data).add_err_context(&path)?;
+        self.unsynced_data_files.insert(file_name);
         Ok(())
     }
 
@@ -740,66 +2479,546 @@ impl BlockStore {
                 .write_all(hash.as_ref())
                 .add_err_context(&path)?;
         }
-        Ok(())
+        Ok(())
+    }
+
+    /// Create the index and data files if they do not
+    /// already exist.
+    ///
+    /// # Errors
+    /// Fails if any of the files don't exist and couldn't be
+    /// created.
+    pub fn create_files_if_they_do_not_exist(&mut self) -> Result<()> {
+        std::fs::create_dir_all(&*self.path_to_blockchain)
+            .map_err(|e| Error::MkDir(e, self.path_to_blockchain.clone()))?;
+        let path = self.path_to_blockchain.join(INDEX_FILE_NAME);
+        std::fs::OpenOptions::new()
+            .write(true)
+            .create(true)
+            .open(path.clone())
+            .add_err_context(&path)?;
+        let path = self.path_to_blockchain.join(HASHES_FILE_NAME);
+        std::fs::OpenOptions::new()
+            .write(true)
+            .create(true)
+            .open(path.clone())
+            .add_err_context(&path)?;
+        let path = self.path_to_blockchain.join(LAYOUT_FILE_NAME);
+        if !path.try_exists().add_err_context(&path)? {
+            // Blocks written before segments were introduced stay in the legacy data file
+            let layout = SegmentLayout {
+                legacy_block_count: self.read_index_count()?,
+                pruned_below: 0,
+            };
+            layout.write(&self.path_to_blockchain)?;
+            self.layout = OnceLock::from(layout);
+        }
+        let path = self.path_to_blockchain.join(CHECKSUMS_FILE_NAME);
+        if !path.try_exists().add_err_context(&path)? {
+            self.write_missing_checksums()?;
+        }
+        let mut is_tx_index_missing = false;
+        for file_name in [TX_INDEX_FILE_NAME, TX_AUTHORITIES_FILE_NAME] {
+            let path = self.path_to_blockchain.join(file_name);
+            is_tx_index_missing |= !path.try_exists().add_err_context(&path)?;
+        }
+        if is_tx_index_missing {
+            self.write_missing_transaction_index()?;
+        }
+        Ok(())
+    }
+
+    /// Create the transaction index for blocks written before it was introduced.
+    fn write_missing_transaction_index(&mut self) -> Result<()> {
+        let block_count = self.read_index_count()?;
+        if block_count > 0 {
+            info!(block_count, "Indexing transactions of stored blocks");
+        }
+        let block_map = BlockStoreMap::new(&self.path_to_blockchain)?;
+        let (mut tx_index_bytes, mut tx_hash_bytes) = (Vec::new(), Vec::new());
+        let mut tx_authority_bytes = Vec::new();
+        let mut tx_count = 0_u64;
+        for block_number in 0..block_count {
+            // Blocks which can't be read are left without transactions, so they are scanned on lookup
+            if let Some(Ok(block)) = block_map.read_block(block_number) {
+                for tx in block.transactions() {
+                    tx_hash_bytes.extend_from_slice(tx.as_ref().hash().as_ref());
+                    tx_authority_bytes.extend_from_slice(&account_key(tx.as_ref().authority()));
+                    tx_count += 1;
+                }
+            }
+            tx_index_bytes.extend_from_slice(&tx_count.to_le_bytes());
+        }
+        // Transactions go first, so that the index never points beyond them
+        for (file_name, bytes) in [
+            (TX_HASHES_FILE_NAME, tx_hash_bytes),
+            (TX_AUTHORITIES_FILE_NAME, tx_authority_bytes),
+            (TX_INDEX_FILE_NAME, tx_index_bytes),
+        ] {
+            let path = self.path_to_blockchain.join(file_name);
+            fs::write(&path, bytes).add_err_context(&path)?;
+        }
+        Ok(())
+    }
+
+    /// Read the transactions of every account in the first `block_count` blocks.
+    ///
+    /// Starts from the latest checkpoint of the account transactions which doesn't include the
+    /// top block, so that only the transaction index of the following blocks has to be read.
+    fn read_account_transactions(&self, block_count: u64) -> Result<AccountTransactions> {
+        let (checkpoint_count, mut account_transactions) = self
+            .read_account_transactions_checkpoint()
+            .filter(|(checkpoint_count, _)| *checkpoint_count < block_count)
+            .unwrap_or_default();
+
+        let path = self.path_to_blockchain.join(TX_INDEX_FILE_NAME);
+        let tx_index = fs::read(&path).add_err_context(&path)?;
+        let tx_ends = tx_index
+            .chunks_exact(SIZE_OF_TX_INDEX as usize)
+            .map(|tx_end| u64::from_le_bytes(tx_end.try_into().expect("Chunk is 8 bytes long")))
+            .skip(usize::try_from(checkpoint_count)?);
+
+        let mut tx_start = self.read_tx_start(checkpoint_count)?;
+        let path = self.path_to_blockchain.join(TX_AUTHORITIES_FILE_NAME);
+        let mut tx_authorities = fs::File::open(&path).add_err_context(&path)?;
+        tx_authorities
+            .seek(SeekFrom::Start(tx_start * Hash::LENGTH as u64))
+            .add_err_context(&path)?;
+        let mut tx_authorities = std::io::BufReader::new(tx_authorities);
+        let mut read_count = checkpoint_count;
+        for (block_number, tx_end) in (checkpoint_count..block_count).zip(tx_ends) {
+            for index in 0..tx_end.saturating_sub(tx_start) {
+                let mut key = AccountKey::default();
+                tx_authorities.read_exact(&mut key).add_err_context(&path)?;
+                let location = TransactionLocation {
+                    block_height: block_number + 1,
+                    index: usize::try_from(index).expect("Block transactions fit in memory"),
+                };
+                account_transactions.push(key, location);
+            }
+            tx_start = tx_end;
+            read_count += 1;
+        }
+        if read_count != block_count {
+            return Err(Error::OutOfBoundsBlockRead {
+                start_block_height: read_count,
+                block_count: usize::try_from(block_count - read_count)
+                    .expect("We don't have 4 billion blocks."),
+            });
+        }
+        Ok(account_transactions)
+    }
+
+    /// Read the latest checkpoint written by [`Self::write_account_transactions_checkpoint`]
+    /// if there is a valid one.
+    fn read_account_transactions_checkpoint(&self) -> Option<(u64, AccountTransactions)> {
+        let path = self.path_to_blockchain.join(ACCOUNT_TRANSACTIONS_FILE_NAME);
+        let bytes = fs::read(path).ok()?;
+        AccountTransactions::decode_checkpoint(&bytes)
+    }
+
+    /// Persist the encoded account transactions of the first blocks, see
+    /// [`AccountTransactions::encode_checkpoint`]. They must not include the top block,
+    /// as it might still be replaced.
+    ///
+    /// # Errors
+    /// IO Error.
+    fn write_account_transactions_checkpoint(&self, bytes: &[u8]) -> Result<()> {
+        write_file_durably(
+            &self.path_to_blockchain,
+            ACCOUNT_TRANSACTIONS_FILE_NAME,
+            bytes,
+        )
+    }
+
+    /// Number of transactions in all blocks preceding the block number `block_height`.
+    fn read_tx_start(&self, block_height: u64) -> Result<u64> {
+        let Some(previous_block) = block_height.checked_sub(1) else {
+            return Ok(0);
+        };
+        let path = self.path_to_blockchain.join(TX_INDEX_FILE_NAME);
+        let mut tx_index_file = std::fs::OpenOptions::new()
+            .read(true)
+            .open(path.clone())
+            .add_err_context(&path)?;
+        tx_index_file
+            .seek(SeekFrom::Start(previous_block * SIZE_OF_TX_INDEX))
+            .add_err_context(&path)?;
+        let mut tx_end = [0; SIZE_OF_TX_INDEX as usize];
+        tx_index_file
+            .read_exact(&mut tx_end)
+            .add_err_context(&path)?;
+        Ok(u64::from_le_bytes(tx_end))
+    }
+
+    /// Create the checksums file for blocks written before checksums were introduced.
+    ///
+    /// Only blocks which decode and match their hash in the hashes file get a checksum, so that
+    /// earlier corruption isn't recorded as valid. The file ends before the first block which
+    /// doesn't, leaving it and the following blocks to be decoded by the verify init mode.
+    fn write_missing_checksums(&mut self) -> Result<()> {
+        let block_count = self.read_index_count()?;
+        let hashes_count = self.read_hashes_count()?.min(block_count);
+        let hashes = self.read_block_hashes(0, usize::try_from(hashes_count)?)?;
+        let block_map = BlockStoreMap::new(&self.path_to_blockchain)?;
+        let checksum_bytes: Vec<_> = verified_checksums(&block_map, &hashes)
+            .into_iter()
+            .flat_map(u32::to_le_bytes)
+            .collect();
+        let path = self.path_to_blockchain.join(CHECKSUMS_FILE_NAME);
+        fs::write(&path, checksum_bytes).add_err_context(&path)
+    }
+
+    /// Append `block_data` to this block store. First write
+    /// the data to the data file and then create a new index
+    /// for it in the index file.
+    ///
+    /// # Errors
+    /// Fails if any of the required platform-specific functions
+    /// fail.
+    pub fn append_block_to_chain(&mut self, block: &SignedBlock) -> Result<()> {
+        let new_block_height = self.read_index_count()?;
+        self.write_block_at_height(new_block_height, block)
+    }
+
+    /// Write `block` as the block number `block_height` (counting from 0) right after
+    /// the data of the previous block. Files are extended if necessary but never truncated.
+    ///
+    /// A block replacing one which is already stored (i.e. after a soft-fork) is appended to the
+    /// end of its data file instead and only then does the index entry switch to it, so readers
+    /// of a [`BlockStoreMap`] see either the old or the new block but never partially written data.
+    ///
+    /// # Errors
+    /// Fails if any of the required platform-specific functions
+    /// fail.
+    pub fn write_block_at_height(&mut self, block_height: u64, block: &SignedBlock) -> Result<()> {
+        self.write_blocks_at_height(block_height, core::iter::once(block))
+    }
+
+    /// Write consecutive `blocks` starting with the block number `block_height` (counting from 0),
+    /// see [`Self::write_block_at_height`].
+    ///
+    /// Each file is updated with a single (vectored) write regardless of the number of blocks.
+    ///
+    /// # Errors
+    /// Fails if any of the required platform-specific functions
+    /// fail.
+    pub fn write_blocks_at_height<'block>(
+        &mut self,
+        block_height: u64,
+        blocks: impl IntoIterator<Item = &'block SignedBlock>,
+    ) -> Result<()> {
+        let layout = self.layout()?;
+        let mut block_start = if block_height < self.read_index_count()? {
+            // Replaced blocks are never overwritten in place since they might be read through a map
+            let path = self
+                .path_to_blockchain
+                .join(layout.data_file_name(block_height));
+            match fs::metadata(&path) {
+                Ok(metadata) => metadata.len(),
+                Err(error) if error.kind() == std::io::ErrorKind::NotFound => 0,
+                Err(error) => return Err(Error::IO(error, path)),
+            }
+        } else if block_height == layout.file_start(block_height) {
+            0
+        } else {
+            let ultimate_block = self.read_block_index(block_height - 1)?;
+            ultimate_block.start + ultimate_block.length
+        };
+
+        // Blocks are grouped by data file: (first block number, start in file, block bytes)
+        let mut data_files: Vec<(u64, u64, Vec<Vec<u8>>)> = Vec::new();
+        let mut index_bytes = Vec::new();
+        let mut hash_bytes = Vec::new();
+        let mut checksum_bytes = Vec::new();
+        let tx_start = self.read_tx_start(block_height)?;
+        let mut tx_end = tx_start;
+        let (mut tx_index_bytes, mut tx_hash_bytes) = (Vec::new(), Vec::new());
+        let mut tx_authority_bytes = Vec::new();
+        for (block_number, block) in (block_height..).zip(blocks) {
+            let bytes = self.compression.compress(block.encode_versioned())?;
+            let starts_file = block_number == layout.file_start(block_number);
+            if starts_file && block_number != block_height {
+                block_start = 0;
+            }
+            if data_files.is_empty() || starts_file {
+                data_files.push((block_number, block_start, Vec::new()));
+            }
+            let index = BlockIndex {
+                start: block_start,
+                length: bytes.len() as u64,
+                codec: self.compression,
+            };
+            index_bytes.extend_from_slice(&index.to_le_bytes());
+            hash_bytes.extend_from_slice(block.hash().as_ref());
+            checksum_bytes.extend_from_slice(&crc32fast::hash(&bytes).to_le_bytes());
+            for tx in block.transactions() {
+                tx_hash_bytes.extend_from_slice(tx.as_ref().hash().as_ref());
+                tx_authority_bytes.extend_from_slice(&account_key(tx.as_ref().authority()));
+                tx_end += 1;
+            }
+            tx_index_bytes.extend_from_slice(&tx_end.to_le_bytes());
+            block_start += bytes.len() as u64;
+            data_files.last_mut().expect("Pushed above").2.push(bytes);
+        }
+        if data_files.is_empty() {
+            return Ok(());
+        }
+
+        // Data goes first so that the index never points to unwritten data
+        for (first_block, start, block_bytes) in &data_files {
+            let file_name = layout.data_file_name(*first_block);
+            let path = self.path_to_blockchain.join(&file_name);
+            let mut data_file = std::fs::OpenOptions::new()
+                .write(true)
+                .create(true)
+                .open(path.clone())
+                .add_err_context(&path)?;
+            data_file
+                .seek(SeekFrom::Start(*start))
+                .add_err_context(&path)?;
+            write_all_vectored(&mut data_file, block_bytes).add_err_context(&path)?;
+            self.unsynced_data_files.insert(file_name);
+        }
+
+        // Transactions are indexed before the block index makes their blocks visible
+        for (file_name, start, bytes) in [
+            (
+                TX_HASHES_FILE_NAME,
+                tx_start * SIZE_OF_TX_HASH,
+                tx_hash_bytes,
+            ),
+            (
+                TX_AUTHORITIES_FILE_NAME,
+                tx_start * SIZE_OF_TX_HASH,
+                tx_authority_bytes,
+            ),
+            (
+                TX_INDEX_FILE_NAME,
+                block_height * SIZE_OF_TX_INDEX,
+                tx_index_bytes,
+            ),
+            (
+                INDEX_FILE_NAME,
+                block_height * SIZE_OF_BLOCK_INDEX,
+                index_bytes,
+            ),
+            (
+                HASHES_FILE_NAME,
+                block_height * SIZE_OF_BLOCK_HASH,
+                hash_bytes,
+            ),
+            (
+                CHECKSUMS_FILE_NAME,
+                block_height * SIZE_OF_BLOCK_CHECKSUM,
+                checksum_bytes,
+            ),
+        ] {
+            let path = self.path_to_blockchain.join(file_name);
+            let mut file = std::fs::OpenOptions::new()
+                .write(true)
+                .create(true)
+                .open(path.clone())
+                .add_err_context(&path)?;
+            file.seek(SeekFrom::Start(start)).add_err_context(&path)?;
+            file.write_all(&bytes).add_err_context(&path)?;
+        }
+
+        // Starting a segment seals the previous one
+        for (first_block, _, _) in &data_files {
+            let previous_segment = first_block
+                .checked_sub(1)
+                .and_then(|previous_block| layout.segment(previous_block));
+            if let Some(previous_segment) = previous_segment {
+                if Some(previous_segment) != layout.segment(*first_block) {
+                    self.seal_segment(previous_segment, first_block - 1)?;
+                }
+            }
+        }
+
+        Ok(())
+    }
+
+    /// Store the checksum of the segment which ends with the block number `last_block`.
+    fn seal_segment(&self, segment: u64, last_block: u64) -> Result<()> {
+        let checksum = self.segment_checksum(segment, last_block)?;
+        let path = self
+            .path_to_blockchain
+            .join(segment_checksum_file_name(segment));
+        fs::write(&path, checksum.as_ref()).add_err_context(&path)
+    }
+
+    fn segment_checksum(&self, segment: u64, last_block: u64) -> Result<Hash> {
+        let BlockIndex { start, length, .. } = self.read_block_index(last_block)?;
+        let path = self.path_to_blockchain.join(segment_file_name(segment));
+        let map = BlockStoreMap::map_file(&path)?;
+        let end = usize::try_from(start + length)?;
+        let data =
+            map.as_deref()
+                .unwrap_or_default()
+                .get(..end)
+                .ok_or(Error::OutOfBoundsBlockRead {
+                    start_block_height: last_block,
+                    block_count: 1,
+                })?;
+        Ok(Hash::new(data))
+    }
+
+    /// Check the sealed `segment` against its stored checksum.
+    ///
+    /// # Errors
+    /// IO Error, e.g. if the segment is not sealed yet.
+    pub fn verify_segment(&self, segment: u64) -> Result<bool> {
+        let path = self
+            .path_to_blockchain
+            .join(segment_checksum_file_name(segment));
+        let checksum = fs::read(&path).add_err_context(&path)?;
+        let last_block = (segment + 1) * SEGMENT_SIZE - 1;
+        Ok(self.segment_checksum(segment, last_block)?.as_ref() == checksum.as_slice())
+    }
+
+    /// Prune sealed segments which only contain blocks below the block number `block_number`,
+    /// moving them to `archive_dir` if it's given or deleting them otherwise.
+    /// The segment holding the genesis block and the legacy data file are never pruned.
+    ///
+    /// Returns the number of pruned segments.
+    ///
+    /// # Errors
+    /// IO Error.
+    pub fn prune_segments_below(
+        &mut self,
+        block_number: u64,
+        archive_dir: Option<&Path>,
+    ) -> Result<u64> {
+        let mut layout = self.layout()?;
+        let Some(first_segment) =
+            layout.segment(layout.pruned_below.max(layout.legacy_block_count))
+        else {
+            return Ok(0);
+        };
+        let index_count = self.read_index_count()?;
+
+        let mut pruned_count = 0;
+        for segment in first_segment.max(1).. {
+            let Some(segment_end) = (segment + 1).checked_mul(SEGMENT_SIZE) else {
+                break;
+            };
+            // The segment must be sealed, i.e. the next one must be started
+            if segment_end > block_number || segment_end >= index_count {
+                break;
+            }
+
+            // Layout is updated first, so that a crash can only leave a pruned segment behind
+            layout.pruned_below = segment_end;
+            layout.write(&self.path_to_blockchain)?;
+            self.layout = OnceLock::from(layout);
+
+            for file_name in [
+                segment_file_name(segment),
+                segment_checksum_file_name(segment),
+            ] {
+                let path = self.path_to_blockchain.join(&file_name);
+                let result = match archive_dir {
+                    Some(archive_dir) => move_file(&path, archive_dir, &file_name),
+                    None => fs::remove_file(&path),
+                };
+                match result {
+                    Err(error) if error.kind() != std::io::ErrorKind::NotFound => {
+                        return Err(Error::IO(error, path));
+                    }
+                    _ => {}
+                }
+            }
+            pruned_count += 1;
+        }
+
+        Ok(pruned_count)
     }
 
-    /// Create the index and data files if they do not
-    /// already exist.
+    /// Flush the data files written since the last call, the index and the hashes files to the storage device.
     ///
     /// # Errors
-    /// Fails if any of the files don't exist and couldn't be
-    /// created.
-    pub fn create_files_if_they_do_not_exist(&mut self) -> Result<()> {
-        std::fs::create_dir_all(&*self.path_to_blockchain)
-            .map_err(|e| Error::MkDir(e, self.path_to_blockchain.clone()))?;
-        let path = self.path_to_blockchain.join(INDEX_FILE_NAME);
-        std::fs::OpenOptions::new()
-            .write(true)
-            .create(true)
-            .open(path.clone())
-            .add_err_context(&path)?;
-        let path = self.path_to_blockchain.join(DATA_FILE_NAME);
-        std::fs::OpenOptions::new()
-            .write(true)
-            .create(true)
-            .open(path.clone())
-            .add_err_context(&path)?;
-        let path = self.path_to_blockchain.join(HASHES_FILE_NAME);
-        std::fs::OpenOptions::new()
-            .write(true)
-            .create(true)
-            .open(path.clone())
-            .add_err_context(&path)?;
-        Ok(())
+    /// IO Error.
+    pub fn sync(&mut self) -> Result<()> {
+        // Data goes first so that a durable index never points to data which is not durable
+        let unsynced_data_files = core::mem::take(&mut self.unsynced_data_files);
+        let file_names = unsynced_data_files.iter().map(String::as_str).chain([
+            TX_HASHES_FILE_NAME,
+            TX_AUTHORITIES_FILE_NAME,
+            TX_INDEX_FILE_NAME,
+            INDEX_FILE_NAME,
+            HASHES_FILE_NAME,
+            CHECKSUMS_FILE_NAME,
+        ]);
+        for file_name in file_names {
+            let path = self.path_to_blockchain.join(file_name);
+            std::fs::OpenOptions::new()
+                .write(true)
+                .open(path.clone())
+                .and_then(|file| file.sync_data())
+                .add_err_context(&path)?;
+        }
+
+        // Blocks below this count don't need a full decode in the verify init mode
+        let synced_count = self.read_index_count()?;
+        write_file_durably(
+            &self.path_to_blockchain,
+            SYNCED_FILE_NAME,
+            &synced_count.to_le_bytes(),
+        )
     }
+}
 
-    /// Append `block_data` to this block store. First write
-    /// the data to the data file and then create a new index
-    /// for it in the index file.
-    ///
-    /// # Errors
-    /// Fails if any of the required platform-specific functions
-    /// fail.
-    pub fn append_block_to_chain(&mut self, block: &SignedBlock) -> Result<()> {
-        let bytes = block.encode_versioned();
-        let new_block_height = self.read_index_count()?;
-        let start_location_in_data_file = if new_block_height == 0 {
-            0
-        } else {
-            let ultimate_block = self.read_block_index(new_block_height - 1)?;
-            ultimate_block.start + ultimate_block.length
-        };
+/// Replace the file `file_name` in `dir` with `bytes`, so that a crash leaves either the old
+/// or the new contents behind and the new ones are on the storage device once this returns.
+fn write_file_durably(dir: &Path, file_name: &str, bytes: &[u8]) -> Result<()> {
+    let tmp_path = dir.join(format!("{file_name}.tmp"));
+    let mut tmp_file = fs::File::create(&tmp_path).add_err_context(&tmp_path)?;
+    tmp_file
+        .write_all(bytes)
+        .and_then(|()| tmp_file.sync_all())
+        .add_err_context(&tmp_path)?;
+    let path = dir.join(file_name);
+    fs::rename(&tmp_path, &path).add_err_context(&path)?;
+    // The rename itself is only durable once the directory is flushed
+    fs::File::open(dir)
+        .and_then(|dir| dir.sync_all())
+        .add_err_context(&dir.to_path_buf())
+}
 
-        self.write_block_data(start_location_in_data_file, &bytes)?;
-        self.write_block_index(
-            new_block_height,
-            start_location_in_data_file,
-            bytes.len() as u64,
-        )?;
-        self.write_block_hash(new_block_height, block.hash())?;
+/// Move the file at `path` into `dir` under `file_name`, copying it if `dir` is on another file system.
+fn move_file(path: &Path, dir: &Path, file_name: &str) -> std::io::Result<()> {
+    fs::create_dir_all(dir)?;
+    let destination = dir.join(file_name);
+    if fs::rename(path, &destination).is_err() {
+        fs::copy(path, &destination)?;
+        fs::remove_file(path)?;
+    }
+    Ok(())
+}
 
-        Ok(())
+/// Write all `buffers` one after another with as few `write_vectored` calls as possible.
+fn write_all_vectored(file: &mut fs::File, buffers: &[Vec<u8>]) -> std::io::Result<()> {
+    let (mut buffer_idx, mut offset) = (0, 0);
+    while buffer_idx < buffers.len() {
+        let slices: Vec<_> = core::iter::once(&buffers[buffer_idx][offset..])
+            .chain(buffers[buffer_idx + 1..].iter().map(Vec::as_slice))
+            .map(IoSlice::new)
+            .collect();
+        let mut written = match file.write_vectored(&slices) {
+            Ok(0) => return Err(std::io::ErrorKind::WriteZero.into()),
+            Ok(written) => written,
+            Err(error) if error.kind() == std::io::ErrorKind::Interrupted => continue,
+            Err(error) => return Err(error),
+        };
+        while buffer_idx < buffers.len() && written >= buffers[buffer_idx].len() - offset {
+            written -= buffers[buffer_idx].len() - offset;
+            buffer_idx += 1;
+            offset = 0;
+        }
+        offset += written;
     }
+    Ok(())
 }
 
 type Result<T, E = Error> = std::result::Result<T, E>;
@@ -812,6 +3031,14 @@ pub enum Error {
     MkDir(#[source] std::io::Error, PathBuf),
     /// Failed to serialize/deserialize block
     Codec(#[from] parity_scale_codec::Error),
+    /// Failed to decode versioned block
+    Version(#[from] iroha_version::error::Error),
+    /// Failed to compress/decompress block
+    Compression(#[source] std::io::Error),
+    /// Block index refers to unknown block codec {0}
+    UnknownBlockCodec(u8),
+    /// Segment layout file {0:?} is malformed
+    MalformedLayout(PathBuf),
     /// Failed to allocate buffer
     Alloc(#[from] std::collections::TryReserveError),
     /// Tried reading block data out of bounds: `start_block_height`, `block_count`
@@ -846,16 +3073,43 @@ impl<T> AddErrContextExt<T> for Result<T, std::io::Error> {
 #[cfg(test)]
 mod tests {
 
+    use iroha_crypto::MerkleTree;
+    use iroha_data_model::{
+        prelude::{ChainId, Domain, Register, TransactionBuilder},
+        transaction::CommittedTransaction,
+    };
     use tempfile::TempDir;
+    use test_samples::gen_account_in;
 
     use super::*;
     use crate::block::ValidBlock;
 
+    fn block_with_transactions(tx_count: usize) -> SignedBlock {
+        let chain_id = ChainId::from("00000000-0000-0000-0000-000000000000");
+        let (account_id, key_pair) = gen_account_in("wonderland");
+        let transactions: Vec<_> = (0..tx_count)
+            .map(|i| CommittedTransaction {
+                value: TransactionBuilder::new(chain_id.clone(), account_id.clone())
+                    .with_instructions([Register::domain(Domain::new(
+                        format!("domain{i}").parse().unwrap(),
+                    ))])
+                    .sign(&key_pair),
+                error: None,
+            })
+            .collect();
+        ValidBlock::new_dummy_and_modify_payload(|payload| {
+            payload.header.transactions_hash = transactions
+                .iter()
+                .map(|tx| tx.as_ref().hash())
+                .collect::<MerkleTree<_>>()
+                .hash();
+            payload.transactions = transactions;
+        })
+        .into()
+    }
+
     fn indices<const N: usize>(value: [(u64, u64); N]) -> [BlockIndex; N] {
-        let mut ret = [BlockIndex {
-            start: 0,
-            length: 0,
-        }; N];
+        let mut ret = [BlockIndex::default(); N];
         for idx in 0..value.len() {
             ret[idx] = value[idx].into();
         }
@@ -879,6 +3133,7 @@ mod tests {
             Self {
                 start: value.0,
                 length: value.1,
+                codec: BlockCodec::None,
             }
         }
     }
@@ -925,11 +3180,13 @@ mod tests {
         block_store.create_files_if_they_do_not_exist().unwrap();
 
         block_store
-            .write_block_data(43, b"This is some data!")
+            .write_block_data(0, 43, b"This is some data!")
             .unwrap();
 
         let mut read_buffer = [0_u8; b"This is some data!".len()];
-        block_store.read_block_data(43, &mut read_buffer).unwrap();
+        block_store
+            .read_block_data(0, 43, &mut read_buffer)
+            .unwrap();
 
         assert_eq!(b"This is some data!", &read_buffer);
     }
@@ -1010,12 +3267,286 @@ mod tests {
 
         let block_data = dummy_block.encode_versioned();
         for i in 0..append_count {
-            let BlockIndex { start, length } = block_store.read_block_index(i).unwrap();
+            let BlockIndex { start, length, .. } = block_store.read_block_index(i).unwrap();
             assert_eq!(i * block_data.len() as u64, start);
             assert_eq!(block_data.len() as u64, length);
         }
     }
 
+    #[test]
+    fn block_store_map_reads_appended_blocks() {
+        let dir = tempfile::tempdir().unwrap();
+        let mut block_store = BlockStore::new(dir.path(), LockStatus::Unlocked);
+        block_store.create_files_if_they_do_not_exist().unwrap();
+
+        let empty_map = BlockStoreMap::new(dir.path()).unwrap();
+        assert!(!empty_map.contains(0));
+
+        let dummy_block: SignedBlock = ValidBlock::new_dummy().into();
+        let append_count = 35;
+        for _ in 0..append_count {
+            block_store.append_block_to_chain(&dummy_block).unwrap();
+        }
+
+        let block_map = BlockStoreMap::new(dir.path()).unwrap();
+        assert_eq!(block_map.index_count(), append_count);
+        for i in 0..append_count {
+            let block = block_map.read_block(i).unwrap().unwrap();
+            assert_eq!(block.hash(), dummy_block.hash());
+        }
+        assert!(block_map.read_block(append_count).is_none());
+    }
+
+    #[test]
+    fn write_block_at_height_does_not_shrink_index() {
+        let dir = tempfile::tempdir().unwrap();
+        let mut block_store = BlockStore::new(dir.path(), LockStatus::Unlocked);
+        block_store.create_files_if_they_do_not_exist().unwrap();
+
+        let dummy_block: SignedBlock = ValidBlock::new_dummy().into();
+        for _ in 0..3 {
+            block_store.append_block_to_chain(&dummy_block).unwrap();
+        }
+        block_store.write_block_at_height(2, &dummy_block).unwrap();
+
+        assert_eq!(block_store.read_index_count().unwrap(), 3);
+        // The replaced block stays intact for readers which still map it
+        let BlockIndex { start, length, .. } = block_store.read_block_index(2).unwrap();
+        assert_eq!(start, 3 * length);
+
+        let block_map = BlockStoreMap::new(dir.path()).unwrap();
+        let block = block_map.read_block(2).unwrap().unwrap();
+        assert_eq!(block.hash(), dummy_block.hash());
+    }
+
+    #[test]
+    fn write_blocks_at_height_matches_single_writes() {
+        let dummy_block: SignedBlock = ValidBlock::new_dummy().into();
+        let batch_dir = tempfile::tempdir().unwrap();
+        let single_dir = tempfile::tempdir().unwrap();
+        let mut batch_store = BlockStore::new(batch_dir.path(), LockStatus::Unlocked);
+        let mut single_store = BlockStore::new(single_dir.path(), LockStatus::Unlocked);
+        batch_store.create_files_if_they_do_not_exist().unwrap();
+        single_store.create_files_if_they_do_not_exist().unwrap();
+
+        batch_store.append_block_to_chain(&dummy_block).unwrap();
+        batch_store
+            .write_blocks_at_height(1, [&dummy_block; 4])
+            .unwrap();
+        batch_store.sync().unwrap();
+        for _ in 0..5 {
+            single_store.append_block_to_chain(&dummy_block).unwrap();
+        }
+
+        for file_name in [INDEX_FILE_NAME, &segment_file_name(0), HASHES_FILE_NAME] {
+            assert_eq!(
+                fs::read(batch_dir.path().join(file_name)).unwrap(),
+                fs::read(single_dir.path().join(file_name)).unwrap(),
+            );
+        }
+    }
+
+    #[test]
+    fn compressed_blocks_can_follow_uncompressed_ones() {
+        let dir = tempfile::tempdir().unwrap();
+        let dummy_block: SignedBlock = ValidBlock::new_dummy().into();
+        let mut block_store = BlockStore::new(dir.path(), LockStatus::Unlocked);
+        block_store.create_files_if_they_do_not_exist().unwrap();
+        block_store.append_block_to_chain(&dummy_block).unwrap();
+        let mut block_store = block_store.with_compression(BlockCodec::Zstd);
+        block_store.append_block_to_chain(&dummy_block).unwrap();
+
+        let plain = block_store.read_block_index(0).unwrap();
+        let compressed = block_store.read_block_index(1).unwrap();
+        assert_eq!(plain.codec, BlockCodec::None);
+        assert_eq!(compressed.codec, BlockCodec::Zstd);
+        assert_eq!(compressed.start, plain.length);
+
+        let block_map = BlockStoreMap::new(dir.path()).unwrap();
+        for block_number in 0..2 {
+            let block = block_map.read_block(block_number).unwrap().unwrap();
+            assert_eq!(block.hash(), dummy_block.hash());
+        }
+    }
+
+    #[test]
+    fn full_segment_is_sealed() {
+        let dir = tempfile::tempdir().unwrap();
+        let dummy_block: SignedBlock = ValidBlock::new_dummy().into();
+        let mut block_store = BlockStore::new(dir.path(), LockStatus::Unlocked);
+        block_store.create_files_if_they_do_not_exist().unwrap();
+
+        let segment_size = usize::try_from(SEGMENT_SIZE).unwrap();
+        block_store
+            .write_blocks_at_height(0, vec![&dummy_block; segment_size])
+            .unwrap();
+        assert!(block_store.verify_segment(0).is_err());
+
+        block_store.append_block_to_chain(&dummy_block).unwrap();
+        assert!(block_store.verify_segment(0).unwrap());
+        assert_eq!(block_store.read_block_index(SEGMENT_SIZE).unwrap().start, 0);
+
+        let block_map = BlockStoreMap::new(dir.path()).unwrap();
+        for block_number in [0, SEGMENT_SIZE - 1, SEGMENT_SIZE] {
+            let block = block_map.read_block(block_number).unwrap().unwrap();
+            assert_eq!(block.hash(), dummy_block.hash());
+        }
+    }
+
+    #[test]
+    fn pruned_segments_are_archived() {
+        let dir = tempfile::tempdir().unwrap();
+        let archive_dir = dir.path().join("archive");
+        let dummy_block: SignedBlock = ValidBlock::new_dummy().into();
+        let mut block_store = BlockStore::new(dir.path(), LockStatus::Unlocked);
+        block_store.create_files_if_they_do_not_exist().unwrap();
+
+        let segment_size = usize::try_from(SEGMENT_SIZE).unwrap();
+        block_store
+            .write_blocks_at_height(0, vec![&dummy_block; 2 * segment_size + 1])
+            .unwrap();
+
+        // Neither the genesis segment nor the one containing the block itself are pruned
+        assert_eq!(
+            block_store
+                .prune_segments_below(2 * SEGMENT_SIZE - 1, Some(&archive_dir))
+                .unwrap(),
+            0
+        );
+        assert_eq!(
+            block_store
+                .prune_segments_below(2 * SEGMENT_SIZE, Some(&archive_dir))
+                .unwrap(),
+            1
+        );
+        assert!(archive_dir.join(segment_file_name(1)).exists());
+        assert!(!dir.path().join(segment_file_name(1)).exists());
+
+        let block_map = BlockStoreMap::new(dir.path()).unwrap();
+        assert!(!block_map.is_pruned(SEGMENT_SIZE - 1));
+        assert!(block_map.is_pruned(SEGMENT_SIZE));
+        assert!(block_map.read_block(0).is_some());
+        assert!(block_map.read_block(SEGMENT_SIZE).is_none());
+        assert!(block_map.read_block(2 * SEGMENT_SIZE).is_some());
+    }
+
+    #[test]
+    fn only_verified_sealed_segments_are_trusted() {
+        let dir = tempfile::tempdir().unwrap();
+        let dummy_block: SignedBlock = ValidBlock::new_dummy().into();
+        let mut block_store = BlockStore::new(dir.path(), LockStatus::Unlocked);
+        block_store.create_files_if_they_do_not_exist().unwrap();
+
+        let segment_size = usize::try_from(SEGMENT_SIZE).unwrap();
+        let block_count = segment_size + 1;
+        block_store
+            .write_blocks_at_height(0, vec![&dummy_block; block_count])
+            .unwrap();
+        let layout = block_store.layout().unwrap();
+        assert_eq!(
+            Kura::sealed_blocks(&block_store, layout, block_count),
+            0..segment_size
+        );
+
+        let path = dir.path().join(segment_file_name(0));
+        let mut data = fs::read(&path).unwrap();
+        let middle = data.len() / 2;
+        data[middle] ^= 1;
+        fs::write(&path, data).unwrap();
+        assert_eq!(Kura::sealed_blocks(&block_store, layout, block_count), 0..0);
+    }
+
+    #[test]
+    fn blocks_continue_after_legacy_data_file() {
+        let dir = tempfile::tempdir().unwrap();
+        let dummy_block: SignedBlock = ValidBlock::new_dummy().into();
+        {
+            let mut block_store = BlockStore::new(dir.path(), LockStatus::Unlocked);
+            block_store.create_files_if_they_do_not_exist().unwrap();
+            block_store.append_block_to_chain(&dummy_block).unwrap();
+            block_store.append_block_to_chain(&dummy_block).unwrap();
+        }
+        // Turn the store into one written before segments were introduced
+        fs::rename(
+            dir.path().join(segment_file_name(0)),
+            dir.path().join(DATA_FILE_NAME),
+        )
+        .unwrap();
+        fs::remove_file(dir.path().join(LAYOUT_FILE_NAME)).unwrap();
+        assert_eq!(
+            BlockStoreMap::new(dir.path()).unwrap().layout(),
+            SegmentLayout::LEGACY
+        );
+
+        let mut block_store = BlockStore::new(dir.path(), LockStatus::Unlocked);
+        block_store.create_files_if_they_do_not_exist().unwrap();
+        block_store.append_block_to_chain(&dummy_block).unwrap();
+        assert_eq!(block_store.layout().unwrap().legacy_block_count, 2);
+        assert_eq!(block_store.read_block_index(2).unwrap().start, 0);
+
+        let block_map = BlockStoreMap::new(dir.path()).unwrap();
+        for block_number in 0..3 {
+            let block = block_map.read_block(block_number).unwrap().unwrap();
+            assert_eq!(block.hash(), dummy_block.hash());
+        }
+    }
+
+    #[test]
+    fn block_cache_stays_within_budget() {
+        let block = Arc::new(SignedBlock::from(ValidBlock::new_dummy()));
+        let mut cache = BlockCache::new(1000);
+
+        for block_number in 0..10 {
+            cache.insert(block_number, Arc::clone(&block), 300);
+        }
+
+        let stats = cache.stats();
+        assert_eq!(stats.size_bytes, 900);
+        assert_eq!(stats.evictions, 7);
+        assert!(cache.get(0).is_none());
+        assert!(cache.get(9).is_some());
+        assert_eq!((cache.stats().hits, cache.stats().misses), (1, 1));
+    }
+
+    #[test]
+    fn block_cache_is_scan_resistant() {
+        let block = Arc::new(SignedBlock::from(ValidBlock::new_dummy()));
+        let mut cache = BlockCache::new(1000);
+
+        // Hot tip is accessed repeatedly and ends up in the protected segment
+        cache.insert(1000, Arc::clone(&block), 100);
+        assert!(cache.get(1000).is_some());
+
+        // Sequential scan touches every block once
+        for block_number in 0..100 {
+            if cache.get(block_number).is_none() {
+                cache.insert(block_number, Arc::clone(&block), 100);
+            }
+        }
+
+        assert!(cache.get(1000).is_some());
+        assert!(cache.stats().size_bytes <= 1000);
+    }
+
+    #[test]
+    fn block_data_tracks_heights_across_soft_fork() {
+        let first = HashOf::from_untyped_unchecked(Hash::new([1]));
+        let second = HashOf::from_untyped_unchecked(Hash::new([2]));
+        let forked = HashOf::from_untyped_unchecked(Hash::new([3]));
+
+        let mut block_data = BlockData::default();
+        block_data.push(first, None);
+        block_data.push(second, None);
+        assert_eq!(block_data.block_number(&second), Some(1));
+
+        block_data.pop();
+        block_data.push(forked, None);
+        assert_eq!(block_data.block_number(&first), Some(0));
+        assert_eq!(block_data.block_number(&second), None);
+        assert_eq!(block_data.block_number(&forked), Some(1));
+        assert_eq!(block_data.len(), 2);
+    }
+
     #[test]
     fn lock_and_unlock() {
         let dir = tempfile::tempdir().unwrap();
@@ -1048,6 +3579,202 @@ mod tests {
             .expect("Lockfile should have been created");
     }
 
+    #[test]
+    fn strict_init_stops_at_broken_chain() {
+        let dir = tempfile::tempdir().unwrap();
+        let mut block_store = BlockStore::new(dir.path(), LockStatus::Unlocked);
+        block_store.create_files_if_they_do_not_exist().unwrap();
+
+        // Dummy blocks have no previous block hash, so only the first one forms a chain
+        let dummy_block: SignedBlock = ValidBlock::new_dummy().into();
+        let block_count = 2 * STRICT_INIT_CHUNK_SIZE + 1;
+        for _ in 0..block_count {
+            block_store.append_block_to_chain(&dummy_block).unwrap();
+        }
+
+        let block_hashes = Kura::init_strict_mode(&mut block_store, block_count, 0..0).unwrap();
+        assert_eq!(block_hashes, [dummy_block.hash()]);
+        assert_eq!(block_store.read_hashes_count().unwrap(), 1);
+    }
+
+    #[test]
+    fn verify_init_only_decodes_unverified_blocks() {
+        let dir = tempfile::tempdir().unwrap();
+        let mut block_store = BlockStore::new(dir.path(), LockStatus::Unlocked);
+        block_store.create_files_if_they_do_not_exist().unwrap();
+
+        // Dummy blocks have no previous block hash, so decoding any but the first breaks the chain
+        let dummy_block: SignedBlock = ValidBlock::new_dummy().into();
+        for _ in 0..4 {
+            block_store.append_block_to_chain(&dummy_block).unwrap();
+        }
+        block_store.sync().unwrap();
+
+        // Only the last block is decoded
+        let block_hashes = Kura::init_verify_mode(&mut block_store, 4).unwrap();
+        assert_eq!(block_hashes.len(), 3);
+
+        let BlockIndex { start, .. } = block_store.read_block_index(1).unwrap();
+        block_store
+            .write_block_data(1, start, b"corrupted")
+            .unwrap();
+        let block_hashes = Kura::init_verify_mode(&mut block_store, 3).unwrap();
+        assert_eq!(block_hashes, [dummy_block.hash()]);
+        assert_eq!(block_store.read_hashes_count().unwrap(), 1);
+    }
+
+    #[test]
+    fn transactions_are_located_through_index() {
+        let dir = tempfile::tempdir().unwrap();
+        let mut block_store = BlockStore::new(dir.path(), LockStatus::Unlocked);
+        block_store.create_files_if_they_do_not_exist().unwrap();
+        let block = block_with_transactions(3);
+        let tx_hashes: Vec<_> = block.transactions().map(|tx| tx.as_ref().hash()).collect();
+        block_store
+            .append_block_to_chain(&ValidBlock::new_dummy().into())
+            .unwrap();
+        block_store.append_block_to_chain(&block).unwrap();
+
+        let block_map = BlockStoreMap::new(dir.path()).unwrap();
+        assert_eq!(block_map.transaction_count(0), Some(0));
+        assert_eq!(block_map.transaction_count(1), Some(3));
+        assert_eq!(block_map.transaction_position(1, &tx_hashes[2]), Some(2));
+        assert_eq!(block_map.transaction_position(0, &tx_hashes[2]), None);
+        assert_eq!(block_map.transaction_count(2), None);
+    }
+
+    #[test]
+    fn account_transactions_are_read_from_index() {
+        let dir = tempfile::tempdir().unwrap();
+        let mut block_store = BlockStore::new(dir.path(), LockStatus::Unlocked);
+        block_store.create_files_if_they_do_not_exist().unwrap();
+        let block = block_with_transactions(2);
+        let account_id = block.transactions().next().unwrap().as_ref().authority();
+        block_store
+            .append_block_to_chain(&ValidBlock::new_dummy().into())
+            .unwrap();
+        block_store.append_block_to_chain(&block).unwrap();
+
+        let mut account_transactions = block_store.read_account_transactions(2).unwrap();
+        let locations = [0, 1].map(|index| TransactionLocation {
+            block_height: 2,
+            index,
+        });
+        assert_eq!(
+            account_transactions.get(account_id),
+            Some(locations.as_slice())
+        );
+        assert!(block_store.read_account_transactions(3).is_err());
+
+        // Replacing the top block drops its transactions
+        account_transactions.pop_top_block(2);
+        assert_eq!(account_transactions.get(account_id), None);
+    }
+
+    #[test]
+    fn account_transactions_are_read_after_checkpoint() {
+        let dir = tempfile::tempdir().unwrap();
+        let mut block_store = BlockStore::new(dir.path(), LockStatus::Unlocked);
+        block_store.create_files_if_they_do_not_exist().unwrap();
+        let block = block_with_transactions(2);
+        let account_id = block.transactions().next().unwrap().as_ref().authority();
+        for _ in 0..3 {
+            block_store.append_block_to_chain(&block).unwrap();
+        }
+        let account_transactions = RwLock::new(block_store.read_account_transactions(3).unwrap());
+        let checkpoint = AccountTransactions::encode_checkpoint(&account_transactions, 2);
+        block_store
+            .write_account_transactions_checkpoint(&checkpoint)
+            .unwrap();
+
+        // Blocks after the checkpoint are read from the transaction index
+        let locations: Vec<_> = (1..=3)
+            .flat_map(|block_height| {
+                [0, 1].map(|index| TransactionLocation {
+                    block_height,
+                    index,
+                })
+            })
+            .collect();
+        let account_transactions = block_store.read_account_transactions(3).unwrap();
+        assert_eq!(
+            account_transactions.get(account_id),
+            Some(locations.as_slice())
+        );
+        let page = account_transactions.page(&account_key(account_id), 1, 2);
+        assert_eq!(page, locations[1..3]);
+
+        // A checkpoint beyond the top block is ignored
+        let account_transactions = block_store.read_account_transactions(2).unwrap();
+        assert_eq!(account_transactions.get(account_id), Some(&locations[..4]));
+    }
+
+    #[test]
+    fn transaction_index_is_rebuilt_from_blocks() {
+        let dir = tempfile::tempdir().unwrap();
+        let mut block_store = BlockStore::new(dir.path(), LockStatus::Unlocked);
+        block_store.create_files_if_they_do_not_exist().unwrap();
+        for tx_count in [2, 0, 1] {
+            block_store
+                .append_block_to_chain(&block_with_transactions(tx_count))
+                .unwrap();
+        }
+        let read_tx_files = || {
+            [
+                TX_INDEX_FILE_NAME,
+                TX_HASHES_FILE_NAME,
+                TX_AUTHORITIES_FILE_NAME,
+            ]
+            .map(|file_name| fs::read(dir.path().join(file_name)).unwrap())
+        };
+        let tx_files = read_tx_files();
+
+        fs::remove_file(dir.path().join(TX_INDEX_FILE_NAME)).unwrap();
+        fs::remove_file(dir.path().join(TX_AUTHORITIES_FILE_NAME)).unwrap();
+        block_store.create_files_if_they_do_not_exist().unwrap();
+
+        assert_eq!(read_tx_files(), tx_files);
+    }
+
+    #[test]
+    fn checksums_are_created_for_existing_blocks() {
+        let dir = tempfile::tempdir().unwrap();
+        let dummy_block: SignedBlock = ValidBlock::new_dummy().into();
+        let mut block_store = BlockStore::new(dir.path(), LockStatus::Unlocked);
+        block_store.create_files_if_they_do_not_exist().unwrap();
+        block_store.append_block_to_chain(&dummy_block).unwrap();
+        block_store.append_block_to_chain(&dummy_block).unwrap();
+        let checksums = block_store.read_block_checksums(0, 2).unwrap();
+
+        fs::remove_file(dir.path().join(CHECKSUMS_FILE_NAME)).unwrap();
+        block_store.create_files_if_they_do_not_exist().unwrap();
+
+        assert_eq!(block_store.read_block_checksums(0, 2).unwrap(), checksums);
+        let block_map = BlockStoreMap::new(dir.path()).unwrap();
+        assert_eq!(block_map.block_checksum(1), Some(checksums[1]));
+    }
+
+    #[test]
+    fn checksums_are_not_created_for_corrupted_blocks() {
+        let dir = tempfile::tempdir().unwrap();
+        let dummy_block: SignedBlock = ValidBlock::new_dummy().into();
+        let mut block_store = BlockStore::new(dir.path(), LockStatus::Unlocked);
+        block_store.create_files_if_they_do_not_exist().unwrap();
+        for _ in 0..3 {
+            block_store.append_block_to_chain(&dummy_block).unwrap();
+        }
+
+        let BlockIndex { start, .. } = block_store.read_block_index(1).unwrap();
+        let path = dir.path().join(segment_file_name(0));
+        let mut data = fs::read(&path).unwrap();
+        data[usize::try_from(start).unwrap() + 1] ^= 1;
+        fs::write(&path, data).unwrap();
+        fs::remove_file(dir.path().join(CHECKSUMS_FILE_NAME)).unwrap();
+        block_store.create_files_if_they_do_not_exist().unwrap();
+
+        assert_eq!(block_store.read_checksums_count().unwrap(), 1);
+    }
+
     #[tokio::test]
     async fn strict_init_kura() {
         let temp_dir = TempDir::new().unwrap();
@@ -1056,6 +3783,12 @@ mod tests {
             store_dir: iroha_config::base::WithOrigin::inline(
                 temp_dir.path().to_str().unwrap().into(),
             ),
+            block_cache_size_bytes: iroha_config::parameters::defaults::kura::BLOCK_CACHE_SIZE,
+            block_compression: iroha_config::kura::BlockCompression::None,
+            durability_mode: iroha_config::kura::DurabilityMode::Batch,
+            sync_interval: iroha_config::parameters::defaults::kura::SYNC_INTERVAL,
+            pruning_mode: iroha_config::kura::PruningMode::None,
+            archive_dir: iroha_config::base::WithOrigin::inline(temp_dir.path().join("archive")),
             debug_output_new_blocks: false,
         })
         .unwrap();
@@ -1,9 +1,11 @@
 //! Iroha — A simple, enterprise-grade decentralized ledger.
 
 pub mod block;
+pub mod block_hashes;
 pub mod block_sync;
 pub mod executor;
 pub mod gossiper;
+pub mod hot_keys;
 pub mod kiso;
 pub mod kura;
 pub mod metrics;
@@ -12,8 +14,10 @@ pub mod queue;
 pub mod smartcontracts;
 pub mod snapshot;
 pub mod state;
+pub mod state_root;
 pub mod sumeragi;
 pub mod tx;
+pub mod tx_set;
 
 use core::time::Duration;
 
@@ -151,6 +155,139 @@ pub mod role {
         key: RoleIdWithOwnerRef<'_>,
         trait: AsRoleIdWithOwnerRef
     }
+
+    /// [`RoleId`] with an [`AccountId`] granted this role, to order accounts by role.
+    #[derive(
+        Debug,
+        Clone,
+        Constructor,
+        PartialEq,
+        Eq,
+        PartialOrd,
+        Ord,
+        Hash,
+        Decode,
+        Encode,
+        Deserialize,
+        Serialize,
+    )]
+    pub struct RoleIdWithHolder {
+        /// [`RoleId`] of the granted role.
+        pub role_id: RoleId,
+        /// [`AccountId`] of the holder.
+        pub account_id: AccountId,
+    }
+
+    impl From<RoleIdWithOwner> for RoleIdWithHolder {
+        fn from(role: RoleIdWithOwner) -> Self {
+            Self {
+                role_id: role.role_id,
+                account_id: role.account_id,
+            }
+        }
+    }
+}
+
+pub mod asset {
+    //! Module with extension for [`AssetDefinitionId`] to be stored inside state.
+
+    use derive_more::Constructor;
+    use serde::{Deserialize, Serialize};
+
+    use super::*;
+
+    /// [`AssetDefinitionId`] with an [`AccountId`] holding asset of this definition.
+    #[derive(
+        Debug,
+        Clone,
+        Constructor,
+        PartialEq,
+        Eq,
+        PartialOrd,
+        Ord,
+        Hash,
+        Decode,
+        Encode,
+        Deserialize,
+        Serialize,
+    )]
+    pub struct AssetDefinitionIdWithHolder {
+        /// [`AssetDefinitionId`] of the held asset.
+        pub definition_id: AssetDefinitionId,
+        /// [`AccountId`] of the holder.
+        pub account_id: AccountId,
+    }
+
+    impl From<AssetId> for AssetDefinitionIdWithHolder {
+        fn from(asset_id: AssetId) -> Self {
+            Self {
+                definition_id: asset_id.definition_id,
+                account_id: asset_id.account_id,
+            }
+        }
+    }
+
+    /// [`AccountId`] with an [`AssetDefinitionId`] of an asset it holds, to order assets by holder.
+    #[derive(
+        Debug,
+        Clone,
+        Constructor,
+        PartialEq,
+        Eq,
+        PartialOrd,
+        Ord,
+        Hash,
+        Decode,
+        Encode,
+        Deserialize,
+        Serialize,
+    )]
+    pub struct AccountIdWithAssetDefinition {
+        /// [`AccountId`] of the holder.
+        pub account_id: AccountId,
+        /// [`AssetDefinitionId`] of the held asset.
+        pub definition_id: AssetDefinitionId,
+    }
+
+    impl From<AssetId> for AccountIdWithAssetDefinition {
+        fn from(asset_id: AssetId) -> Self {
+            Self {
+                account_id: asset_id.account_id,
+                definition_id: asset_id.definition_id,
+            }
+        }
+    }
+
+    /// [`AssetDefinitionId`] with its [`Name`] in front, to order definitions by name.
+    #[derive(
+        Debug,
+        Clone,
+        Constructor,
+        PartialEq,
+        Eq,
+        PartialOrd,
+        Ord,
+        Hash,
+        Decode,
+        Encode,
+        Deserialize,
+        Serialize,
+    )]
+    pub struct AssetDefinitionIdWithName {
+        /// [`Name`] of the asset definition.
+        pub name: Name,
+        /// [`AssetDefinitionId`] of the asset definition.
+        pub definition_id: AssetDefinitionId,
+    }
+
+    impl From<AssetDefinitionId> for AssetDefinitionIdWithName {
+        fn from(definition_id: AssetDefinitionId) -> Self {
+            Self {
+                name: definition_id.name.clone(),
+                definition_id,
+            }
+        }
+    }
 }
 
 pub mod prelude {
@@ -3,14 +3,17 @@
 use std::{sync::Arc, time::SystemTime};
 
 use eyre::{Result, WrapErr as _};
+use iroha_crypto::Hash;
 use iroha_telemetry::metrics::Metrics;
 use parking_lot::Mutex;
 use storage::storage::StorageReadOnly;
 
 use crate::{
+    hot_keys::{HotKeys, HotKeysReport},
     kura::Kura,
     queue::Queue,
     state::{State, StateReadOnly, WorldReadOnly},
+    state_root::StateRootReadOnly,
     IrohaNetwork,
 };
 
@@ -34,12 +37,14 @@ impl MetricsReporter {
         kura: Arc<Kura>,
         queue: Arc<Queue>,
     ) -> Self {
+        let metrics = Metrics::default();
+        kura.observe_durable_latency(metrics.kura_commit_to_durable.clone());
         Self {
             state,
             network,
             queue,
             kura,
-            metrics: Metrics::default(),
+            metrics,
             latest_block_height: Arc::new(Mutex::new(0)),
         }
     }
@@ -136,11 +141,43 @@ impl MetricsReporter {
                 .accounts
                 .get_metric_with_label_values(&[domain.id.name.as_ref()])
                 .wrap_err("Failed to compose domains")?
-                .set(domain.accounts.len() as u64);
+                .set(
+                    state_view
+                        .world()
+                        .accounts_in_domain_iter(&domain.id)
+                        .count() as u64,
+                );
         }
 
         self.metrics.queue_size.set(self.queue.tx_len() as u64);
 
+        let block_cache = self.kura.block_cache_stats();
+        for (kind, total) in [
+            ("hit", block_cache.hits),
+            ("miss", block_cache.misses),
+            ("eviction", block_cache.evictions),
+        ] {
+            let counter = self.metrics.kura_block_cache.with_label_values(&[kind]);
+            counter.inc_by(total.saturating_sub(counter.get()));
+        }
+        self.metrics
+            .kura_block_cache_bytes
+            .set(block_cache.size_bytes);
+
+        if let Some(hot_keys) = self.hot_keys() {
+            // Keys drop out of the top, so gauges of the previous block are removed
+            self.metrics.hot_keys.reset();
+            for count in hot_keys.keys {
+                let (kind, key) = (count.key.kind(), count.key.id());
+                for (access, total) in [("read", count.reads), ("write", count.writes)] {
+                    self.metrics
+                        .hot_keys
+                        .with_label_values(&[kind, key.as_str(), access])
+                        .set(total);
+                }
+            }
+        }
+
         Ok(())
     }
 
@@ -148,4 +185,14 @@ impl MetricsReporter {
     pub fn metrics(&self) -> &Metrics {
         &self.metrics
     }
+
+    /// The most accessed keys of the latest committed block, [`None`] if tracing is disabled.
+    pub fn hot_keys(&self) -> Option<HotKeysReport> {
+        self.state.hot_keys.as_ref().map(HotKeys::latest)
+    }
+
+    /// Commitment to the world state as of the latest committed block
+    pub fn state_root(&self) -> Hash {
+        self.state.view().state_root.root()
+    }
 }
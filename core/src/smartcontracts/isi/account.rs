@@ -36,7 +36,10 @@ pub mod isi {
 
     use self::asset::isi::assert_numeric_spec;
     use super::*;
-    use crate::{role::RoleIdWithOwner, state::StateTransaction};
+    use crate::{
+        role::{RoleIdWithHolder, RoleIdWithOwner},
+        state::StateTransaction,
+    };
 
     impl Execute for Register<Asset> {
         #[metrics(+"register_asset")]
@@ -96,14 +99,7 @@ pub mod isi {
         ) -> Result<(), Error> {
             let asset_id = self.object_id;
 
-            let asset = state_transaction
-                .world
-                .account_mut(&asset_id.account_id)
-                .and_then(|account| {
-                    account
-                        .remove_asset(&asset_id.definition_id)
-                        .ok_or_else(|| FindError::Asset(asset_id))
-                })?;
+            let asset = state_transaction.world.remove_asset(&asset_id)?;
 
             match asset.value {
                 AssetValue::Numeric(increment) => {
@@ -356,6 +352,13 @@ pub mod isi {
                 }
                 .into());
             }
+            state_transaction.world.role_holders.insert(
+                RoleIdWithHolder::new(role_id.clone(), account_id.clone()),
+                (),
+            );
+            state_transaction
+                .world
+                .update_account_effective_permissions(&account_id);
 
             state_transaction.world.emit_events({
                 let account_id_clone = account_id.clone();
@@ -409,6 +412,13 @@ pub mod isi {
             {
                 return Err(FindError::Role(role_id).into());
             }
+            state_transaction
+                .world
+                .role_holders
+                .remove(RoleIdWithHolder::new(role_id.clone(), account_id.clone()));
+            state_transaction
+                .world
+                .update_account_effective_permissions(&account_id);
 
             state_transaction.world.emit_events({
                 let account_id_clone = account_id.clone();
@@ -547,13 +557,7 @@ pub mod query {
             &self,
             state_ro: &'state impl StateReadOnly,
         ) -> Result<Box<dyn Iterator<Item = Account> + 'state>, Error> {
-            Ok(Box::new(
-                state_ro
-                    .world()
-                    .domains_iter()
-                    .flat_map(|domain| domain.accounts.values())
-                    .cloned(),
-            ))
+            Ok(Box::new(state_ro.world().accounts_iter().cloned()))
         }
     }
 
@@ -578,8 +582,9 @@ pub mod query {
             let id = &self.domain_id;
 
             iroha_logger::trace!(%id);
+            let _domain = state_ro.world().domain(id)?;
             Ok(Box::new(
-                state_ro.world().domain(id)?.accounts.values().cloned(),
+                state_ro.world().accounts_in_domain_iter(id).cloned(),
             ))
         }
     }
@@ -607,14 +612,13 @@ pub mod query {
             let asset_definition_id = self.asset_definition_id.clone();
             iroha_logger::trace!(%asset_definition_id);
 
+            let world = state_ro.world();
+            let domain_id = &world.domain(&asset_definition_id.domain_id)?.id;
             Ok(Box::new(
-                state_ro
-                    .world()
-                    .map_domain(&asset_definition_id.domain_id.clone(), move |domain| {
-                        domain.accounts.values().filter(move |account| {
-                            account.assets.contains_key(&asset_definition_id)
-                        })
-                    })?
+                world
+                    .asset_holders_iter(&asset_definition_id)
+                    .filter(move |account_id| &account_id.domain_id == domain_id)
+                    .filter_map(move |account_id| world.accounts().get(account_id))
                     .cloned(),
             ))
         }
@@ -144,14 +144,7 @@ pub mod isi {
                 expected_asset_value_type_store,
             )?;
 
-            let asset = state_transaction
-                .world
-                .account_mut(&asset_id.account_id)
-                .and_then(|account| {
-                    account
-                        .remove_asset(&asset_id.definition_id)
-                        .ok_or_else(|| FindError::Asset(asset_id.clone()))
-                })?;
+            let asset = state_transaction.world.remove_asset(&asset_id)?;
 
             let destination_store = {
                 let destination_id =
@@ -235,11 +228,7 @@ pub mod isi {
             )?;
             assert_numeric_spec(&self.object, &asset_definition)?;
 
-            let account = state_transaction.world.account_mut(&asset_id.account_id)?;
-            let asset = account
-                .assets
-                .get_mut(&asset_id.definition_id)
-                .ok_or_else(|| FindError::Asset(asset_id.clone()))?;
+            let asset = state_transaction.world.asset_mut(&asset_id)?;
             let AssetValue::Numeric(quantity) = &mut asset.value else {
                 return Err(Error::Conversion("Expected numeric asset type".to_owned()));
             };
@@ -248,7 +237,7 @@ pub mod isi {
                 .ok_or(MathError::NotEnoughQuantity)?;
 
             if asset.value.is_zero_value() {
-                assert!(account.remove_asset(&asset_id.definition_id).is_some());
+                assert!(state_transaction.world.remove_asset(&asset_id).is_ok());
             }
 
             #[allow(clippy::float_arithmetic)]
@@ -291,11 +280,7 @@ pub mod isi {
             assert_numeric_spec(&self.object, &asset_definition)?;
 
             {
-                let account = state_transaction.world.account_mut(&source_id.account_id)?;
-                let asset = account
-                    .assets
-                    .get_mut(&source_id.definition_id)
-                    .ok_or_else(|| FindError::Asset(source_id.clone()))?;
+                let asset = state_transaction.world.asset_mut(&source_id)?;
                 let AssetValue::Numeric(quantity) = &mut asset.value else {
                     return Err(Error::Conversion("Expected numeric asset type".to_owned()));
                 };
@@ -303,7 +288,7 @@ pub mod isi {
                     .checked_sub(self.object)
                     .ok_or(MathError::NotEnoughQuantity)?;
                 if asset.value.is_zero_value() {
-                    assert!(account.remove_asset(&source_id.definition_id).is_some());
+                    assert!(state_transaction.world.remove_asset(&source_id).is_ok());
                 }
             }
 
@@ -431,7 +416,7 @@ pub mod query {
     };
 
     use super::*;
-    use crate::state::StateReadOnly;
+    use crate::{asset::AccountIdWithAssetDefinition, state::StateReadOnly};
 
     impl ValidQuery for FindAllAssets {
         #[metrics(+"find_all_assets")]
@@ -439,18 +424,7 @@ pub mod query {
             &self,
             state_ro: &'state impl StateReadOnly,
         ) -> Result<Box<dyn Iterator<Item = Asset> + 'state>, Error> {
-            Ok(Box::new(
-                state_ro
-                    .world()
-                    .domains_iter()
-                    .flat_map(|domain| {
-                        domain
-                            .accounts
-                            .values()
-                            .flat_map(|account| account.assets.values())
-                    })
-                    .cloned(),
-            ))
+            Ok(Box::new(state_ro.world().assets_iter().cloned()))
         }
     }
 
@@ -504,24 +478,26 @@ pub mod query {
         ) -> Result<Box<dyn Iterator<Item = Asset> + 'state>, Error> {
             let name = self.name.clone();
             iroha_logger::trace!(%name);
-            Ok(Box::new(
-                state_ro
-                    .world()
-                    .domains_iter()
-                    .flat_map(move |domain| {
-                        let name = name.clone();
-
-                        domain.accounts.values().flat_map(move |account| {
-                            let name = name.clone();
-
-                            account
-                                .assets
-                                .values()
-                                .filter(move |asset| asset.id().definition_id.name == name)
+            let world = state_ro.world();
+            let mut assets = world
+                .asset_definitions_by_name_iter(&name)
+                .flat_map(|definition_id| {
+                    world
+                        .asset_holders_iter(definition_id)
+                        .filter_map(move |account_id| {
+                            world.assets().get(&AccountIdWithAssetDefinition::new(
+                                account_id.clone(),
+                                definition_id.clone(),
+                            ))
                         })
-                    })
-                    .cloned(),
-            ))
+                })
+                .collect::<Vec<_>>();
+            // Holders are found per definition, keep assets ordered by domain and account
+            assets.sort_unstable_by(|lhs, rhs| {
+                (&lhs.id().account_id, &lhs.id().definition_id)
+                    .cmp(&(&rhs.id().account_id, &rhs.id().definition_id))
+            });
+            Ok(Box::new(assets.into_iter().cloned()))
         }
     }
 
@@ -545,21 +521,15 @@ pub mod query {
         ) -> Result<Box<dyn Iterator<Item = Asset> + 'state>, Error> {
             let id = self.asset_definition_id.clone();
             iroha_logger::trace!(%id);
+            let world = state_ro.world();
             Ok(Box::new(
-                state_ro
-                    .world()
-                    .domains_iter()
-                    .flat_map(move |domain| {
-                        let id = id.clone();
-
-                        domain.accounts.values().flat_map(move |account| {
-                            let id = id.clone();
-
-                            account
-                                .assets
-                                .values()
-                                .filter(move |asset| asset.id().definition_id == id)
-                        })
+                world
+                    .asset_holders_iter(&id)
+                    .filter_map(move |account_id| {
+                        world.assets().get(&AccountIdWithAssetDefinition::new(
+                            account_id.clone(),
+                            id.clone(),
+                        ))
                     })
                     .cloned(),
             ))
@@ -574,13 +544,12 @@ pub mod query {
         ) -> Result<Box<dyn Iterator<Item = Asset> + 'state>, Error> {
             let id = &self.domain_id;
             iroha_logger::trace!(%id);
+            let world = state_ro.world();
+            let _domain = world.domain(id)?;
             Ok(Box::new(
-                state_ro
-                    .world()
-                    .domain(id)?
-                    .accounts
-                    .values()
-                    .flat_map(|account| account.assets.values())
+                world
+                    .accounts_in_domain_iter(id)
+                    .flat_map(move |account| world.assets_in_account_iter(account.id()))
                     .cloned(),
             ))
         }
@@ -594,24 +563,22 @@ pub mod query {
         ) -> Result<Box<dyn Iterator<Item = Asset> + 'state>, Error> {
             let domain_id = self.domain_id.clone();
             let asset_definition_id = self.asset_definition_id.clone();
-            let domain = state_ro.world().domain(&domain_id)?;
+            let world = state_ro.world();
+            let domain = world.domain(&domain_id)?;
             let _definition = domain
                 .asset_definitions
                 .get(&asset_definition_id)
                 .ok_or_else(|| FindError::AssetDefinition(asset_definition_id.clone()))?;
             iroha_logger::trace!(%domain_id, %asset_definition_id);
             Ok(Box::new(
-                domain
-                    .accounts
-                    .values()
-                    .flat_map(move |account| {
-                        let domain_id = domain_id.clone();
-                        let asset_definition_id = asset_definition_id.clone();
-
-                        account.assets.values().filter(move |asset| {
-                            asset.id().account_id.domain_id == domain_id
-                                && asset.id().definition_id == asset_definition_id
-                        })
+                world
+                    .asset_holders_iter(&self.asset_definition_id)
+                    .filter(move |account_id| account_id.domain_id == domain_id)
+                    .filter_map(move |account_id| {
+                        world.assets().get(&AccountIdWithAssetDefinition::new(
+                            account_id.clone(),
+                            asset_definition_id.clone(),
+                        ))
                     })
                     .cloned(),
             ))
@@ -2,7 +2,6 @@
 
 use eyre::Result;
 use iroha_data_model::{
-    account::AccountsMap,
     asset::{AssetDefinitionsMap, AssetTotalQuantityMap},
     prelude::*,
     query::error::FindError,
@@ -19,7 +18,6 @@ impl Registrable for iroha_data_model::domain::NewDomain {
     fn build(self, authority: &AccountId) -> Self::Target {
         Self::Target {
             id: self.id,
-            accounts: AccountsMap::default(),
             asset_definitions: AssetDefinitionsMap::default(),
             asset_total_quantities: AssetTotalQuantityMap::default(),
             metadata: self.metadata,
@@ -56,15 +54,18 @@ pub mod isi {
                 ));
             }
 
-            let domain = state_transaction.world.domain_mut(&account_id.domain_id)?;
-            if domain.accounts.contains_key(&account_id) {
+            let _domain = state_transaction.world.domain(&account_id.domain_id)?;
+            if state_transaction.world.accounts.get(&account_id).is_some() {
                 return Err(RepetitionError {
                     instruction_type: InstructionType::Register,
                     id: IdBox::AccountId(account_id),
                 }
                 .into());
             }
-            domain.add_account(account.clone());
+            state_transaction
+                .world
+                .accounts
+                .insert(account_id, account.clone());
 
             state_transaction
                 .world
@@ -101,14 +102,7 @@ pub mod isi {
                         .expect("should succeed")
                 });
 
-            if state_transaction
-                .world
-                .domain_mut(&account_id.domain_id)?
-                .remove_account(&account_id)
-                .is_none()
-            {
-                return Err(FindError::Account(account_id).into());
-            }
+            state_transaction.world.remove_account(&account_id)?;
 
             state_transaction
                 .world
@@ -147,6 +141,10 @@ pub mod isi {
             domain.add_asset_total_quantity(asset_definition_id, Numeric::ZERO);
 
             domain.add_asset_definition(asset_definition.clone());
+            state_transaction
+                .world
+                .asset_definitions_by_name
+                .insert(asset_definition_id.clone().into(), ());
 
             state_transaction
                 .world
@@ -167,33 +165,15 @@ pub mod isi {
         ) -> Result<(), Error> {
             let asset_definition_id = self.object_id;
 
-            let mut assets_to_remove = Vec::new();
-            for domain in state_transaction.world.domains_iter() {
-                for account in domain.accounts.values() {
-                    assets_to_remove.extend(
-                        account
-                            .assets
-                            .values()
-                            .filter_map(|asset| {
-                                if asset.id().definition_id == asset_definition_id {
-                                    return Some(asset.id());
-                                }
-
-                                None
-                            })
-                            .cloned(),
-                    )
-                }
-            }
+            let assets_to_remove = state_transaction
+                .world
+                .asset_holders_iter(&asset_definition_id)
+                .map(|account_id| AssetId::new(asset_definition_id.clone(), account_id.clone()))
+                .collect::<Vec<_>>();
 
             let mut events = Vec::with_capacity(assets_to_remove.len() + 1);
             for asset_id in assets_to_remove {
-                if state_transaction
-                    .world
-                    .account_mut(&asset_id.account_id)?
-                    .remove_asset(&asset_id.definition_id)
-                    .is_none()
-                {
+                if state_transaction.world.remove_asset(&asset_id).is_err() {
                     error!(%asset_id, "asset not found. This is a bug");
                 }
 
@@ -211,6 +191,10 @@ pub mod isi {
             }
 
             domain.remove_asset_total_quantity(&asset_definition_id);
+            state_transaction
+                .world
+                .asset_definitions_by_name
+                .remove(asset_definition_id.clone().into());
 
             events.push(DataEvent::from(DomainEvent::AssetDefinition(
                 AssetDefinitionEvent::Deleted(asset_definition_id),
@@ -259,7 +259,7 @@ mod tests {
     };
 
     fn state_with_test_domains(kura: &Arc<Kura>) -> Result<State> {
-        let world = World::with([], PeersIds::new());
+        let world = World::with([], [], PeersIds::new());
         let query_handle = LiveQueryStore::test().start();
         let state = State::new(world, kura.clone(), query_handle);
         let asset_definition_id = AssetDefinitionId::from_str("rose#wonderland")?;
@@ -307,6 +307,162 @@ mod tests {
         Ok(())
     }
 
+    #[test]
+    async fn asset_holders() -> Result<()> {
+        fn holders(world: &impl WorldReadOnly, id: &AssetDefinitionId) -> Vec<AccountId> {
+            world.asset_holders_iter(id).cloned().collect()
+        }
+
+        let kura = Kura::blank_kura_for_testing();
+        let state = state_with_test_domains(&kura)?;
+        let mut state_block = state.block();
+        let mut state_transaction = state_block.transaction();
+        let (bob_id, _bob_keypair) = gen_account_in("wonderland");
+        let asset_definition_id = AssetDefinitionId::from_str("tulip#wonderland")?;
+        Register::account(Account::new(bob_id.clone()))
+            .execute(&SAMPLE_GENESIS_ACCOUNT_ID, &mut state_transaction)?;
+        Register::asset_definition(AssetDefinition::numeric(asset_definition_id.clone()))
+            .execute(&SAMPLE_GENESIS_ACCOUNT_ID, &mut state_transaction)?;
+        assert!(holders(&state_transaction.world, &asset_definition_id).is_empty());
+
+        let alice_asset_id = AssetId::new(asset_definition_id.clone(), ALICE_ID.clone());
+        Mint::asset_numeric(10_u32, alice_asset_id.clone())
+            .execute(&ALICE_ID, &mut state_transaction)?;
+        assert_eq!(
+            holders(&state_transaction.world, &asset_definition_id),
+            [ALICE_ID.clone()]
+        );
+
+        Transfer::asset_numeric(alice_asset_id, 10_u32, bob_id.clone())
+            .execute(&ALICE_ID, &mut state_transaction)?;
+        assert_eq!(
+            holders(&state_transaction.world, &asset_definition_id),
+            [bob_id.clone()]
+        );
+
+        let bob_asset_id = AssetId::new(asset_definition_id.clone(), bob_id.clone());
+        Burn::asset_numeric(10_u32, bob_asset_id).execute(&bob_id, &mut state_transaction)?;
+        assert!(holders(&state_transaction.world, &asset_definition_id).is_empty());
+        Ok(())
+    }
+
+    #[test]
+    async fn asset_definitions_by_name() -> Result<()> {
+        fn definitions(world: &impl WorldReadOnly, name: &Name) -> Vec<AssetDefinitionId> {
+            world
+                .asset_definitions_by_name_iter(name)
+                .cloned()
+                .collect()
+        }
+
+        let kura = Kura::blank_kura_for_testing();
+        let state = state_with_test_domains(&kura)?;
+        let mut state_block = state.block();
+        let mut state_transaction = state_block.transaction();
+        let name = Name::from_str("rose")?;
+        let garden_rose_id = AssetDefinitionId::from_str("rose#garden")?;
+        Register::domain(Domain::new(DomainId::from_str("garden")?))
+            .execute(&SAMPLE_GENESIS_ACCOUNT_ID, &mut state_transaction)?;
+        Register::asset_definition(AssetDefinition::numeric(garden_rose_id.clone()))
+            .execute(&SAMPLE_GENESIS_ACCOUNT_ID, &mut state_transaction)?;
+        Register::asset_definition(AssetDefinition::numeric(AssetDefinitionId::from_str(
+            "tulip#garden",
+        )?))
+        .execute(&SAMPLE_GENESIS_ACCOUNT_ID, &mut state_transaction)?;
+        assert_eq!(
+            definitions(&state_transaction.world, &name),
+            [
+                garden_rose_id,
+                AssetDefinitionId::from_str("rose#wonderland")?
+            ]
+        );
+
+        Unregister::domain(DomainId::from_str("garden")?)
+            .execute(&SAMPLE_GENESIS_ACCOUNT_ID, &mut state_transaction)?;
+        assert_eq!(
+            definitions(&state_transaction.world, &name),
+            [AssetDefinitionId::from_str("rose#wonderland")?]
+        );
+        Ok(())
+    }
+
+    #[test]
+    async fn account_effective_permissions() -> Result<()> {
+        fn permissions(world: &impl WorldReadOnly) -> Vec<Permission> {
+            world
+                .account_permissions_iter(&ALICE_ID)
+                .expect("Alice exists")
+                .cloned()
+                .collect()
+        }
+
+        let kura = Kura::blank_kura_for_testing();
+        let state = state_with_test_domains(&kura)?;
+        let mut state_block = state.block();
+        let mut state_transaction = state_block.transaction();
+        let can_do = Permission::new("CanDo".parse()?, serde_json::Value::Null);
+        let can_also_do = Permission::new("CanAlsoDo".parse()?, serde_json::Value::Null);
+        state_transaction
+            .world
+            .set_executor_data_model(ExecutorDataModel::new(
+                [can_do.id.clone(), can_also_do.id.clone()].into(),
+                None,
+                serde_json::Value::Null.into(),
+            ));
+        let role_id = RoleId::from_str("doer")?;
+        Register::role(Role::new(role_id.clone()).add_permission(can_do.clone()))
+            .execute(&SAMPLE_GENESIS_ACCOUNT_ID, &mut state_transaction)?;
+
+        Grant::permission(can_do.clone(), ALICE_ID.clone())
+            .execute(&SAMPLE_GENESIS_ACCOUNT_ID, &mut state_transaction)?;
+        Grant::role(role_id.clone(), ALICE_ID.clone())
+            .execute(&SAMPLE_GENESIS_ACCOUNT_ID, &mut state_transaction)?;
+        assert_eq!(permissions(&state_transaction.world), [can_do.clone()]);
+
+        // Still granted through the role
+        Revoke::permission(can_do.clone(), ALICE_ID.clone())
+            .execute(&SAMPLE_GENESIS_ACCOUNT_ID, &mut state_transaction)?;
+        assert_eq!(permissions(&state_transaction.world), [can_do.clone()]);
+
+        Grant::role_permission(can_also_do.clone(), role_id.clone())
+            .execute(&SAMPLE_GENESIS_ACCOUNT_ID, &mut state_transaction)?;
+        assert_eq!(
+            permissions(&state_transaction.world),
+            [can_also_do.clone(), can_do.clone()]
+        );
+
+        // Still granted inherently
+        Grant::permission(can_also_do.clone(), ALICE_ID.clone())
+            .execute(&SAMPLE_GENESIS_ACCOUNT_ID, &mut state_transaction)?;
+        Revoke::role_permission(can_also_do.clone(), role_id.clone())
+            .execute(&SAMPLE_GENESIS_ACCOUNT_ID, &mut state_transaction)?;
+        assert_eq!(
+            permissions(&state_transaction.world),
+            [can_also_do.clone(), can_do.clone()]
+        );
+
+        Revoke::permission(can_also_do, ALICE_ID.clone())
+            .execute(&SAMPLE_GENESIS_ACCOUNT_ID, &mut state_transaction)?;
+        assert_eq!(permissions(&state_transaction.world), [can_do]);
+        assert_eq!(
+            state_transaction
+                .world
+                .role_holders_iter(&role_id)
+                .collect::<Vec<_>>(),
+            [&*ALICE_ID]
+        );
+
+        Unregister::role(role_id.clone())
+            .execute(&SAMPLE_GENESIS_ACCOUNT_ID, &mut state_transaction)?;
+        assert!(permissions(&state_transaction.world).is_empty());
+        assert!(state_transaction
+            .world
+            .role_holders_iter(&role_id)
+            .next()
+            .is_none());
+        Ok(())
+    }
+
     #[test]
     async fn account_metadata() -> Result<()> {
         let kura = Kura::blank_kura_for_testing();
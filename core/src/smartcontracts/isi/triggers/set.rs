@@ -21,6 +21,7 @@ use iroha_data_model::{
 };
 use serde::{
     de::{DeserializeSeed, MapAccess, Visitor},
+    ser::SerializeStruct as _,
     Deserialize, Serialize,
 };
 use storage::{
@@ -39,7 +40,10 @@ use crate::{
         },
         wasm,
     },
-    state::deserialize::WasmSeed,
+    state::{
+        deserialize::WasmSeed,
+        serialize::{Entries, WasmByHash},
+    },
 };
 
 /// Error type for [`Set`] operations.
@@ -63,7 +67,7 @@ type WasmSmartContractMapView<'set> =
     StorageView<'set, HashOf<WasmSmartContract>, WasmSmartContractEntry>;
 
 /// Specialized structure that maps event filters to Triggers.
-// NB: `Set` has custom `Serialize` and `DeserializeSeed` implementations
+// NB: `Set` has custom `Serialize` and `DeserializeSeed` implementations, as does `SetView`,
 // which need to be manually updated when changing the struct
 #[derive(Default, Serialize)]
 pub struct Set {
@@ -265,6 +269,7 @@ impl<'de> DeserializeSeed<'de> for WasmSeed<'_, WasmSmartContractEntry> {
                 M: MapAccess<'de>,
             {
                 let mut original_contract = None;
+                let mut hash = None;
                 let mut count = None;
 
                 while let Some(key) = map.next_key::<String>()? {
@@ -272,6 +277,9 @@ impl<'de> DeserializeSeed<'de> for WasmSeed<'_, WasmSmartContractEntry> {
                         "original_contract" => {
                             original_contract = Some(map.next_value()?);
                         }
+                        "hash" => {
+                            hash = Some(map.next_value()?);
+                        }
                         "count" => {
                             count = Some(map.next_value()?);
                         }
@@ -279,10 +287,17 @@ impl<'de> DeserializeSeed<'de> for WasmSeed<'_, WasmSmartContractEntry> {
                     }
                 }
 
-                let original_contract = original_contract
-                    .ok_or_else(|| serde::de::Error::missing_field("original_contract"))?;
+                let original_contract = match (original_contract, hash) {
+                    (Some(original_contract), _) => original_contract,
+                    (None, Some(hash)) => self.loader.contract::<M::Error>(&hash)?,
+                    (None, None) => {
+                        return Err(serde::de::Error::missing_field("original_contract"))
+                    }
+                };
                 let count = count.ok_or_else(|| serde::de::Error::missing_field("count"))?;
-                let compiled_contract = wasm::load_module(self.loader.engine, &original_contract)
+                let compiled_contract = self
+                    .loader
+                    .load_module(&original_contract)
                     .map_err(serde::de::Error::custom)?;
 
                 Ok(WasmSmartContractEntry {
@@ -296,6 +311,58 @@ impl<'de> DeserializeSeed<'de> for WasmSeed<'_, WasmSmartContractEntry> {
         deserializer.deserialize_map(WasmSmartContractEntryVisitor { loader: self })
     }
 }
+
+impl SetView<'_> {
+    fn serialize_with_contracts<S: serde::Serializer>(
+        &self,
+        serializer: S,
+        contracts: &impl Serialize,
+    ) -> Result<S::Ok, S::Error> {
+        let mut set = serializer.serialize_struct("Set", 7)?;
+        set.serialize_field("data_triggers", &Entries::new(&self.data_triggers))?;
+        set.serialize_field("pipeline_triggers", &Entries::new(&self.pipeline_triggers))?;
+        set.serialize_field("time_triggers", &Entries::new(&self.time_triggers))?;
+        set.serialize_field("by_call_triggers", &Entries::new(&self.by_call_triggers))?;
+        set.serialize_field("ids", &Entries::new(&self.ids))?;
+        set.serialize_field("contracts", contracts)?;
+        set.serialize_field("matched_ids", &*self.matched_ids)?;
+        set.end()
+    }
+}
+
+/// Serialized in the same format as [`Set`], so that a snapshot is made of a single view
+impl Serialize for SetView<'_> {
+    fn serialize<S: serde::Serializer>(&self, serializer: S) -> Result<S::Ok, S::Error> {
+        self.serialize_with_contracts(serializer, &Entries::new(&self.contracts))
+    }
+}
+
+/// Serialized in the same format as [`Set`], except that contracts are left out of their entries
+impl Serialize for WasmByHash<'_, SetView<'_>> {
+    fn serialize<S: serde::Serializer>(&self, serializer: S) -> Result<S::Ok, S::Error> {
+        /// [`WasmSmartContractEntry`] referring to its contract by hash
+        #[derive(Serialize)]
+        struct EntryByHash<'e> {
+            hash: &'e HashOf<WasmSmartContract>,
+            count: NonZeroU64,
+        }
+
+        struct Contracts<'v, 'set>(&'v WasmSmartContractMapView<'set>);
+
+        impl Serialize for Contracts<'_, '_> {
+            fn serialize<S: serde::Serializer>(&self, serializer: S) -> Result<S::Ok, S::Error> {
+                serializer.collect_map(self.0.iter().map(|(hash, entry)| {
+                    let count = entry.count;
+                    (hash, EntryByHash { hash, count })
+                }))
+            }
+        }
+
+        self.0
+            .serialize_with_contracts(serializer, &Contracts(&self.0.contracts))
+    }
+}
+
 /// Trait to perform read-only operations on [`WorldBlock`], [`WorldTransaction`] and [`WorldView`]
 #[allow(missing_docs)]
 pub trait SetReadOnly {
@@ -697,6 +764,56 @@ impl<'block, 'set> SetTransaction<'block, 'set> {
         })
     }
 
+    /// Add trigger with any filter
+    ///
+    /// Returns `false` if a trigger with given id already exists
+    ///
+    /// # Errors
+    ///
+    /// Return [`Err`] if failed to preload wasm trigger
+    pub fn add_trigger(&mut self, engine: &wasmtime::Engine, trigger: Trigger) -> Result<bool> {
+        let Trigger {
+            id,
+            action:
+                Action {
+                    executable,
+                    repeats,
+                    authority,
+                    filter,
+                    metadata,
+                },
+        } = trigger;
+        macro_rules! specialized {
+            ($filter:ident) => {
+                SpecializedTrigger::new(
+                    id,
+                    SpecializedAction {
+                        executable,
+                        repeats,
+                        authority,
+                        filter: $filter,
+                        metadata,
+                    },
+                )
+            };
+        }
+
+        match filter {
+            TriggeringEventFilterBox::Data(filter) => {
+                self.add_data_trigger(engine, specialized!(filter))
+            }
+            TriggeringEventFilterBox::Pipeline(filter) => {
+                self.add_pipeline_trigger(engine, specialized!(filter))
+            }
+            TriggeringEventFilterBox::Time(filter) => {
+                self.add_time_trigger(engine, specialized!(filter))
+            }
+            TriggeringEventFilterBox::ExecuteTrigger(filter) => {
+                self.add_by_call_trigger(engine, specialized!(filter))
+            }
+        }
+    }
+
     /// Add generic trigger to generic collection
     ///
     /// Returns `false` if a trigger with given id already exists
@@ -836,6 +953,11 @@ impl<'block, 'set> SetTransaction<'block, 'set> {
         true
     }
 
+    /// Replace triggers matched by events which are yet to be executed
+    pub fn replace_matched_ids(&mut self, matched_ids: Vec<(EventBox, TriggerId)>) {
+        *self.matched_ids = matched_ids;
+    }
+
     /// Modify repetitions of the hook identified by [`Id`].
     ///
     /// # Errors
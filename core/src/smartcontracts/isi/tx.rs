@@ -46,20 +46,19 @@ impl BlockTransactionRef {
         self.0.hash()
     }
 
-    fn authority(&self) -> &AccountId {
+    fn transaction(&self) -> &CommittedTransaction {
         self.0
             .transactions()
             .nth(self.1)
             .expect("The transaction is not found")
-            .as_ref()
-            .authority()
     }
+
+    fn authority(&self) -> &AccountId {
+        self.transaction().as_ref().authority()
+    }
+
     fn value(&self) -> CommittedTransaction {
-        self.0
-            .transactions()
-            .nth(self.1)
-            .expect("The transaction is not found")
-            .clone()
+        self.transaction().clone()
     }
 }
 
@@ -88,11 +87,17 @@ impl ValidQuery for FindTransactionsByAccountId {
         state_ro: &'state impl StateReadOnly,
     ) -> Result<Box<dyn Iterator<Item = TransactionQueryOutput> + 'state>, QueryExecutionFail> {
         let account_id = self.account_id.clone();
+        let height = state_ro.height();
+        let kura = state_ro.kura();
 
+        // Only blocks with transactions of the account are loaded
         Ok(Box::new(
-            state_ro
-                .all_blocks()
-                .flat_map(BlockTransactionIter::new)
+            kura.get_account_transactions(&self.account_id)
+                .take_while(move |location| location.block_height <= height)
+                .filter_map(move |location| {
+                    let block = kura.get_block_by_height(location.block_height)?;
+                    Some(BlockTransactionRef(block, location.index))
+                })
                 .filter(move |tx| *tx.authority() == account_id)
                 .map(|tx| TransactionQueryOutput {
                     block_hash: tx.block_hash(),
@@ -114,20 +119,14 @@ impl ValidQuery for FindTransactionByHash {
         if !state_ro.has_transaction(tx_hash) {
             return Err(FindError::Transaction(tx_hash).into());
         };
-        let block = state_ro
-            .block_with_tx(&tx_hash)
+        let (block, position) = state_ro
+            .block_with_tx_position(&tx_hash)
             .ok_or_else(|| FindError::Transaction(tx_hash))?;
 
-        let block_hash = block.hash();
-
-        let mut transactions = block.transactions();
-        transactions
-            .find(|transaction| transaction.value.hash() == tx_hash)
-            .cloned()
-            .map(|transaction| TransactionQueryOutput {
-                block_hash,
-                transaction,
-            })
-            .ok_or_else(|| FindError::Transaction(tx_hash).into())
+        let tx = BlockTransactionRef(block, position);
+        Ok(TransactionQueryOutput {
+            block_hash: tx.block_hash(),
+            transaction: tx.value(),
+        })
     }
 }
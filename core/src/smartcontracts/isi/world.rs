@@ -141,13 +141,23 @@ pub mod isi {
                         .expect("should succeed")
                 });
 
-            if state_transaction
-                .world
-                .domains
-                .remove(domain_id.clone())
-                .is_none()
-            {
+            let Some(domain) = state_transaction.world.domains.remove(domain_id.clone()) else {
                 return Err(FindError::Domain(domain_id).into());
+            };
+            for asset_definition_id in domain.asset_definitions.into_keys() {
+                state_transaction
+                    .world
+                    .asset_definitions_by_name
+                    .remove(asset_definition_id.into());
+            }
+
+            let accounts_in_domain = state_transaction
+                .world
+                .accounts_in_domain_iter(&domain_id)
+                .map(|account| account.id().clone())
+                .collect::<Vec<_>>();
+            for account_id in accounts_in_domain {
+                state_transaction.world.remove_account(&account_id)?;
             }
 
             state_transaction
@@ -207,11 +217,7 @@ pub mod isi {
 
             let accounts_with_role = state_transaction
                 .world
-                .account_roles
-                .iter()
-                .map(|(role, ())| role)
-                .filter(|role| role.role_id.eq(&role_id))
-                .map(|role| &role.account_id)
+                .role_holders_iter(&role_id)
                 .cloned()
                 .collect::<Vec<_>>();
 
@@ -265,6 +271,9 @@ pub mod isi {
                 }
                 .into());
             }
+            state_transaction
+                .world
+                .add_role_permission_to_holders(&role_id, &permission);
 
             state_transaction
                 .world
@@ -295,6 +304,9 @@ pub mod isi {
             if !role.permissions.remove(&permission) {
                 return Err(FindError::Permission(permission_id).into());
             }
+            state_transaction
+                .world
+                .remove_role_permission_from_holders(&role_id, &permission);
 
             state_transaction
                 .world
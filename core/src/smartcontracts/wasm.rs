@@ -2,11 +2,16 @@
 //! `WebAssembly` VM Smartcontracts can be written in Rust, compiled
 //! to wasm format and submitted in a transaction
 
-use std::borrow::Borrow;
+use std::{
+    borrow::Borrow,
+    collections::BTreeMap,
+    sync::atomic::{AtomicUsize, Ordering},
+};
 
 use error::*;
 use import::traits::{ExecuteOperations as _, GetExecutorPayloads as _, SetDataModel as _};
 use iroha_config::parameters::actual::WasmRuntime as Config;
+use iroha_crypto::HashOf;
 use iroha_data_model::{
     account::AccountId,
     executor::{self, ExecutorDataModel, MigrationResult},
@@ -255,6 +260,50 @@ pub fn load_module(engine: &Engine, bytes: impl AsRef<[u8]>) -> Result<wasmtime:
     Module::new(engine, bytes).map_err(Error::ModuleLoading)
 }
 
+/// Modules compiled ahead of time, keyed by hashes of their contracts
+pub type CompiledModules = BTreeMap<HashOf<WasmSmartContract>, Module>;
+
+/// Contracts referred to by their hashes
+pub type ContractsByHash = BTreeMap<HashOf<WasmSmartContract>, WasmSmartContract>;
+
+/// Compile `contracts` on all available cores.
+///
+/// Contracts which fail to compile are left out, so that the error
+/// is reported when they are compiled again with [`load_module`].
+pub fn load_modules(engine: &Engine, contracts: &[WasmSmartContract]) -> CompiledModules {
+    if contracts.is_empty() {
+        return CompiledModules::new();
+    }
+
+    let worker_count = std::thread::available_parallelism()
+        .map_or(1, std::num::NonZeroUsize::get)
+        .min(contracts.len());
+    let next_contract = AtomicUsize::new(0);
+
+    std::thread::scope(|scope| {
+        let workers: Vec<_> = (0..worker_count)
+            .map(|_| {
+                scope.spawn(|| {
+                    let mut compiled = Vec::new();
+                    while let Some(contract) =
+                        contracts.get(next_contract.fetch_add(1, Ordering::Relaxed))
+                    {
+                        if let Ok(module) = load_module(engine, contract) {
+                            compiled.push((HashOf::new(contract), module));
+                        }
+                    }
+                    compiled
+                })
+            })
+            .collect();
+
+        workers
+            .into_iter()
+            .flat_map(|worker| worker.join().expect("Module compilation panicked"))
+            .collect()
+    })
+}
+
 /// Create [`Engine`] with a predefined configuration.
 ///
 /// # Panics
@@ -627,15 +676,6 @@ impl<S> Runtime<S> {
             .map_err(|_error| ExportError::wrong_signature::<P, R>(func_name))
     }
 
-    fn create_smart_contract(
-        &self,
-        store: &mut Store<S>,
-        bytes: impl AsRef<[u8]>,
-    ) -> Result<wasmtime::Instance> {
-        let module = load_module(&self.engine, bytes)?;
-        self.instantiate_module(&module, store).map_err(Into::into)
-    }
-
     fn instantiate_module(
         &self,
         module: &wasmtime::Module,
@@ -884,7 +924,8 @@ impl<'wrld, 'block: 'wrld, 'state: 'block> Runtime<state::SmartContract<'wrld, '
             state::specific::SmartContract::new(None),
         );
 
-        self.execute_smart_contract_with_state(bytes, state)
+        let module = load_module(&self.engine, bytes)?;
+        self.execute_smart_contract_with_state(&module, state)
     }
 
     /// Validates that the given smartcontract is eligible for execution
@@ -900,6 +941,22 @@ impl<'wrld, 'block: 'wrld, 'state: 'block> Runtime<state::SmartContract<'wrld, '
         authority: AccountId,
         bytes: impl AsRef<[u8]>,
         max_instruction_count: u64,
+    ) -> Result<()> {
+        let module = load_module(&self.engine, bytes)?;
+        self.validate_module(state_transaction, authority, &module, max_instruction_count)
+    }
+
+    /// Same as [`Self::validate`] for a smartcontract already compiled with the engine of this runtime
+    ///
+    /// # Errors
+    ///
+    /// See [`Self::validate`]
+    pub fn validate_module(
+        &mut self,
+        state_transaction: &'wrld mut StateTransaction<'block, 'state>,
+        authority: AccountId,
+        module: &wasmtime::Module,
+        max_instruction_count: u64,
     ) -> Result<()> {
         let span = wasm_log_span!("Smart contract validation", %authority);
         let state = state::SmartContract::new(
@@ -910,16 +967,16 @@ impl<'wrld, 'block: 'wrld, 'state: 'block> Runtime<state::SmartContract<'wrld, '
             state::specific::SmartContract::new(Some(LimitsExecutor::new(max_instruction_count))),
         );
 
-        self.execute_smart_contract_with_state(bytes, state)
+        self.execute_smart_contract_with_state(module, state)
     }
 
     fn execute_smart_contract_with_state(
         &mut self,
-        bytes: impl AsRef<[u8]>,
+        module: &wasmtime::Module,
         state: state::SmartContract<'wrld, 'block, 'state>,
     ) -> Result<()> {
         let mut store = self.create_store(state);
-        let smart_contract = self.create_smart_contract(&mut store, bytes)?;
+        let smart_contract = self.instantiate_module(module, &mut store)?;
 
         let main_fn =
             Self::get_typed_func(&smart_contract, &mut store, import::SMART_CONTRACT_MAIN)?;
@@ -1719,10 +1776,9 @@ mod tests {
     fn world_with_test_account(authority: &AccountId) -> World {
         let domain_id = authority.domain_id.clone();
         let account = Account::new(authority.clone()).build(authority);
-        let mut domain = Domain::new(domain_id).build(authority);
-        assert!(domain.add_account(account).is_none());
+        let domain = Domain::new(domain_id).build(authority);
 
-        World::with([domain], PeersIds::new())
+        World::with([domain], [account], PeersIds::new())
     }
 
     fn memory_and_alloc(isi_hex: &str) -> String {
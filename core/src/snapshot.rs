@@ -1,32 +1,112 @@
 //! This module contains [`State`] snapshot actor service.
+//!
+//! Snapshot file starts with a fixed-size [header](SnapshotHeader) followed by the [`State`]
+//! encoded as CBOR. The header carries the height and the latest block hash of the state, as
+//! well as the length and checksum of the contents, so that a snapshot which doesn't match
+//! the block store or got corrupted is rejected before it is decoded. Contents are split into
+//! [sections](Sections) compressed with zstd one by one, which are decoded concurrently when
+//! the snapshot is read, while WASM modules of triggers and the executor are compiled on all
+//! available cores. Snapshots compressed as a whole, with uncompressed contents or in the
+//! JSON format used before are still read.
+//!
+//! Snapshots are written by a dedicated thread of low priority. The state is encoded from
+//! a single view and compressed straight into the file, which is written at a limited rate and
+//! verified before it replaces the previous snapshot.
+//!
+//! Between full snapshots, up to a configured number of delta snapshots is written. A delta
+//! holds the entries changed since the previous snapshot, as recorded by the
+//! [`ChangeLog`](crate::state_root::ChangeLog) of the state root, and is applied on top of
+//! the full snapshot and the deltas preceding it when the state is read.
 use std::{
-    io::Read,
+    collections::{BTreeMap, BTreeSet},
+    io::{Seek, SeekFrom, Write},
+    marker::PhantomData,
+    panic::AssertUnwindSafe,
     path::{Path, PathBuf},
     sync::Arc,
-    time::Duration,
+    time::{Duration, Instant},
 };
 
-use iroha_config::{base::WithOrigin, parameters::actual::Snapshot as Config, snapshot::Mode};
-use iroha_crypto::HashOf;
-use iroha_data_model::block::SignedBlock;
+use iroha_config::{
+    base::{util::HumanBytes, WithOrigin},
+    parameters::actual::{ChainWide, Snapshot as Config},
+    snapshot::Mode,
+};
+use iroha_crypto::{Hash, HashOf};
+use iroha_data_model::{
+    block::SignedBlock, executor::ExecutorDataModel, permission::Permissions, prelude::*,
+    role::RoleId,
+};
 use iroha_logger::prelude::*;
-use serde::{de::DeserializeSeed, Serialize};
-use tokio::sync::mpsc;
+use memmap2::Mmap;
+use serde::{
+    de::{DeserializeOwned, DeserializeSeed},
+    Deserialize, Serialize,
+};
+use storage::{serde::CellSeeded, storage::StorageReadOnly};
+use tokio::sync::{mpsc, oneshot};
 
 use crate::{
+    asset::{AccountIdWithAssetDefinition, AssetDefinitionIdWithHolder},
+    executor::Executor,
     kura::{BlockCount, Kura},
     query::store::LiveQueryStoreHandle,
-    state::{deserialize::KuraSeed, State, StateReadOnly},
+    role::{RoleIdWithHolder, RoleIdWithOwner},
+    smartcontracts::{
+        triggers::{
+            set::{Error as TriggerSetError, Set as TriggerSet, SetReadOnly as _},
+            specialized::LoadedActionTrait as _,
+        },
+        wasm,
+    },
+    state::{
+        deserialize::{KuraSeed, WasmSeed},
+        serialize::{Entries, WasmByHash},
+        State, StateReadOnly, StateView, World, WorldReadOnly,
+    },
+    state_root::{Changes, StateLeaf, StateRoot},
+    Parameters, PeersIds,
 };
 
 /// Name of the [`State`] snapshot file.
-const SNAPSHOT_FILE_NAME: &str = "snapshot.data";
+pub const SNAPSHOT_FILE_NAME: &str = "snapshot.data";
 /// Name of the temporary [`State`] snapshot file.
 const SNAPSHOT_TMP_FILE_NAME: &str = "snapshot.tmp";
+/// Name of the file sections of a full snapshot are encoded into before they are written.
+const SNAPSHOT_SPILL_FILE_NAME: &str = "snapshot.spill";
+/// Prefix of the names of delta snapshot files, followed by the index of the delta.
+const SNAPSHOT_DELTA_FILE_PREFIX: &str = "snapshot.delta.";
+/// Bytes at the start of a binary snapshot file, files without them are read as JSON.
+const SNAPSHOT_MAGIC: [u8; 8] = *b"IROHASNP";
+/// Bytes at the start of a delta snapshot file.
+const DELTA_MAGIC: [u8; 8] = *b"IROHADLT";
+/// Version of the binary snapshot format, contents of which are split into compressed sections.
+const SNAPSHOT_VERSION: u32 = 3;
+/// Version of the binary snapshot format with contents compressed as a whole, used by deltas.
+const COMPRESSED_SNAPSHOT_VERSION: u32 = 2;
+/// Version of the binary snapshot format with uncompressed contents, which is still read.
+const UNCOMPRESSED_SNAPSHOT_VERSION: u32 = 1;
+/// Size of the chunks in which snapshots are written to disk.
+const WRITE_CHUNK_SIZE: usize = 1024 * 1024;
+/// Niceness of the snapshot writer thread.
+#[cfg(target_os = "linux")]
+const WRITER_NICENESS: i32 = 10;
+/// Size of the scratch buffer used to decode strings and bytes of the snapshot.
+const READ_SCRATCH_SIZE: usize = 4096;
 
 // /// Errors produced by [`SnapshotMaker`] actor.
 // pub type Result<T, E = Error> = core::result::Result<T, E>;
 
+/// Relevant snapshot metrics
+pub struct SnapshotMetrics {
+    /// Time spent writing a snapshot
+    pub duration: iroha_telemetry::metrics::SnapshotDurationHistogram,
+    /// Size of the latest snapshot before and after compression
+    pub bytes: iroha_telemetry::metrics::SnapshotBytesGauge,
+    /// Compression ratio of the latest snapshot
+    pub compression_ratio: iroha_telemetry::metrics::SnapshotCompressionRatioGauge,
+}
+
 /// [`SnapshotMaker`] actor handle.
 #[derive(Clone)]
 pub struct SnapshotMakerHandle {
@@ -43,13 +123,32 @@ pub struct SnapshotMaker {
     store_dir: WithOrigin<PathBuf>,
     /// Hash of the latest block stored in the state
     latest_block_hash: Option<HashOf<SignedBlock>>,
+    /// Number of delta snapshots written between full snapshots
+    delta_count: u32,
+    /// Snapshots written since the latest full snapshot, [`None`] if the next one must be full
+    delta_chain: Option<DeltaChain>,
+    /// Maximum number of bytes written to disk per second
+    max_write_rate: Option<u64>,
+    metrics: SnapshotMetrics,
 }
 
 impl SnapshotMaker {
     /// Start [`Self`] actor.
     pub fn start(self) -> SnapshotMakerHandle {
         let (message_sender, message_receiver) = mpsc::channel(1);
-        tokio::task::spawn(self.run(message_receiver));
+        let (request_sender, request_receiver) = std::sync::mpsc::channel();
+        let writer = SnapshotWriter {
+            state: Arc::clone(&self.state),
+            store_dir: self.store_dir.clone(),
+            delta_count: self.delta_count,
+            max_write_rate: self.max_write_rate,
+        };
+        // Thread exits once the actor drops the sender of requests
+        std::thread::Builder::new()
+            .name("snapshot_writer".to_owned())
+            .spawn(move || writer.run(request_receiver))
+            .expect("Failed to spawn snapshot writer thread");
+        tokio::task::spawn(self.run(request_sender, message_receiver));
 
         SnapshotMakerHandle {
             _message_sender: message_sender,
@@ -57,7 +156,11 @@ impl SnapshotMaker {
     }
 
     /// [`Self`] task.
-    async fn run(mut self, mut message_receiver: mpsc::Receiver<()>) {
+    async fn run(
+        mut self,
+        request_sender: std::sync::mpsc::Sender<WriteRequest>,
+        mut message_receiver: mpsc::Receiver<()>,
+    ) {
         let mut snapshot_create_every = tokio::time::interval(self.create_every);
         // Don't try to create snapshot more frequently if previous take longer time
         snapshot_create_every.set_missed_tick_behavior(tokio::time::MissedTickBehavior::Delay);
@@ -65,12 +168,12 @@ impl SnapshotMaker {
         loop {
             tokio::select! {
                 _ = snapshot_create_every.tick() => {
-                    // Offload snapshot creation into blocking thread
-                    self.create_snapshot().await;
+                    // Offload snapshot creation into the writer thread
+                    self.create_snapshot(&request_sender).await;
                 },
                 _ = message_receiver.recv() => {
                     info!("All handler to SnapshotMaker are dropped. Saving latest snapshot and shutting down...");
-                    self.create_snapshot().await;
+                    self.create_snapshot(&request_sender).await;
                     break;
                 }
             }
@@ -79,49 +182,83 @@ impl SnapshotMaker {
     }
 
     /// Invoke snapshot creation task
-    async fn create_snapshot(&mut self) {
-        let store_dir = self.store_dir.clone();
-        let latest_block_hash;
-        let at_height;
-        {
-            let state_view = self.state.view();
-            latest_block_hash = state_view.latest_block_hash();
-            at_height = state_view.height();
-        }
+    async fn create_snapshot(&mut self, request_sender: &std::sync::mpsc::Sender<WriteRequest>) {
+        let latest_block_hash = self.state.view().latest_block_hash();
 
         if latest_block_hash != self.latest_block_hash {
-            let state = self.state.clone();
-            let handle = tokio::task::spawn_blocking(move || -> Result<(), TryWriteError> {
-                // TODO: enhance error by attaching `store_dir` parameter origin
-                try_write_snapshot(&state, store_dir.value())
-            });
+            let (reply_sender, reply_receiver) = oneshot::channel();
+            let request = WriteRequest {
+                delta_chain: self.delta_chain.take(),
+                reply: reply_sender,
+            };
+            if request_sender.send(request).is_err() {
+                iroha_logger::error!("Snapshot writer thread is gone, snapshot isn't created");
+                return;
+            }
 
-            match handle.await {
-                Ok(Ok(())) => {
-                    iroha_logger::info!(at_height, "Successfully created a snapshot of state");
+            match reply_receiver.await {
+                Ok(Ok(Ok(report))) => {
+                    iroha_logger::info!(
+                        at_height = report.delta_chain.height,
+                        deltas = report.delta_chain.len,
+                        bytes = report.size.compressed,
+                        duration = ?report.duration,
+                        "Successfully created a snapshot of state"
+                    );
+                    self.record_metrics(&report);
                     self.latest_block_hash = latest_block_hash;
+                    self.delta_chain = Some(report.delta_chain);
                 }
-                Ok(Err(error)) => {
+                Ok(Ok(Err(error))) => {
                     iroha_logger::error!(%error, "Failed to create a snapshot of state");
                 }
-                Err(panic) => {
-                    iroha_logger::error!(%panic, "Task panicked during creation of state snapshot");
+                Ok(Err(_)) | Err(_) => {
+                    iroha_logger::error!(
+                        "Snapshot writer panicked during creation of state snapshot"
+                    );
                 }
             }
         }
     }
 
+    #[allow(clippy::cast_precision_loss)]
+    fn record_metrics(&self, report: &WriteReport) {
+        self.metrics.duration.observe(report.duration.as_secs_f64());
+        self.metrics
+            .bytes
+            .with_label_values(&["raw"])
+            .set(report.size.raw);
+        self.metrics
+            .bytes
+            .with_label_values(&["compressed"])
+            .set(report.size.compressed);
+        self.metrics
+            .compression_ratio
+            .set(report.size.raw as f64 / report.size.compressed as f64);
+    }
+
     /// Create from [`Config`].
     ///
     /// Might return [`None`] if the configuration is not suitable for _making_ snapshots.
-    pub fn from_config(config: &Config, state: Arc<State>) -> Option<Self> {
+    pub fn from_config(
+        config: &Config,
+        state: Arc<State>,
+        metrics: SnapshotMetrics,
+    ) -> Option<Self> {
         if let Mode::ReadWrite = config.mode {
             let latest_block_hash = state.view().latest_block_hash();
+            if config.delta_count > 0 {
+                state.state_root.change_log().enable();
+            }
             Some(Self {
                 state,
                 create_every: config.create_every.get(),
                 store_dir: config.store_dir.clone(),
                 latest_block_hash,
+                delta_count: config.delta_count,
+                delta_chain: None,
+                max_write_rate: config.max_write_rate.map(HumanBytes::get),
+                metrics,
             })
         } else {
             None
@@ -129,7 +266,90 @@ impl SnapshotMaker {
     }
 }
 
-/// Try to deserialize [`State`] from a snapshot file.
+/// Request to write a snapshot sent to the [`SnapshotWriter`]
+struct WriteRequest {
+    /// Snapshots written since the latest full snapshot
+    delta_chain: Option<DeltaChain>,
+    /// Outcome of the request, [`Err`] of the outer result if the writer panicked
+    reply: oneshot::Sender<std::thread::Result<Result<WriteReport, TryWriteError>>>,
+}
+
+/// Outcome of a written snapshot
+struct WriteReport {
+    /// Snapshots written since the latest full snapshot, this one included
+    delta_chain: DeltaChain,
+    size: SnapshotSize,
+    /// Time spent encoding and writing the snapshot
+    duration: Duration,
+}
+
+/// Writer of snapshots running on a dedicated thread of low priority,
+/// so that snapshots don't compete with consensus for CPU
+struct SnapshotWriter {
+    state: Arc<State>,
+    store_dir: WithOrigin<PathBuf>,
+    delta_count: u32,
+    max_write_rate: Option<u64>,
+}
+
+impl SnapshotWriter {
+    fn run(self, requests: std::sync::mpsc::Receiver<WriteRequest>) {
+        lower_thread_priority();
+
+        for WriteRequest { delta_chain, reply } in requests {
+            let outcome = std::panic::catch_unwind(AssertUnwindSafe(|| self.write(delta_chain)));
+            // Actor might have stopped waiting for the outcome
+            let _ = reply.send(outcome);
+        }
+    }
+
+    fn write(&self, delta_chain: Option<DeltaChain>) -> Result<WriteReport, TryWriteError> {
+        let started = Instant::now();
+        // TODO: enhance error by attaching `store_dir` parameter origin
+        let (delta_chain, size) = try_write_snapshot_or_delta(
+            &self.state,
+            self.store_dir.value(),
+            delta_chain,
+            self.delta_count,
+            self.max_write_rate,
+        )?;
+        // Deltas are restored by replaying blocks on top of the full snapshot when they can't
+        // be read, and the previous full snapshot stays in use until the next one is renamed
+        // over it, so only blocks below the durably written full snapshot are not needed
+        self.state
+            .view()
+            .kura()
+            .prune_blocks_below(delta_chain.full_height);
+
+        Ok(WriteReport {
+            delta_chain,
+            size,
+            duration: started.elapsed(),
+        })
+    }
+}
+
+/// Lower scheduling priority of the calling thread
+fn lower_thread_priority() {
+    #[cfg(target_os = "linux")]
+    {
+        // Niceness is a per-thread attribute on Linux, inherited by the compression workers
+        // SAFETY: changes scheduling priority of the calling thread only
+        #[allow(unsafe_code)]
+        let result = unsafe { libc::setpriority(libc::PRIO_PROCESS, 0, WRITER_NICENESS) };
+        if result != 0 {
+            warn!(
+                error = %std::io::Error::last_os_error(),
+                "Failed to lower priority of the snapshot writer thread"
+            );
+        }
+    }
+}
+
+/// Try to deserialize [`State`] from a snapshot file and the delta snapshots written after it.
+///
+/// Delta snapshots are applied until one is missing or fails to be read or applied, in which
+/// case the blocks it covers are expected to be replayed from [`Kura`].
 ///
 /// # Errors
 /// - IO errors
@@ -140,74 +360,1123 @@ pub fn try_read_snapshot(
     query_handle: LiveQueryStoreHandle,
     BlockCount(block_count): BlockCount,
 ) -> Result<State, TryReadError> {
-    let mut bytes = Vec::new();
     let path = store_dir.as_ref().join(SNAPSHOT_FILE_NAME);
-    let mut file = match std::fs::OpenOptions::new().read(true).open(&path) {
-        Ok(file) => file,
-        Err(err) => {
-            return if err.kind() == std::io::ErrorKind::NotFound {
-                Err(TryReadError::NotFound)
-            } else {
-                Err(TryReadError::IO(err, path.clone()))
-            }
-        }
-    };
-    file.read_to_end(&mut bytes)
-        .map_err(|err| TryReadError::IO(err, path.clone()))?;
-    let mut deserializer = serde_json::Deserializer::from_slice(&bytes);
+    let bytes = map_file(&path)?.ok_or(TryReadError::NotFound)?;
     let seed = KuraSeed {
         kura: Arc::clone(kura),
         query_handle,
     };
-    let state = seed.deserialize(&mut deserializer)?;
-    let state_view = state.view();
-    let snapshot_height = state_view.block_hashes.len();
-    if snapshot_height > block_count {
-        return Err(TryReadError::MismatchedHeight {
-            snapshot_height,
-            kura_height: block_count,
-        });
-    }
-    for height in 1..snapshot_height {
-        let kura_block_hash = kura
-            .get_block_hash(height as u64)
-            .expect("Kura has height at least as large as state height");
-        let snapshot_block_hash = state_view.block_hashes[height - 1];
-        if kura_block_hash != snapshot_block_hash {
-            return Err(TryReadError::MismatchedHash {
-                height,
-                snapshot_block_hash,
-                kura_block_hash,
+    let mut state = if let Some(header) = SnapshotHeader::decode(&bytes, SNAPSHOT_MAGIC)? {
+        header.check(kura, block_count)?;
+        let contents = checked_contents(&header, &bytes)?;
+        if header.version == SNAPSHOT_VERSION {
+            decode_sections(contents, seed)?
+        } else {
+            decode_contents(&header, contents, seed)?
+        }
+    } else {
+        warn!("Snapshot is stored in the legacy JSON format");
+        let mut deserializer = serde_json::Deserializer::from_slice(&bytes);
+        seed.deserialize(&mut deserializer)?
+    };
+    {
+        let state_view = state.view();
+        let snapshot_height = state_view.block_hashes.len();
+        if snapshot_height > block_count {
+            return Err(TryReadError::MismatchedHeight {
+                snapshot_height,
+                kura_height: block_count,
             });
         }
+        for height in 1..snapshot_height {
+            let kura_block_hash = kura
+                .get_block_hash(height as u64)
+                .expect("Kura has height at least as large as state height");
+            let snapshot_block_hash = state_view.block_hashes[height - 1];
+            if kura_block_hash != snapshot_block_hash {
+                return Err(TryReadError::MismatchedHash {
+                    height,
+                    snapshot_block_hash,
+                    kura_block_hash,
+                });
+            }
+        }
+    }
+
+    let mut applied_deltas = 0;
+    for index in 1.. {
+        let delta = match try_read_delta(store_dir.as_ref(), index, kura, block_count, &state) {
+            Ok(Some(delta)) => delta,
+            Ok(None) => break,
+            Err(error) => {
+                warn!(%error, index, "Failed to read delta snapshot");
+                break;
+            }
+        };
+        if let Err(error) = apply_delta(&mut state, delta) {
+            warn!(%error, index, "Failed to apply delta snapshot");
+            break;
+        }
+        applied_deltas = index;
+    }
+    if applied_deltas > 0 {
+        // Deltas don't carry the commitment, so it is rebuilt from the resulting world
+        state.state_root = StateRoot::from_world(&state.world);
     }
     Ok(state)
 }
 
+/// Try to read the delta snapshot with the given `index`, [`None`] if it doesn't exist.
+fn try_read_delta(
+    store_dir: &Path,
+    index: u32,
+    kura: &Kura,
+    block_count: usize,
+    state: &State,
+) -> Result<Option<DeltaEntries>, TryReadError> {
+    let Some(bytes) = map_file(&delta_path(store_dir, index))? else {
+        return Ok(None);
+    };
+    let header =
+        SnapshotHeader::decode(&bytes, DELTA_MAGIC)?.ok_or(TryReadError::MalformedDelta)?;
+    header.check(kura, block_count)?;
+    let delta: DeltaEntries =
+        decode_contents(&header, checked_contents(&header, &bytes)?, PhantomData)?;
+
+    let state_height = state.view().height();
+    if delta.from_height > state_height {
+        return Err(TryReadError::DetachedDelta {
+            from_height: delta.from_height,
+            state_height,
+        });
+    }
+    Ok(Some(delta))
+}
+
+/// Map the file at `path` into memory, [`None`] if it doesn't exist.
+fn map_file(path: &Path) -> Result<Option<Mmap>, TryReadError> {
+    let file = match std::fs::OpenOptions::new().read(true).open(path) {
+        Ok(file) => file,
+        Err(err) if err.kind() == std::io::ErrorKind::NotFound => return Ok(None),
+        Err(err) => return Err(TryReadError::IO(err, path.to_path_buf())),
+    };
+    // SAFETY: snapshot files are only ever replaced by renaming a new file over them,
+    // they are never modified in place.
+    #[allow(unsafe_code)]
+    let bytes =
+        unsafe { Mmap::map(&file) }.map_err(|err| TryReadError::IO(err, path.to_path_buf()))?;
+    Ok(Some(bytes))
+}
+
+/// Take the contents following the `header` in `bytes`, verified against it
+fn checked_contents<'b>(
+    header: &SnapshotHeader,
+    bytes: &'b [u8],
+) -> Result<&'b [u8], TryReadError> {
+    let contents = &bytes[SnapshotHeader::SIZE..];
+    if contents.len() as u64 != header.len || crc32fast::hash(contents) != header.checksum {
+        return Err(TryReadError::MismatchedChecksum);
+    }
+    Ok(contents)
+}
+
+/// Decode `contents` which aren't split into sections with `seed`
+fn decode_contents<'de, S: DeserializeSeed<'de>>(
+    header: &SnapshotHeader,
+    contents: &[u8],
+    seed: S,
+) -> Result<S::Value, TryReadError> {
+    match header.version {
+        UNCOMPRESSED_SNAPSHOT_VERSION => {
+            let mut scratch = [0; READ_SCRATCH_SIZE];
+            let mut deserializer =
+                ciborium::de::Deserializer::from_reader_with_buffer(contents, &mut scratch);
+            Ok(seed.deserialize(&mut deserializer)?)
+        }
+        COMPRESSED_SNAPSHOT_VERSION => decode_compressed(contents, seed),
+        version => Err(TryReadError::UnsupportedVersion(version)),
+    }
+}
+
+/// Decompress `compressed` contents and decode them with `seed`
+fn decode_compressed<'de, S: DeserializeSeed<'de>>(
+    compressed: &[u8],
+    seed: S,
+) -> Result<S::Value, TryReadError> {
+    let mut scratch = [0; READ_SCRATCH_SIZE];
+    let decoder = zstd::stream::read::Decoder::with_buffer(compressed)
+        .map_err(TryReadError::Decompression)?;
+    let mut deserializer =
+        ciborium::de::Deserializer::from_reader_with_buffer(decoder, &mut scratch);
+    Ok(seed.deserialize(&mut deserializer)?)
+}
+
+/// Decode [`State`] from its `contents` split into sections.
+///
+/// Sections are decoded concurrently. Triggers and the executor are decoded after
+/// their WASM modules are compiled, which happens on all available cores.
+fn decode_sections(contents: &[u8], seed: KuraSeed) -> Result<State, TryReadError> {
+    fn join<T>(
+        handle: std::thread::ScopedJoinHandle<'_, Result<T, TryReadError>>,
+    ) -> Result<T, TryReadError> {
+        handle.join().expect("Snapshot section decoding panicked")
+    }
+
+    let sections = Sections::parse(contents)?;
+    let engine = wasm::create_engine();
+    let (world, config, block_hashes, transactions) = std::thread::scope(|scope| {
+        let sections = &sections;
+        let parameters = scope.spawn(move || sections.decode(section::PARAMETERS));
+        let trusted_peers_ids = scope.spawn(move || sections.decode(section::TRUSTED_PEERS_IDS));
+        let domains = scope.spawn(move || sections.decode(section::DOMAINS));
+        let accounts = scope.spawn(move || sections.decode(section::ACCOUNTS));
+        let assets = scope.spawn(move || sections.decode(section::ASSETS));
+        let asset_holders = scope.spawn(move || sections.decode(section::ASSET_HOLDERS));
+        let asset_definitions_by_name =
+            scope.spawn(move || sections.decode(section::ASSET_DEFINITIONS_BY_NAME));
+        let roles = scope.spawn(move || sections.decode(section::ROLES));
+        let account_permissions =
+            scope.spawn(move || sections.decode(section::ACCOUNT_PERMISSIONS));
+        let account_roles = scope.spawn(move || sections.decode(section::ACCOUNT_ROLES));
+        let account_effective_permissions =
+            scope.spawn(move || sections.decode(section::ACCOUNT_EFFECTIVE_PERMISSIONS));
+        let executor_data_model =
+            scope.spawn(move || sections.decode(section::EXECUTOR_DATA_MODEL));
+        let config = scope.spawn(move || sections.decode(section::CONFIG));
+        let block_hashes = scope.spawn(move || sections.decode(section::BLOCK_HASHES));
+        let transactions = scope.spawn(move || sections.decode(section::TRANSACTIONS));
+
+        let contracts: Vec<WasmSmartContract> = sections.decode(section::MODULES)?;
+        let modules = wasm::load_modules(&engine, &contracts);
+        let contracts: wasm::ContractsByHash = contracts
+            .into_iter()
+            .map(|contract| (HashOf::new(&contract), contract))
+            .collect();
+        let loader = WasmSeed::<()>::new(&engine)
+            .with_modules(&modules)
+            .with_contracts(&contracts);
+        let (triggers, executor) = std::thread::scope(|scope| {
+            let triggers = scope
+                .spawn(|| sections.decode_seeded(section::TRIGGERS, loader.cast::<TriggerSet>()));
+            let executor = sections.decode_seeded(
+                section::EXECUTOR,
+                CellSeeded {
+                    seed: loader.cast::<Executor>(),
+                },
+            );
+            Ok::<_, TryReadError>((join(triggers)?, executor?))
+        })?;
+
+        let account_roles = join(account_roles)?;
+        let world = World {
+            parameters: join(parameters)?,
+            trusted_peers_ids: join(trusted_peers_ids)?,
+            domains: join(domains)?,
+            accounts: join(accounts)?,
+            assets: join(assets)?,
+            asset_holders: join(asset_holders)?,
+            asset_definitions_by_name: join(asset_definitions_by_name)?,
+            roles: join(roles)?,
+            account_permissions: join(account_permissions)?,
+            role_holders: World::role_holders_of(&account_roles),
+            account_roles,
+            account_effective_permissions: join(account_effective_permissions)?,
+            triggers,
+            executor,
+            executor_data_model: join(executor_data_model)?,
+        };
+        Ok::<_, TryReadError>((
+            world,
+            join(config)?,
+            join(block_hashes)?,
+            join(transactions)?,
+        ))
+    })?;
+
+    Ok(seed.assemble(world, config, block_hashes, transactions, engine))
+}
+
+/// Apply `entries` of a delta on top of the `state`, which is left unchanged on error
+fn apply_delta(state: &mut State, entries: DeltaEntries) -> Result<(), TryReadError> {
+    let mut state_block = state.block();
+    let from_height = usize::try_from(entries.from_height).expect("Checked against state height");
+    if from_height < state_block.block_hashes.len() {
+        // Blocks after `from_height` were reverted and replaced by those of the delta
+        state_block.transactions.remove_above(entries.from_height);
+    }
+    state_block.block_hashes.truncate(from_height);
+    state_block.block_hashes.extend(entries.block_hashes);
+    for (hash, height) in entries.transactions {
+        state_block.transactions.insert(hash, height);
+    }
+    *state_block.config = entries.config;
+
+    let mut state_transaction = state_block.transaction();
+    let world = &mut state_transaction.world;
+    *world.parameters.get_mut() = entries.parameters;
+    *world.trusted_peers_ids.get_mut() = entries.trusted_peers_ids;
+    *world.executor_data_model.get_mut() = entries.executor_data_model;
+    for (domain_id, domain) in entries.domains {
+        let old_definitions = world
+            .domains
+            .get(&domain_id)
+            .map(|domain| domain.asset_definitions.keys().cloned().collect::<Vec<_>>())
+            .unwrap_or_default();
+        for definition_id in old_definitions {
+            world.asset_definitions_by_name.remove(definition_id.into());
+        }
+        if let Some(domain) = domain {
+            for definition_id in domain.asset_definitions.keys() {
+                world
+                    .asset_definitions_by_name
+                    .insert(definition_id.clone().into(), ());
+            }
+            world.domains.insert(domain_id, domain);
+        } else {
+            world.domains.remove(domain_id);
+        }
+    }
+    for (account_id, account) in entries.accounts {
+        if let Some(account) = account {
+            world.accounts.insert(account_id, account);
+        } else {
+            world.accounts.remove(account_id);
+        }
+    }
+    for (key, asset) in entries.assets {
+        let holder =
+            AssetDefinitionIdWithHolder::new(key.definition_id.clone(), key.account_id.clone());
+        if let Some(asset) = asset {
+            world.asset_holders.insert(holder, ());
+            world.assets.insert(key, asset);
+        } else {
+            world.asset_holders.remove(holder);
+            world.assets.remove(key);
+        }
+    }
+
+    // Effective permissions are derived, so they are recomputed once their sources are applied
+    let mut changed_roles = Vec::new();
+    let mut changed_accounts = Vec::new();
+    for (role_id, role) in entries.roles {
+        if let Some(role) = role {
+            world.roles.insert(role_id.clone(), role);
+        } else {
+            world.roles.remove(role_id.clone());
+        }
+        changed_roles.push(role_id);
+    }
+    for (account_id, permissions) in entries.account_permissions {
+        if let Some(permissions) = permissions {
+            world
+                .account_permissions
+                .insert(account_id.clone(), permissions);
+        } else {
+            world.account_permissions.remove(account_id.clone());
+        }
+        changed_accounts.push(account_id);
+    }
+    for (role, granted) in entries.account_roles {
+        changed_accounts.push(role.account_id.clone());
+        let holder = RoleIdWithHolder::from(role.clone());
+        if granted {
+            world.role_holders.insert(holder, ());
+            world.account_roles.insert(role, ());
+        } else {
+            world.role_holders.remove(holder);
+            world.account_roles.remove(role);
+        }
+    }
+    for role_id in &changed_roles {
+        world.update_role_effective_permissions(role_id);
+    }
+    for account_id in &changed_accounts {
+        world.update_account_effective_permissions(account_id);
+    }
+
+    let engine = state_transaction.engine.clone(); // Cloning engine is cheap
+    let triggers = &mut state_transaction.world.triggers;
+    for (trigger_id, trigger) in entries.triggers {
+        triggers.remove(trigger_id);
+        if let Some(trigger) = trigger {
+            triggers.add_trigger(&engine, trigger)?;
+        }
+    }
+    triggers.replace_matched_ids(entries.matched_trigger_ids);
+
+    state_transaction.apply();
+    state_block.commit();
+    Ok(())
+}
+
+/// Write a delta snapshot if the `delta_chain` isn't full yet and changes since it are known,
+/// otherwise write a full snapshot, returning the snapshots written since the latest full one
+/// and size of the written snapshot.
+///
+/// # Errors
+/// - IO errors
+/// - Serialization errors
+fn try_write_snapshot_or_delta(
+    state: &State,
+    store_dir: impl AsRef<Path>,
+    delta_chain: Option<DeltaChain>,
+    delta_count: u32,
+    max_write_rate: Option<u64>,
+) -> Result<(DeltaChain, SnapshotSize), TryWriteError> {
+    // Drained before the state is viewed, so that the view covers every drained change
+    let changes = state.state_root.change_log().drain();
+
+    if let (Some(delta_chain), Some(changes)) = (delta_chain, &changes) {
+        if delta_chain.len < delta_count && !changes.all {
+            match try_write_delta(
+                state,
+                store_dir.as_ref(),
+                delta_chain,
+                changes,
+                max_write_rate,
+            ) {
+                Ok(size) => {
+                    let delta_chain = DeltaChain {
+                        height: changes.to_height,
+                        full_height: delta_chain.full_height,
+                        len: delta_chain.len + 1,
+                    };
+                    return Ok((delta_chain, size));
+                }
+                Err(
+                    error @ (TryWriteError::MissingBlock(_) | TryWriteError::LaggingChanges { .. }),
+                ) => {
+                    warn!(%error, "Writing full snapshot instead of a delta");
+                }
+                Err(error) => return Err(error),
+            }
+        }
+    }
+
+    let (height, size) = try_write_snapshot(state, store_dir, max_write_rate)?;
+    let delta_chain = DeltaChain {
+        // Changes of blocks committed after the drain are covered by the next delta
+        height: changes.map_or(height, |changes| changes.to_height),
+        full_height: height,
+        len: 0,
+    };
+    Ok((delta_chain, size))
+}
+
+/// Write a full snapshot of `state` into `store_dir` at an unlimited rate outside of
+/// [`SnapshotMaker`], e.g. to measure it. Returns the size of the snapshot file.
+///
+/// # Errors
+/// - IO errors
+/// - Serialization errors
+pub fn write_full_snapshot(
+    state: &State,
+    store_dir: impl AsRef<Path>,
+) -> Result<u64, TryWriteError> {
+    try_write_snapshot(state, store_dir, None).map(|(_height, size)| size.compressed)
+}
+
 /// Serialize and write snapshot to file,
-/// overwriting any previously stored data.
+/// overwriting any previously stored data and removing delta snapshots.
+/// Returns height of the state recorded in the header and size of the snapshot.
 ///
 /// # Errors
 /// - IO errors
 /// - Serialization errors
-fn try_write_snapshot(state: &State, store_dir: impl AsRef<Path>) -> Result<(), TryWriteError> {
-    std::fs::create_dir_all(store_dir.as_ref())
-        .map_err(|err| TryWriteError::IO(err, store_dir.as_ref().to_path_buf()))?;
-    let path_to_file = store_dir.as_ref().join(SNAPSHOT_FILE_NAME);
-    let path_to_tmp_file = store_dir.as_ref().join(SNAPSHOT_TMP_FILE_NAME);
-    let file = std::fs::OpenOptions::new()
+fn try_write_snapshot(
+    state: &State,
+    store_dir: impl AsRef<Path>,
+    max_write_rate: Option<u64>,
+) -> Result<(u64, SnapshotSize), TryWriteError> {
+    let store_dir = store_dir.as_ref();
+    std::fs::create_dir_all(store_dir)
+        .map_err(|err| TryWriteError::IO(err, store_dir.to_path_buf()))?;
+
+    // Held only while the sections are encoded, so that the header and every section match
+    let state_view = state.view();
+    let header = SnapshotHeader {
+        version: SNAPSHOT_VERSION,
+        height: state_view.height(),
+        latest_block_hash: state_view.latest_block_hash(),
+        len: 0,
+        checksum: 0,
+    };
+    let (path_to_spill_file, raw_len) =
+        try_write_spill_file(store_dir, |out| encode_sections(&state_view, out))?;
+    drop(state_view);
+
+    let (path_to_tmp_file, size) =
+        try_write_tmp_file(store_dir, SNAPSHOT_MAGIC, header, max_write_rate, |out| {
+            let mut spill = std::fs::File::open(&path_to_spill_file)
+                .map_err(|err| TryWriteError::IO(err, path_to_spill_file.clone()))?;
+            std::io::copy(&mut spill, out)
+                .map_err(|err| TryWriteError::IO(err, path_to_spill_file.clone()))?;
+            Ok(raw_len)
+        })?;
+    std::fs::remove_file(&path_to_spill_file)
+        .map_err(|err| TryWriteError::IO(err, path_to_spill_file.clone()))?;
+
+    // Deltas are removed first, so that they are never applied to a snapshot they weren't made for
+    for entry in std::fs::read_dir(store_dir)
+        .map_err(|err| TryWriteError::IO(err, store_dir.to_path_buf()))?
+    {
+        let entry = entry.map_err(|err| TryWriteError::IO(err, store_dir.to_path_buf()))?;
+        if entry
+            .file_name()
+            .to_string_lossy()
+            .starts_with(SNAPSHOT_DELTA_FILE_PREFIX)
+        {
+            std::fs::remove_file(entry.path())
+                .map_err(|err| TryWriteError::IO(err, entry.path()))?;
+        }
+    }
+
+    let path_to_file = store_dir.join(SNAPSHOT_FILE_NAME);
+    std::fs::rename(&path_to_tmp_file, &path_to_file)
+        .map_err(|err| TryWriteError::IO(err, path_to_file.clone()))?;
+    sync_dir(store_dir)?;
+    Ok((header.height, size))
+}
+
+/// Serialize and write the entries changed since the latest snapshot of the `delta_chain`
+/// into the next delta snapshot file.
+///
+/// # Errors
+/// - IO errors
+/// - Serialization errors
+/// - Blocks needed to restore committed transactions are missing
+/// - Recorded changes don't match the state
+fn try_write_delta(
+    state: &State,
+    store_dir: &Path,
+    delta_chain: DeltaChain,
+    changes: &Changes,
+    max_write_rate: Option<u64>,
+) -> Result<SnapshotSize, TryWriteError> {
+    let state_view = state.view();
+    let height = state_view.height();
+    if height != changes.to_height {
+        return Err(TryWriteError::LaggingChanges {
+            changes_height: changes.to_height,
+            state_height: height,
+        });
+    }
+
+    // Blocks after the latest snapshot might have been reverted and replaced
+    let from_height = delta_chain
+        .height
+        .min(changes.from_height.saturating_sub(1));
+    let mut transactions = Vec::new();
+    for block_height in from_height + 1..=height {
+        let block = state_view
+            .kura()
+            .get_block_by_height(block_height)
+            .ok_or(TryWriteError::MissingBlock(block_height))?;
+        transactions.extend(
+            block
+                .transactions()
+                .map(|tx| (tx.value.hash(), block_height)),
+        );
+    }
+
+    let world = &state_view.world;
+    let mut entries = DeltaEntries {
+        from_height,
+        config: *state_view.config(),
+        block_hashes: state_view
+            .block_hashes()
+            .iter_from(usize::try_from(from_height).expect("Not greater than state height"))
+            .copied()
+            .collect(),
+        transactions,
+        parameters: world.parameters().clone(),
+        trusted_peers_ids: world.trusted_peers_ids().clone(),
+        executor_data_model: world.executor_data_model().clone(),
+        domains: Vec::new(),
+        accounts: Vec::new(),
+        assets: Vec::new(),
+        roles: Vec::new(),
+        account_permissions: Vec::new(),
+        account_roles: Vec::new(),
+        triggers: Vec::new(),
+        matched_trigger_ids: world.triggers().matched_ids().to_vec(),
+    };
+    // Total quantities are stored in the domain, which is written once for all of them
+    let mut domains = BTreeSet::new();
+    for leaf in &changes.leaves {
+        match leaf {
+            StateLeaf::Domain(id) => {
+                domains.insert(id);
+            }
+            StateLeaf::AssetTotalQuantity(id) => {
+                domains.insert(&id.domain_id);
+            }
+            StateLeaf::Account(id) => entries
+                .accounts
+                .push((id.clone(), world.accounts().get(id).cloned())),
+            StateLeaf::Asset(id) => entries
+                .assets
+                .push((id.clone(), world.assets().get(id).cloned())),
+            StateLeaf::Role(id) => entries
+                .roles
+                .push((id.clone(), world.roles().get(id).cloned())),
+            StateLeaf::AccountPermissions(id) => entries
+                .account_permissions
+                .push((id.clone(), world.account_permissions().get(id).cloned())),
+            StateLeaf::AccountRole(id) => entries
+                .account_roles
+                .push((id.clone(), world.account_roles().get(id).is_some())),
+            StateLeaf::Trigger(id) => {
+                #[allow(clippy::redundant_closure_for_method_calls)]
+                let trigger = world
+                    .triggers()
+                    .inspect_by_id(id, |action| action.clone_and_box())
+                    .map(|action| {
+                        Trigger::new(
+                            id.clone(),
+                            world.triggers().get_original_action(action).into(),
+                        )
+                    });
+                entries.triggers.push((id.clone(), trigger));
+            }
+        }
+    }
+    entries.domains = domains
+        .into_iter()
+        .map(|id| (id.clone(), world.domains().get(id).cloned()))
+        .collect();
+
+    let header = SnapshotHeader {
+        version: COMPRESSED_SNAPSHOT_VERSION,
+        height,
+        latest_block_hash: state_view.latest_block_hash(),
+        len: 0,
+        checksum: 0,
+    };
+    // Entries are cloned out of the view, so it isn't held while the file is written
+    drop(state_view);
+    let (path_to_tmp_file, size) =
+        try_write_tmp_file(store_dir, DELTA_MAGIC, header, max_write_rate, |out| {
+            compress_into(out, &entries)
+        })?;
+    let path_to_file = delta_path(store_dir, delta_chain.len + 1);
+    std::fs::rename(&path_to_tmp_file, &path_to_file)
+        .map_err(|err| TryWriteError::IO(err, path_to_file.clone()))?;
+    sync_dir(store_dir)?;
+    Ok(size)
+}
+
+/// Encode the state seen by `state_view` into sections compressed one by one into `out`,
+/// returning the length of the contents before compression.
+fn encode_sections(state_view: &StateView, out: impl Write) -> Result<u64, TryWriteError> {
+    let world = &state_view.world;
+    let mut sections = SectionsWriter::new(out);
+    {
+        // Stored only here, the triggers and the executor refer to them by hash
+        let modules: Vec<&WasmSmartContract> = world
+            .triggers
+            .contracts()
+            .iter()
+            .filter_map(|(hash, _)| world.triggers.get_original_contract(hash))
+            .chain(world.executor.wasm())
+            .collect();
+        sections.push(section::MODULES, &modules)?;
+    }
+    sections.push(section::PARAMETERS, &*world.parameters)?;
+    sections.push(section::TRUSTED_PEERS_IDS, &*world.trusted_peers_ids)?;
+    sections.push(section::DOMAINS, &Entries::new(&world.domains))?;
+    sections.push(section::ACCOUNTS, &Entries::new(&world.accounts))?;
+    sections.push(section::ASSETS, &Entries::new(&world.assets))?;
+    sections.push(section::ASSET_HOLDERS, &Entries::new(&world.asset_holders))?;
+    sections.push(
+        section::ASSET_DEFINITIONS_BY_NAME,
+        &Entries::new(&world.asset_definitions_by_name),
+    )?;
+    sections.push(section::ROLES, &Entries::new(&world.roles))?;
+    sections.push(
+        section::ACCOUNT_PERMISSIONS,
+        &Entries::new(&world.account_permissions),
+    )?;
+    sections.push(section::ACCOUNT_ROLES, &Entries::new(&world.account_roles))?;
+    sections.push(
+        section::ACCOUNT_EFFECTIVE_PERMISSIONS,
+        &Entries::new(&world.account_effective_permissions),
+    )?;
+    sections.push(section::TRIGGERS, &WasmByHash(&world.triggers))?;
+    sections.push(section::EXECUTOR, &WasmByHash(&*world.executor))?;
+    sections.push(section::EXECUTOR_DATA_MODEL, &*world.executor_data_model)?;
+    sections.push(section::CONFIG, &*state_view.config)?;
+    sections.push(section::BLOCK_HASHES, &*state_view.block_hashes)?;
+    sections.push(section::TRANSACTIONS, &state_view.transactions)?;
+    sections.finish()
+}
+
+/// Encode `contents` and write them compressed into `out`, returning their length before
+/// compression
+fn compress_into(out: impl Write, contents: &impl Serialize) -> Result<u64, TryWriteError> {
+    let mut encoder = zstd::stream::write::Encoder::new(out, zstd::DEFAULT_COMPRESSION_LEVEL)
+        .map_err(TryWriteError::Compression)?;
+    encoder
+        .multithread(compression_workers())
+        .map_err(TryWriteError::Compression)?;
+    let mut raw = CountingWriter::new(encoder);
+    ciborium::into_writer(contents, &mut raw)?;
+    raw.inner.finish().map_err(TryWriteError::Compression)?;
+    Ok(raw.len)
+}
+
+/// Write the `header` followed by the contents written by `write_contents` into the temporary
+/// snapshot file, verify it and return its path and size.
+///
+/// Contents are compressed straight into the file, which is written in chunks at the rate of
+/// at most `max_write_rate` bytes per second. The header is written once the length and
+/// checksum of the contents are known. `write_contents` returns the length of the contents
+/// before compression.
+fn try_write_tmp_file(
+    store_dir: &Path,
+    magic: [u8; 8],
+    mut header: SnapshotHeader,
+    max_write_rate: Option<u64>,
+    write_contents: impl FnOnce(&mut dyn Write) -> Result<u64, TryWriteError>,
+) -> Result<(PathBuf, SnapshotSize), TryWriteError> {
+    let path_to_tmp_file = store_dir.join(SNAPSHOT_TMP_FILE_NAME);
+    let io_err = |err| TryWriteError::IO(err, path_to_tmp_file.clone());
+    let mut file = std::fs::OpenOptions::new()
         .create(true)
         .write(true)
         .truncate(true)
         .open(&path_to_tmp_file)
-        .map_err(|err| TryWriteError::IO(err, path_to_tmp_file.clone()))?;
-    let mut serializer = serde_json::Serializer::new(file);
-    state.serialize(&mut serializer)?;
-    std::fs::rename(path_to_tmp_file, &path_to_file)
-        .map_err(|err| TryWriteError::IO(err, path_to_file.clone()))?;
+        .map_err(io_err)?;
+    // Room for the header, which is overwritten once the contents are written
+    file.write_all(&header.encode(magic)).map_err(io_err)?;
+
+    let mut out = std::io::BufWriter::with_capacity(
+        WRITE_CHUNK_SIZE,
+        ContentsWriter::new(&mut file, max_write_rate),
+    );
+    let raw_len = write_contents(&mut out)?;
+    let contents = out.into_inner().map_err(|err| io_err(err.into_error()))?;
+    header.len = contents.len;
+    header.checksum = contents.hasher.finalize();
+
+    file.seek(SeekFrom::Start(0)).map_err(io_err)?;
+    file.write_all(&header.encode(magic)).map_err(io_err)?;
+    file.sync_all().map_err(io_err)?;
+    drop(file);
+
+    verify_written_file(&path_to_tmp_file, magic, &header)?;
+    let size = SnapshotSize {
+        raw: raw_len,
+        compressed: SnapshotHeader::SIZE as u64 + header.len,
+    };
+    Ok((path_to_tmp_file, size))
+}
+
+/// Write contents into the spill file in `store_dir` at an unlimited rate,
+/// returning its path and the length of the contents before compression.
+///
+/// Lets the contents be encoded from a view which is dropped before they are
+/// copied into the snapshot file at a limited rate.
+fn try_write_spill_file(
+    store_dir: &Path,
+    write_contents: impl FnOnce(&mut dyn Write) -> Result<u64, TryWriteError>,
+) -> Result<(PathBuf, u64), TryWriteError> {
+    let path_to_spill_file = store_dir.join(SNAPSHOT_SPILL_FILE_NAME);
+    let io_err = |err| TryWriteError::IO(err, path_to_spill_file.clone());
+    let file = std::fs::File::create(&path_to_spill_file).map_err(io_err)?;
+    let mut out = std::io::BufWriter::with_capacity(WRITE_CHUNK_SIZE, file);
+    let raw_len = write_contents(&mut out)?;
+    out.flush().map_err(io_err)?;
+    Ok((path_to_spill_file, raw_len))
+}
+
+/// Check that the file at `path` was written as described by the `header`,
+/// before it replaces the previous snapshot
+fn verify_written_file(
+    path: &Path,
+    magic: [u8; 8],
+    header: &SnapshotHeader,
+) -> Result<(), TryWriteError> {
+    let io_err = |err| TryWriteError::IO(err, path.to_path_buf());
+    let file = std::fs::File::open(path).map_err(io_err)?;
+    // SAFETY: the temporary file is only written by the snapshot writer, which is done with it
+    #[allow(unsafe_code)]
+    let bytes = unsafe { Mmap::map(&file) }.map_err(io_err)?;
+
+    let written_header = SnapshotHeader::decode(&bytes, magic).ok().flatten();
+    let contents = bytes.get(SnapshotHeader::SIZE..).unwrap_or_default();
+    if written_header.as_ref() != Some(header) || crc32fast::hash(contents) != header.checksum {
+        return Err(TryWriteError::Corrupted(path.to_path_buf()));
+    }
+    Ok(())
+}
+
+/// Flush renames of snapshot files in `store_dir`, so that they survive a crash
+fn sync_dir(store_dir: &Path) -> Result<(), TryWriteError> {
+    #[cfg(unix)]
+    std::fs::File::open(store_dir)
+        .and_then(|dir| dir.sync_all())
+        .map_err(|err| TryWriteError::IO(err, store_dir.to_path_buf()))?;
     Ok(())
 }
 
+/// Number of threads compressing a snapshot besides the writer thread, half of the available cores
+fn compression_workers() -> u32 {
+    std::thread::available_parallelism().map_or(0, |cores| {
+        u32::try_from(cores.get() / 2).unwrap_or(u32::MAX)
+    })
+}
+
+/// Path to the delta snapshot file with the given `index`, starting from 1
+fn delta_path(store_dir: &Path, index: u32) -> PathBuf {
+    store_dir.join(format!("{SNAPSHOT_DELTA_FILE_PREFIX}{index}"))
+}
+
+/// Snapshots written since the latest full snapshot
+#[derive(Debug, Clone, Copy, PartialEq, Eq)]
+struct DeltaChain {
+    /// Height of the state covered by the latest snapshot
+    height: u64,
+    /// Height recorded in the header of the full snapshot, which is renamed in place
+    full_height: u64,
+    /// Number of delta snapshots written after the full snapshot
+    len: u32,
+}
+
+/// Size of a written snapshot file
+#[derive(Debug, Clone, Copy, PartialEq, Eq)]
+struct SnapshotSize {
+    /// Size of the encoded contents before compression
+    raw: u64,
+    /// Size of the file
+    compressed: u64,
+}
+
+/// Entries of the [`State`] changed since the snapshot the delta is applied on
+#[derive(Serialize, Deserialize)]
+struct DeltaEntries {
+    /// Height of the state the delta is applied on
+    from_height: u64,
+    config: ChainWide,
+    /// Hashes of the blocks after `from_height`
+    block_hashes: Vec<HashOf<SignedBlock>>,
+    /// Transactions of the blocks after `from_height` with heights of their blocks
+    transactions: Vec<(HashOf<SignedTransaction>, u64)>,
+    parameters: Parameters,
+    trusted_peers_ids: PeersIds,
+    executor_data_model: ExecutorDataModel,
+    /// Changed domains, [`None`] if removed
+    domains: Vec<(DomainId, Option<Domain>)>,
+    /// Changed accounts, [`None`] if removed
+    accounts: Vec<(AccountId, Option<Account>)>,
+    /// Changed assets, [`None`] if removed
+    assets: Vec<(AccountIdWithAssetDefinition, Option<Asset>)>,
+    /// Changed roles, [`None`] if removed
+    roles: Vec<(RoleId, Option<Role>)>,
+    /// Changed permissions granted to accounts directly, [`None`] if there are none left
+    account_permissions: Vec<(AccountId, Option<Permissions>)>,
+    /// Changed roles granted to accounts, `false` if revoked
+    account_roles: Vec<(RoleIdWithOwner, bool)>,
+    /// Changed triggers, [`None`] if removed
+    triggers: Vec<(TriggerId, Option<Trigger>)>,
+    /// Triggers matched by events which are yet to be executed
+    matched_trigger_ids: Vec<(EventBox, TriggerId)>,
+}
+
+/// Header of a binary snapshot file, checked before the contents are decoded
+#[derive(Debug, Clone, Copy, PartialEq, Eq)]
+struct SnapshotHeader {
+    /// Version of the format
+    version: u32,
+    /// Height of the state
+    height: u64,
+    /// Hash of the latest block applied to the state
+    latest_block_hash: Option<HashOf<SignedBlock>>,
+    /// Length of the contents following the header
+    len: u64,
+    /// CRC32 checksum of the contents following the header
+    checksum: u32,
+}
+
+impl SnapshotHeader {
+    /// Size of the encoded header: magic, version, height, block hash, length and checksum
+    const SIZE: usize = SNAPSHOT_MAGIC.len() + 4 + 8 + Hash::LENGTH + 8 + 4;
+
+    fn encode(&self, magic: [u8; 8]) -> Vec<u8> {
+        // Valid hashes have the least significant bit set, so zeroes never match one
+        let latest_block_hash: [u8; Hash::LENGTH] = self
+            .latest_block_hash
+            .map_or([0; Hash::LENGTH], |hash| Hash::from(hash).into());
+
+        let mut bytes = Vec::with_capacity(Self::SIZE);
+        bytes.extend_from_slice(&magic);
+        bytes.extend_from_slice(&self.version.to_le_bytes());
+        bytes.extend_from_slice(&self.height.to_le_bytes());
+        bytes.extend_from_slice(&latest_block_hash);
+        bytes.extend_from_slice(&self.len.to_le_bytes());
+        bytes.extend_from_slice(&self.checksum.to_le_bytes());
+        bytes
+    }
+
+    /// Decode the header at the start of `bytes`, [`None`] if they don't start with `magic`
+    fn decode(bytes: &[u8], magic: [u8; 8]) -> Result<Option<Self>, TryReadError> {
+        fn take<const N: usize>(bytes: &mut &[u8]) -> [u8; N] {
+            let (field, rest) = bytes.split_at(N);
+            *bytes = rest;
+            field.try_into().expect("Split at the field length")
+        }
+
+        let Some(mut bytes) = bytes.get(..Self::SIZE) else {
+            return Ok(None);
+        };
+        if take(&mut bytes) != magic {
+            return Ok(None);
+        }
+        let version = u32::from_le_bytes(take(&mut bytes));
+        if !(UNCOMPRESSED_SNAPSHOT_VERSION..=SNAPSHOT_VERSION).contains(&version) {
+            return Err(TryReadError::UnsupportedVersion(version));
+        }
+        let height = u64::from_le_bytes(take(&mut bytes));
+        let latest_block_hash: [u8; Hash::LENGTH] = take(&mut bytes);
+        let latest_block_hash = (latest_block_hash != [0; Hash::LENGTH])
+            .then(|| HashOf::from_untyped_unchecked(Hash::prehashed(latest_block_hash)));
+
+        Ok(Some(Self {
+            version,
+            height,
+            latest_block_hash,
+            len: u64::from_le_bytes(take(&mut bytes)),
+            checksum: u32::from_le_bytes(take(&mut bytes)),
+        }))
+    }
+
+    /// Check that the snapshot was made from blocks stored in `kura`
+    fn check(&self, kura: &Kura, block_count: usize) -> Result<(), TryReadError> {
+        if self.height > block_count as u64 {
+            return Err(TryReadError::MismatchedHeight {
+                snapshot_height: usize::try_from(self.height)
+                    .expect("Snapshot height exceeds `usize::MAX`"),
+                kura_height: block_count,
+            });
+        }
+        if let Some(snapshot_block_hash) = self.latest_block_hash {
+            let kura_block_hash = kura
+                .get_block_hash(self.height)
+                .expect("Kura has height at least as large as snapshot height");
+            if kura_block_hash != snapshot_block_hash {
+                return Err(TryReadError::MismatchedHash {
+                    height: usize::try_from(self.height).expect("Checked against kura height"),
+                    snapshot_block_hash,
+                    kura_block_hash,
+                });
+            }
+        }
+        Ok(())
+    }
+}
+
+/// Names of the sections of a snapshot
+mod section {
+    pub const MODULES: &str = "modules";
+    pub const PARAMETERS: &str = "parameters";
+    pub const TRUSTED_PEERS_IDS: &str = "trusted_peers_ids";
+    pub const DOMAINS: &str = "domains";
+    pub const ACCOUNTS: &str = "accounts";
+    pub const ASSETS: &str = "assets";
+    pub const ASSET_HOLDERS: &str = "asset_holders";
+    pub const ASSET_DEFINITIONS_BY_NAME: &str = "asset_definitions_by_name";
+    pub const ROLES: &str = "roles";
+    pub const ACCOUNT_PERMISSIONS: &str = "account_permissions";
+    pub const ACCOUNT_ROLES: &str = "account_roles";
+    pub const ACCOUNT_EFFECTIVE_PERMISSIONS: &str = "account_effective_permissions";
+    pub const TRIGGERS: &str = "triggers";
+    pub const EXECUTOR: &str = "executor";
+    pub const EXECUTOR_DATA_MODEL: &str = "executor_data_model";
+    pub const CONFIG: &str = "config";
+    pub const BLOCK_HASHES: &str = "block_hashes";
+    pub const TRANSACTIONS: &str = "transactions";
+}
+
+/// Writer of contents split into sections.
+///
+/// Sections are compressed one after another, followed by the table of their names and
+/// lengths encoded as CBOR and by the length of the table as a little-endian `u32`.
+struct SectionsWriter<W> {
+    out: W,
+    table: Vec<(&'static str, u64)>,
+    raw_len: u64,
+}
+
+impl<W: Write> SectionsWriter<W> {
+    fn new(out: W) -> Self {
+        Self {
+            out,
+            table: Vec::new(),
+            raw_len: 0,
+        }
+    }
+
+    /// Append the `section` with the given `name`
+    fn push(&mut self, name: &'static str, section: &impl Serialize) -> Result<(), TryWriteError> {
+        let mut compressed = CountingWriter::new(&mut self.out);
+        self.raw_len += compress_into(&mut compressed, section)?;
+        self.table.push((name, compressed.len));
+        Ok(())
+    }
+
+    /// Append the table of sections, returning the length of the contents before compression
+    fn finish(mut self) -> Result<u64, TryWriteError> {
+        let mut table = Vec::new();
+        ciborium::into_writer(&self.table, &mut table)?;
+        let table_len = u32::try_from(table.len()).expect("Table of snapshot sections is small");
+        table.extend_from_slice(&table_len.to_le_bytes());
+        self.out
+            .write_all(&table)
+            .map_err(ciborium::ser::Error::Io)?;
+        Ok(self.raw_len + table.len() as u64)
+    }
+}
+
+/// Contents split into sections, see [`SectionsWriter`]
+struct Sections<'a>(BTreeMap<String, &'a [u8]>);
+
+impl<'a> Sections<'a> {
+    fn parse(contents: &'a [u8]) -> Result<Self, TryReadError> {
+        let table_end = contents
+            .len()
+            .checked_sub(4)
+            .ok_or(TryReadError::MalformedSections)?;
+        let table_len = u32::from_le_bytes(
+            contents[table_end..]
+                .try_into()
+                .expect("Split at the length of the table"),
+        );
+        let sections_end = usize::try_from(table_len)
+            .ok()
+            .and_then(|table_len| table_end.checked_sub(table_len))
+            .ok_or(TryReadError::MalformedSections)?;
+        let table: Vec<(String, u64)> = ciborium::from_reader(&contents[sections_end..table_end])?;
+
+        let mut sections = BTreeMap::new();
+        let mut rest = &contents[..sections_end];
+        for (name, len) in table {
+            let len = usize::try_from(len)
+                .ok()
+                .filter(|len| *len <= rest.len())
+                .ok_or(TryReadError::MalformedSections)?;
+            let (section, tail) = rest.split_at(len);
+            sections.insert(name, section);
+            rest = tail;
+        }
+        if !rest.is_empty() {
+            return Err(TryReadError::MalformedSections);
+        }
+        Ok(Self(sections))
+    }
+
+    fn decode<T: DeserializeOwned>(&self, name: &'static str) -> Result<T, TryReadError> {
+        self.decode_seeded(name, PhantomData)
+    }
+
+    fn decode_seeded<'de, S: DeserializeSeed<'de>>(
+        &self,
+        name: &'static str,
+        seed: S,
+    ) -> Result<S::Value, TryReadError> {
+        let section = self.0.get(name).ok_or(TryReadError::MissingSection(name))?;
+        decode_compressed(section, seed)
+    }
+}
+
+/// Writer which tracks length of the bytes written through it
+struct CountingWriter<W> {
+    inner: W,
+    len: u64,
+}
+
+impl<W> CountingWriter<W> {
+    fn new(inner: W) -> Self {
+        Self { inner, len: 0 }
+    }
+}
+
+impl<W: Write> Write for CountingWriter<W> {
+    fn write(&mut self, buf: &[u8]) -> std::io::Result<usize> {
+        let written = self.inner.write(buf)?;
+        self.len += written as u64;
+        Ok(written)
+    }
+
+    fn flush(&mut self) -> std::io::Result<()> {
+        self.inner.flush()
+    }
+}
+
+/// Writer of the contents of a snapshot file at a limited rate, which tracks their length and
+/// checksum
+struct ContentsWriter<W> {
+    inner: W,
+    throttle: Throttle,
+    hasher: crc32fast::Hasher,
+    len: u64,
+}
+
+impl<W> ContentsWriter<W> {
+    fn new(inner: W, max_write_rate: Option<u64>) -> Self {
+        Self {
+            inner,
+            throttle: Throttle::new(max_write_rate),
+            hasher: crc32fast::Hasher::new(),
+            len: 0,
+        }
+    }
+}
+
+impl<W: Write> Write for ContentsWriter<W> {
+    fn write(&mut self, buf: &[u8]) -> std::io::Result<usize> {
+        let written = self.inner.write(buf)?;
+        self.hasher.update(&buf[..written]);
+        self.len += written as u64;
+        self.throttle.consume(written);
+        Ok(written)
+    }
+
+    fn flush(&mut self) -> std::io::Result<()> {
+        self.inner.flush()
+    }
+}
+
+/// Limit of the rate of writes, which sleeps whenever writes get ahead of the rate
+struct Throttle {
+    /// Bytes per second, [`None`] if writes are unlimited
+    rate: Option<u64>,
+    started: Instant,
+    written: u64,
+}
+
+impl Throttle {
+    fn new(rate: Option<u64>) -> Self {
+        Self {
+            rate: rate.filter(|rate| *rate > 0),
+            started: Instant::now(),
+            written: 0,
+        }
+    }
+
+    /// Account for `len` written bytes
+    #[allow(clippy::cast_precision_loss)]
+    fn consume(&mut self, len: usize) {
+        let Some(rate) = self.rate else {
+            return;
+        };
+        self.written += len as u64;
+        let due = Duration::from_secs_f64(self.written as f64 / rate as f64);
+        if let Some(ahead) = due.checked_sub(self.started.elapsed()) {
+            std::thread::sleep(ahead);
+        }
+    }
+}
+
 /// Error variants for snapshot reading
 #[derive(thiserror::Error, Debug, displaydoc::Display)]
 pub enum TryReadError {
@@ -217,6 +1486,29 @@ pub enum TryReadError {
     IO(#[source] std::io::Error, PathBuf),
     /// Error (de)serializing state snapshot
     Serialization(#[from] serde_json::Error),
+    /// Error decoding state snapshot
+    Decode(#[from] ciborium::de::Error<std::io::Error>),
+    /// Error decompressing state snapshot
+    Decompression(#[source] std::io::Error),
+    /// Snapshot format version {0} is not supported
+    UnsupportedVersion(u32),
+    /// Snapshot is corrupted: its length or checksum differs from the header
+    MismatchedChecksum,
+    /// Table of snapshot sections doesn't match its contents
+    MalformedSections,
+    /// Snapshot section {0} is missing
+    MissingSection(&'static str),
+    /// Delta snapshot doesn't start with a valid header
+    MalformedDelta,
+    /// Failed to load trigger of delta snapshot
+    Trigger(#[from] TriggerSetError),
+    /// Delta snapshot is made on top of height {from_height}, but the state has height {state_height}
+    DetachedDelta {
+        /// Height of the state the delta is applied on
+        from_height: u64,
+        /// Height of the state read so far
+        state_height: u64,
+    },
     /// Snapshot is in a non-consistent state. Snapshot has greater height (`snapshot_height`) than kura block store (`kura_height`)
     MismatchedHeight {
         /// The amount of block hashes stored by snapshot
@@ -237,22 +1529,40 @@ pub enum TryReadError {
 
 /// Error variants for snapshot writing
 #[derive(thiserror::Error, Debug, displaydoc::Display)]
-enum TryWriteError {
+pub enum TryWriteError {
     /// Failed reading/writing {1:?} from disk
     IO(#[source] std::io::Error, PathBuf),
-    /// Error (de)serializing World State View snapshot
-    Serialization(#[from] serde_json::Error),
+    /// Error encoding state snapshot
+    Encode(#[from] ciborium::ser::Error<std::io::Error>),
+    /// Error compressing state snapshot
+    Compression(#[source] std::io::Error),
+    /// Written snapshot {0:?} differs from what was meant to be written
+    Corrupted(PathBuf),
+    /// Block at height {0} is missing from kura
+    MissingBlock(u64),
+    /// Changes are recorded up to height {changes_height}, but the state has height {state_height}
+    LaggingChanges {
+        /// Height of the latest block whose changes are recorded
+        changes_height: u64,
+        /// Height of the state
+        state_height: u64,
+    },
 }
 
 #[cfg(test)]
 mod tests {
     use std::{fs::File, io::Write};
 
+    use iroha_primitives::unique_vec::UniqueVec;
     use tempfile::tempdir;
+    use test_samples::gen_account_in;
     use tokio::test;
 
     use super::*;
-    use crate::query::store::LiveQueryStore;
+    use crate::{
+        block::ValidBlock, query::store::LiveQueryStore, smartcontracts::Execute as _,
+        sumeragi::network_topology::Topology,
+    };
 
     fn state_factory() -> State {
         let kura = Kura::blank_kura_for_testing();
@@ -270,7 +1580,7 @@ mod tests {
         let snapshot_store_dir = tmp_root.path().join("path/to/snapshot/dir");
         let state = state_factory();
 
-        try_write_snapshot(&state, &snapshot_store_dir).unwrap();
+        try_write_snapshot(&state, &snapshot_store_dir, None).unwrap();
 
         assert!(Path::exists(snapshot_store_dir.as_path()))
     }
@@ -281,7 +1591,8 @@ mod tests {
         let store_dir = tmp_root.path().join("snapshot");
         let state = state_factory();
 
-        try_write_snapshot(&state, &store_dir).unwrap();
+        try_write_snapshot(&state, &store_dir, None).unwrap();
+        assert!(!store_dir.join(SNAPSHOT_SPILL_FILE_NAME).exists());
         let _wsv = try_read_snapshot(
             &store_dir,
             &Kura::blank_kura_for_testing(),
@@ -330,5 +1641,291 @@ mod tests {
         assert_eq!(format!("{error}"), "Error (de)serializing state snapshot");
     }
 
+    #[test]
+    async fn corrupted_snapshot_on_read_is_error() {
+        let tmp_root = tempdir().unwrap();
+        let store_dir = tmp_root.path().join("snapshot");
+        let state = state_factory();
+
+        try_write_snapshot(&state, &store_dir, None).unwrap();
+        let path = store_dir.join(SNAPSHOT_FILE_NAME);
+        let mut bytes = std::fs::read(&path).unwrap();
+        *bytes.last_mut().unwrap() ^= 1;
+        std::fs::write(&path, bytes).unwrap();
+
+        let Err(error) = try_read_snapshot(
+            &store_dir,
+            &Kura::blank_kura_for_testing(),
+            LiveQueryStore::test().start(),
+            BlockCount(usize::try_from(state.view().height()).unwrap()),
+        ) else {
+            panic!("should not be ok")
+        };
+
+        assert!(matches!(error, TryReadError::MismatchedChecksum));
+    }
+
+    #[test]
+    async fn can_read_legacy_json_snapshot() {
+        let tmp_root = tempdir().unwrap();
+        let store_dir = tmp_root.path().join("snapshot");
+        std::fs::create_dir(&store_dir).unwrap();
+        let state = state_factory();
+        {
+            let file = File::create(store_dir.join(SNAPSHOT_FILE_NAME)).unwrap();
+            serde_json::to_writer(file, &state).unwrap();
+        }
+
+        let _wsv = try_read_snapshot(
+            &store_dir,
+            &Kura::blank_kura_for_testing(),
+            LiveQueryStore::test().start(),
+            BlockCount(usize::try_from(state.view().height()).unwrap()),
+        )
+        .unwrap();
+    }
+
+    #[test]
+    async fn can_read_legacy_json_snapshot_with_nested_accounts() {
+        let tmp_root = tempdir().unwrap();
+        let store_dir = tmp_root.path().join("snapshot");
+        std::fs::create_dir(&store_dir).unwrap();
+        let (account_id, _account_keypair) = gen_account_in("wonderland");
+        let definition_id: AssetDefinitionId = "rose#wonderland".parse().unwrap();
+        let mut domain = Domain::new("wonderland".parse().unwrap()).build(&account_id);
+        assert!(domain
+            .add_asset_definition(
+                AssetDefinition::numeric(definition_id.clone()).build(&account_id)
+            )
+            .is_none());
+        let account = Account::new(account_id.clone()).build(&account_id);
+        let asset_id = AssetId::new(definition_id.clone(), account_id.clone());
+        let asset = Asset::new(asset_id.clone(), Numeric::new(13, 0));
+        let can_do = Permission::new("CanDo".parse().unwrap(), serde_json::Value::Null);
+        let state = State::new(
+            World::with([domain], [account], PeersIds::new()),
+            Kura::blank_kura_for_testing(),
+            LiveQueryStore::test().start(),
+        );
+
+        // Lay the state out as it was stored before accounts and assets got storages of their own
+        let mut legacy = serde_json::to_value(&state).unwrap();
+        let world = legacy["world"].as_object_mut().unwrap();
+        let mut accounts = world.remove("accounts").unwrap();
+        accounts[account_id.to_string()]["assets"] =
+            serde_json::json!({ (definition_id.to_string()): asset });
+        world["domains"]["wonderland"]["accounts"] = accounts;
+        world["account_permissions"] = serde_json::json!({ (account_id.to_string()): [can_do] });
+        for field in [
+            "assets",
+            "asset_holders",
+            "asset_definitions_by_name",
+            "account_effective_permissions",
+        ] {
+            world.remove(field).unwrap();
+        }
+        legacy["transactions"] = legacy["transactions"][0].take();
+        {
+            let file = File::create(store_dir.join(SNAPSHOT_FILE_NAME)).unwrap();
+            serde_json::to_writer(file, &legacy).unwrap();
+        }
+
+        let state = try_read_snapshot(
+            &store_dir,
+            &Kura::blank_kura_for_testing(),
+            LiveQueryStore::test().start(),
+            BlockCount(usize::try_from(state.view().height()).unwrap()),
+        )
+        .unwrap();
+        let view = state.view();
+        assert!(view.world.account(&account_id).is_ok());
+        assert_eq!(view.world.asset(&asset_id).unwrap(), asset);
+        assert_eq!(
+            view.world
+                .asset_holders_iter(&definition_id)
+                .collect::<Vec<_>>(),
+            [&account_id]
+        );
+        assert_eq!(
+            view.world
+                .asset_definitions_by_name_iter(&definition_id.name)
+                .collect::<Vec<_>>(),
+            [&definition_id]
+        );
+        assert_eq!(
+            view.world
+                .account_permissions_iter(&account_id)
+                .unwrap()
+                .collect::<Vec<_>>(),
+            [&can_do]
+        );
+    }
+
+    #[test]
+    async fn can_read_delta_snapshot_after_writing() {
+        let tmp_root = tempdir().unwrap();
+        let store_dir = tmp_root.path().join("snapshot");
+        let kura = Kura::blank_kura_for_testing();
+        let state = State::new(
+            crate::queue::tests::world_with_test_domains(),
+            Arc::clone(&kura),
+            LiveQueryStore::test().start(),
+        );
+        state.state_root.change_log().enable();
+        let (delta_chain, _size) =
+            try_write_snapshot_or_delta(&state, &store_dir, None, 1, None).unwrap();
+        assert_eq!(
+            delta_chain,
+            DeltaChain {
+                height: 0,
+                full_height: 0,
+                len: 0
+            }
+        );
+
+        let (authority, _authority_keypair) = gen_account_in("wonderland");
+        let domain_id: DomainId = "delta".parse().unwrap();
+        let trigger_id: TriggerId = "delta_trigger".parse().unwrap();
+        let block = ValidBlock::new_dummy_and_modify_payload(|payload| payload.header.height = 1)
+            .commit(&Topology::new(UniqueVec::new()))
+            .unpack(|_| {})
+            .unwrap();
+        {
+            let mut state_block = state.block();
+            let mut state_transaction = state_block.transaction();
+            Register::domain(Domain::new(domain_id.clone()))
+                .execute(&authority, &mut state_transaction)
+                .unwrap();
+            Register::trigger(Trigger::new(
+                trigger_id.clone(),
+                Action::new(
+                    Vec::<InstructionBox>::new(),
+                    Repeats::Indefinitely,
+                    authority.clone(),
+                    ExecuteTriggerEventFilter::new().for_trigger(trigger_id.clone()),
+                ),
+            ))
+            .execute(&authority, &mut state_transaction)
+            .unwrap();
+            state_transaction.apply();
+            let _events = state_block.apply_without_execution(&block);
+            state_block.commit();
+        }
+        kura.store_block(block);
+        let (delta_chain, _size) =
+            try_write_snapshot_or_delta(&state, &store_dir, Some(delta_chain), 1, None).unwrap();
+        assert_eq!(
+            delta_chain,
+            DeltaChain {
+                height: 1,
+                full_height: 0,
+                len: 1
+            }
+        );
+
+        let state = try_read_snapshot(
+            &store_dir,
+            &kura,
+            LiveQueryStore::test().start(),
+            BlockCount(1),
+        )
+        .unwrap();
+        let state_view = state.view();
+        assert_eq!(state_view.height(), 1);
+        assert!(state_view.world.domains().get(&domain_id).is_some());
+        assert!(state_view.world.triggers().ids().get(&trigger_id).is_some());
+    }
+
+    #[test]
+    async fn wasm_of_triggers_is_stored_only_with_modules() {
+        let tmp_root = tempdir().unwrap();
+        let store_dir = tmp_root.path().join("snapshot");
+        let state = state_factory();
+        let (authority, _authority_keypair) = gen_account_in("wonderland");
+        let trigger_id: TriggerId = "wasm_trigger".parse().unwrap();
+        // Empty module
+        let wasm = WasmSmartContract::from_compiled(b"\0asm\x01\0\0\0".to_vec());
+        {
+            let mut state_block = state.block();
+            let mut state_transaction = state_block.transaction();
+            Register::trigger(Trigger::new(
+                trigger_id.clone(),
+                Action::new(
+                    wasm.clone(),
+                    Repeats::Indefinitely,
+                    authority.clone(),
+                    ExecuteTriggerEventFilter::new().for_trigger(trigger_id.clone()),
+                ),
+            ))
+            .execute(&authority, &mut state_transaction)
+            .unwrap();
+            state_transaction.apply();
+            state_block.commit();
+        }
+        try_write_snapshot(&state, &store_dir, None).unwrap();
+
+        let bytes = map_file(&store_dir.join(SNAPSHOT_FILE_NAME))
+            .unwrap()
+            .unwrap();
+        let header = SnapshotHeader::decode(&bytes, SNAPSHOT_MAGIC)
+            .unwrap()
+            .unwrap();
+        let sections = Sections::parse(checked_contents(&header, &bytes).unwrap()).unwrap();
+        let triggers: ciborium::Value = sections.decode(section::TRIGGERS).unwrap();
+        assert!(!format!("{triggers:?}").contains("original_contract"));
+
+        let state = try_read_snapshot(
+            &store_dir,
+            &Kura::blank_kura_for_testing(),
+            LiveQueryStore::test().start(),
+            BlockCount(0),
+        )
+        .unwrap();
+        let state_view = state.view();
+        assert_eq!(
+            state_view
+                .world
+                .triggers()
+                .get_original_contract(&HashOf::new(&wasm)),
+            Some(&wasm)
+        );
+    }
+
+    #[test]
+    async fn throttle_limits_write_rate() {
+        let mut throttle = Throttle::new(Some(1024 * 1024));
+        let started = Instant::now();
+
+        for _ in 0..4 {
+            throttle.consume(64 * 1024);
+        }
+
+        assert!(started.elapsed() >= Duration::from_millis(250));
+    }
+
+    #[test]
+    async fn sections_are_read_by_name() {
+        let mut contents = Vec::new();
+        let mut sections = SectionsWriter::new(&mut contents);
+        sections.push(section::CONFIG, &1_u32).unwrap();
+        sections.push(section::BLOCK_HASHES, &"hashes").unwrap();
+        sections.finish().unwrap();
+
+        let sections = Sections::parse(&contents).unwrap();
+        assert_eq!(
+            sections.decode::<String>(section::BLOCK_HASHES).unwrap(),
+            "hashes"
+        );
+        assert_eq!(sections.decode::<u32>(section::CONFIG).unwrap(), 1);
+        assert!(matches!(
+            sections.decode::<u32>(section::DOMAINS),
+            Err(TryReadError::MissingSection(section::DOMAINS))
+        ));
+        assert!(matches!(
+            Sections::parse(&contents[1..]),
+            Err(TryReadError::MalformedSections)
+        ));
+    }
+
     // TODO: test block count comparison
 }
@@ -1,5 +1,11 @@
 //! This module provides the [`State`] — an in-memory representation of the current blockchain state.
-use std::{borrow::Borrow, collections::BTreeSet, marker::PhantomData, sync::Arc, time::Duration};
+use std::{
+    borrow::Borrow,
+    collections::{BTreeMap, BTreeSet},
+    marker::PhantomData,
+    sync::Arc,
+    time::Duration,
+};
 
 use eyre::Result;
 use iroha_config::parameters::actual::ChainWide as Config;
@@ -24,7 +30,10 @@ use iroha_data_model::{
 use iroha_logger::prelude::*;
 use iroha_primitives::{must_use::MustUse, numeric::Numeric, small::SmallVec};
 use parking_lot::Mutex;
-use range_bounds::RoleIdByAccountBounds;
+use range_bounds::{
+    AccountByDomainBounds, AssetByAccountBounds, AssetDefinitionByNameBounds,
+    HolderByAssetDefinitionBounds, HolderByRoleBounds, RoleIdByAccountBounds,
+};
 use serde::{
     de::{DeserializeSeed, MapAccess, Visitor},
     Deserializer, Serialize,
@@ -38,11 +47,14 @@ use storage::{
 };
 
 use crate::{
+    asset::{AccountIdWithAssetDefinition, AssetDefinitionIdWithHolder, AssetDefinitionIdWithName},
     block::CommittedBlock,
+    block_hashes::BlockHashes,
     executor::Executor,
+    hot_keys::{Access, HotKey, HotKeys},
     kura::Kura,
     query::store::LiveQueryStoreHandle,
-    role::RoleIdWithOwner,
+    role::{RoleIdWithHolder, RoleIdWithOwner},
     smartcontracts::{
         triggers::{
             self,
@@ -54,7 +66,9 @@ use crate::{
         },
         wasm, Execute,
     },
+    state_root::{StateRoot, StateRootBlock, StateRootView},
     tx::TransactionExecutor,
+    tx_set::{TxSet, TxSetBlock, TxSetReadOnly, TxSetTransaction, TxSetView},
     Parameters, PeersIds,
 };
 
@@ -68,12 +82,25 @@ pub struct World {
     pub(crate) trusted_peers_ids: Cell<PeersIds>,
     /// Registered domains.
     pub(crate) domains: Storage<DomainId, Domain>,
+    /// Registered accounts.
+    pub(crate) accounts: Storage<AccountId, Account>,
+    /// Registered assets.
+    pub(crate) assets: Storage<AccountIdWithAssetDefinition, Asset>,
+    /// Holders of assets of an asset definition.
+    pub(crate) asset_holders: Storage<AssetDefinitionIdWithHolder, ()>,
+    /// Asset definitions ordered by their name.
+    pub(crate) asset_definitions_by_name: Storage<AssetDefinitionIdWithName, ()>,
     /// Roles. [`Role`] pairs.
     pub(crate) roles: Storage<RoleId, Role>,
     /// Permission tokens of an account.
     pub(crate) account_permissions: Storage<AccountId, Permissions>,
     /// Roles of an account.
     pub(crate) account_roles: Storage<RoleIdWithOwner, ()>,
+    /// Holders of a role, rebuilt from `account_roles` when deserialized.
+    #[serde(skip)]
+    pub(crate) role_holders: Storage<RoleIdWithHolder, ()>,
+    /// Permission tokens of an account, both inherent and granted through roles.
+    pub(crate) account_effective_permissions: Storage<AccountId, Permissions>,
     /// Triggers
     pub(crate) triggers: TriggerSet,
     /// Runtime Executor
@@ -90,12 +117,24 @@ pub struct WorldBlock<'world> {
     pub(crate) trusted_peers_ids: CellBlock<'world, PeersIds>,
     /// Registered domains.
     pub(crate) domains: StorageBlock<'world, DomainId, Domain>,
+    /// Registered accounts.
+    pub(crate) accounts: StorageBlock<'world, AccountId, Account>,
+    /// Registered assets.
+    pub(crate) assets: StorageBlock<'world, AccountIdWithAssetDefinition, Asset>,
+    /// Holders of assets of an asset definition.
+    pub(crate) asset_holders: StorageBlock<'world, AssetDefinitionIdWithHolder, ()>,
+    /// Asset definitions ordered by their name.
+    pub(crate) asset_definitions_by_name: StorageBlock<'world, AssetDefinitionIdWithName, ()>,
     /// Roles. [`Role`] pairs.
     pub(crate) roles: StorageBlock<'world, RoleId, Role>,
     /// Permission tokens of an account.
     pub(crate) account_permissions: StorageBlock<'world, AccountId, Permissions>,
     /// Roles of an account.
     pub(crate) account_roles: StorageBlock<'world, RoleIdWithOwner, ()>,
+    /// Holders of a role.
+    pub(crate) role_holders: StorageBlock<'world, RoleIdWithHolder, ()>,
+    /// Permission tokens of an account, both inherent and granted through roles.
+    pub(crate) account_effective_permissions: StorageBlock<'world, AccountId, Permissions>,
     /// Triggers
     pub(crate) triggers: TriggerSetBlock<'world>,
     /// Runtime Executor
@@ -104,6 +143,8 @@ pub struct WorldBlock<'world> {
     pub(crate) executor_data_model: CellBlock<'world, ExecutorDataModel>,
     /// Events produced during execution of block
     events_buffer: Vec<EventBox>,
+    /// Tracer of the most accessed keys
+    hot_keys: Option<&'world HotKeys>,
 }
 
 /// Struct for single transaction's aggregated changes
@@ -114,12 +155,26 @@ pub struct WorldTransaction<'block, 'world> {
     pub(crate) trusted_peers_ids: CellTransaction<'block, 'world, PeersIds>,
     /// Registered domains.
     pub(crate) domains: StorageTransaction<'block, 'world, DomainId, Domain>,
+    /// Registered accounts.
+    pub(crate) accounts: StorageTransaction<'block, 'world, AccountId, Account>,
+    /// Registered assets.
+    pub(crate) assets: StorageTransaction<'block, 'world, AccountIdWithAssetDefinition, Asset>,
+    /// Holders of assets of an asset definition.
+    pub(crate) asset_holders: StorageTransaction<'block, 'world, AssetDefinitionIdWithHolder, ()>,
+    /// Asset definitions ordered by their name.
+    pub(crate) asset_definitions_by_name:
+        StorageTransaction<'block, 'world, AssetDefinitionIdWithName, ()>,
     /// Roles. [`Role`] pairs.
     pub(crate) roles: StorageTransaction<'block, 'world, RoleId, Role>,
     /// Permission tokens of an account.
     pub(crate) account_permissions: StorageTransaction<'block, 'world, AccountId, Permissions>,
     /// Roles of an account.
     pub(crate) account_roles: StorageTransaction<'block, 'world, RoleIdWithOwner, ()>,
+    /// Holders of a role.
+    pub(crate) role_holders: StorageTransaction<'block, 'world, RoleIdWithHolder, ()>,
+    /// Permission tokens of an account, both inherent and granted through roles.
+    pub(crate) account_effective_permissions:
+        StorageTransaction<'block, 'world, AccountId, Permissions>,
     /// Triggers
     pub(crate) triggers: TriggerSetTransaction<'block, 'world>,
     /// Runtime Executor
@@ -128,6 +183,8 @@ pub struct WorldTransaction<'block, 'world> {
     pub(crate) executor_data_model: CellTransaction<'block, 'world, ExecutorDataModel>,
     /// Events produced during execution of a transaction
     events_buffer: TransactionEventBuffer<'block>,
+    /// Tracer of the most accessed keys
+    hot_keys: Option<&'world HotKeys>,
 }
 
 /// Wrapper for event's buffer to apply transaction rollback
@@ -146,12 +203,24 @@ pub struct WorldView<'world> {
     pub(crate) trusted_peers_ids: CellView<'world, PeersIds>,
     /// Registered domains.
     pub(crate) domains: StorageView<'world, DomainId, Domain>,
+    /// Registered accounts.
+    pub(crate) accounts: StorageView<'world, AccountId, Account>,
+    /// Registered assets.
+    pub(crate) assets: StorageView<'world, AccountIdWithAssetDefinition, Asset>,
+    /// Holders of assets of an asset definition.
+    pub(crate) asset_holders: StorageView<'world, AssetDefinitionIdWithHolder, ()>,
+    /// Asset definitions ordered by their name.
+    pub(crate) asset_definitions_by_name: StorageView<'world, AssetDefinitionIdWithName, ()>,
     /// Roles. [`Role`] pairs.
     pub(crate) roles: StorageView<'world, RoleId, Role>,
     /// Permission tokens of an account.
     pub(crate) account_permissions: StorageView<'world, AccountId, Permissions>,
     /// Roles of an account.
     pub(crate) account_roles: StorageView<'world, RoleIdWithOwner, ()>,
+    /// Holders of a role.
+    pub(crate) role_holders: StorageView<'world, RoleIdWithHolder, ()>,
+    /// Permission tokens of an account, both inherent and granted through roles.
+    pub(crate) account_effective_permissions: StorageView<'world, AccountId, Permissions>,
     /// Triggers
     pub(crate) triggers: TriggerSetView<'world>,
     /// Runtime Executor
@@ -168,10 +237,9 @@ pub struct State {
     /// Configuration of World State View.
     pub config: Cell<Config>,
     /// Blockchain.
-    // TODO: Cell is redundant here since block_hashes is very easy to rollback by just popping the last element
-    pub block_hashes: Cell<Vec<HashOf<SignedBlock>>>,
+    pub block_hashes: Cell<BlockHashes>,
     /// Hashes of transactions mapped onto block height where they stored
-    pub transactions: Storage<HashOf<SignedTransaction>, u64>,
+    pub transactions: TxSet,
     /// Engine for WASM [`Runtime`](wasm::Runtime) to execute triggers.
     #[serde(skip)]
     pub engine: wasmtime::Engine,
@@ -186,6 +254,12 @@ pub struct State {
     /// TODO: this should be done through events
     #[serde(skip)]
     pub new_tx_amounts: Arc<Mutex<Vec<f64>>>,
+    /// Tracer of the most accessed keys, [`None`] if tracing is disabled.
+    #[serde(skip)]
+    pub hot_keys: Option<HotKeys>,
+    /// Commitment to the world state, rebuilt from the world when the state is loaded.
+    #[serde(skip)]
+    pub state_root: StateRoot,
 }
 
 /// Struct for block's aggregated changes
@@ -195,9 +269,11 @@ pub struct StateBlock<'state> {
     /// Configuration of World State View.
     pub config: CellBlock<'state, Config>,
     /// Blockchain.
-    pub block_hashes: CellBlock<'state, Vec<HashOf<SignedBlock>>>,
+    pub block_hashes: CellBlock<'state, BlockHashes>,
     /// Hashes of transactions mapped onto block height where they stored
-    pub transactions: StorageBlock<'state, HashOf<SignedTransaction>, u64>,
+    pub transactions: TxSetBlock<'state>,
+    /// Commitment to the world state, updated when the block is applied.
+    pub state_root: StateRootBlock<'state>,
     /// Engine for WASM [`Runtime`](wasm::Runtime) to execute triggers.
     pub engine: &'state wasmtime::Engine,
 
@@ -217,9 +293,9 @@ pub struct StateTransaction<'block, 'state> {
     /// Configuration of World State View.
     pub config: CellTransaction<'block, 'state, Config>,
     /// Blockchain.
-    pub block_hashes: CellTransaction<'block, 'state, Vec<HashOf<SignedBlock>>>,
+    pub block_hashes: CellTransaction<'block, 'state, BlockHashes>,
     /// Hashes of transactions mapped onto block height where they stored
-    pub transactions: StorageTransaction<'block, 'state, HashOf<SignedTransaction>, u64>,
+    pub transactions: TxSetTransaction<'block, 'state>,
     /// Engine for WASM [`Runtime`](wasm::Runtime) to execute triggers.
     pub engine: &'state wasmtime::Engine,
 
@@ -239,9 +315,11 @@ pub struct StateView<'state> {
     /// Configuration of World State View.
     pub config: CellView<'state, Config>,
     /// Blockchain.
-    pub block_hashes: CellView<'state, Vec<HashOf<SignedBlock>>>,
+    pub block_hashes: CellView<'state, BlockHashes>,
     /// Hashes of transactions mapped onto block height where they stored
-    pub transactions: StorageView<'state, HashOf<SignedTransaction>, u64>,
+    pub transactions: TxSetView<'state>,
+    /// Commitment to the world state.
+    pub state_root: StateRootView<'state>,
     /// Engine for WASM [`Runtime`](wasm::Runtime) to execute triggers.
     pub engine: &'state wasmtime::Engine,
 
@@ -260,35 +338,132 @@ impl World {
         Self::default()
     }
 
-    /// Creates a [`World`] with these [`Domain`]s and trusted [`PeerId`]s.
-    pub fn with<D>(domains: D, trusted_peers_ids: PeersIds) -> Self
+    /// Creates a [`World`] with these [`Domain`]s, [`Account`]s and trusted [`PeerId`]s.
+    pub fn with<D, A>(domains: D, accounts: A, trusted_peers_ids: PeersIds) -> Self
+    where
+        D: IntoIterator<Item = Domain>,
+        A: IntoIterator<Item = Account>,
+    {
+        Self::with_assets(domains, accounts, [], trusted_peers_ids)
+    }
+
+    /// Creates a [`World`] with these [`Domain`]s, [`Account`]s, [`Asset`]s and trusted [`PeerId`]s.
+    pub fn with_assets<D, A, S>(
+        domains: D,
+        accounts: A,
+        assets: S,
+        trusted_peers_ids: PeersIds,
+    ) -> Self
     where
         D: IntoIterator<Item = Domain>,
+        A: IntoIterator<Item = Account>,
+        S: IntoIterator<Item = Asset>,
     {
-        let domains = domains
+        let domains: Storage<_, _> = domains
             .into_iter()
             .map(|domain| (domain.id().clone(), domain))
             .collect();
+        let asset_definitions_by_name = Self::asset_definitions_by_name_of(&domains);
+        let accounts = accounts
+            .into_iter()
+            .map(|account| (account.id().clone(), account))
+            .collect();
+        let assets: Storage<_, _> = assets
+            .into_iter()
+            .map(|asset| (asset.id().clone().into(), asset))
+            .collect();
+        let asset_holders = Self::asset_holders_of(&assets);
         World {
             trusted_peers_ids: Cell::new(trusted_peers_ids),
             domains,
+            accounts,
+            assets,
+            asset_holders,
+            asset_definitions_by_name,
             ..World::new()
         }
     }
 
+    /// Index definitions of `domains` by their name.
+    pub(crate) fn asset_definitions_by_name_of(
+        domains: &Storage<DomainId, Domain>,
+    ) -> Storage<AssetDefinitionIdWithName, ()> {
+        domains
+            .view()
+            .iter()
+            .flat_map(|(_, domain)| domain.asset_definitions.keys())
+            .map(|definition_id| (definition_id.clone().into(), ()))
+            .collect()
+    }
+
+    /// Index holders of every asset in `assets` by asset definition.
+    pub(crate) fn asset_holders_of(
+        assets: &Storage<AccountIdWithAssetDefinition, Asset>,
+    ) -> Storage<AssetDefinitionIdWithHolder, ()> {
+        assets
+            .view()
+            .iter()
+            .map(|(_, asset)| (asset.id().clone().into(), ()))
+            .collect()
+    }
+
+    /// Compute permission tokens of every account, both inherent and granted through roles.
+    pub(crate) fn account_effective_permissions_of(
+        account_permissions: &Storage<AccountId, Permissions>,
+        roles: &Storage<RoleId, Role>,
+        account_roles: &Storage<RoleIdWithOwner, ()>,
+    ) -> Storage<AccountId, Permissions> {
+        let mut effective = account_permissions
+            .view()
+            .iter()
+            .map(|(account_id, permissions)| (account_id.clone(), permissions.clone()))
+            .collect::<BTreeMap<_, _>>();
+        let roles = roles.view();
+        for (role, ()) in account_roles.view().iter() {
+            if let Some(granted) = roles.get(&role.role_id) {
+                effective
+                    .entry(role.account_id.clone())
+                    .or_default()
+                    .extend(granted.permissions.iter().cloned());
+            }
+        }
+        effective
+            .into_iter()
+            .filter(|(_, permissions)| !permissions.is_empty())
+            .collect()
+    }
+
+    /// Index holders of every role granted in `account_roles`.
+    pub(crate) fn role_holders_of(
+        account_roles: &Storage<RoleIdWithOwner, ()>,
+    ) -> Storage<RoleIdWithHolder, ()> {
+        account_roles
+            .view()
+            .iter()
+            .map(|(role, ())| (role.clone().into(), ()))
+            .collect()
+    }
+
     /// Create struct to apply block's changes
     pub fn block(&self) -> WorldBlock {
         WorldBlock {
             parameters: self.parameters.block(),
             trusted_peers_ids: self.trusted_peers_ids.block(),
             domains: self.domains.block(),
+            accounts: self.accounts.block(),
+            assets: self.assets.block(),
+            asset_holders: self.asset_holders.block(),
+            asset_definitions_by_name: self.asset_definitions_by_name.block(),
             roles: self.roles.block(),
             account_permissions: self.account_permissions.block(),
             account_roles: self.account_roles.block(),
+            role_holders: self.role_holders.block(),
+            account_effective_permissions: self.account_effective_permissions.block(),
             triggers: self.triggers.block(),
             executor: self.executor.block(),
             executor_data_model: self.executor_data_model.block(),
             events_buffer: Vec::new(),
+            hot_keys: None,
         }
     }
 
@@ -298,13 +473,20 @@ impl World {
             parameters: self.parameters.block_and_revert(),
             trusted_peers_ids: self.trusted_peers_ids.block_and_revert(),
             domains: self.domains.block_and_revert(),
+            accounts: self.accounts.block_and_revert(),
+            assets: self.assets.block_and_revert(),
+            asset_holders: self.asset_holders.block_and_revert(),
+            asset_definitions_by_name: self.asset_definitions_by_name.block_and_revert(),
             roles: self.roles.block_and_revert(),
             account_permissions: self.account_permissions.block_and_revert(),
             account_roles: self.account_roles.block_and_revert(),
+            role_holders: self.role_holders.block_and_revert(),
+            account_effective_permissions: self.account_effective_permissions.block_and_revert(),
             triggers: self.triggers.block_and_revert(),
             executor: self.executor.block_and_revert(),
             executor_data_model: self.executor_data_model.block_and_revert(),
             events_buffer: Vec::new(),
+            hot_keys: None,
         }
     }
 
@@ -314,9 +496,15 @@ impl World {
             parameters: self.parameters.view(),
             trusted_peers_ids: self.trusted_peers_ids.view(),
             domains: self.domains.view(),
+            accounts: self.accounts.view(),
+            assets: self.assets.view(),
+            asset_holders: self.asset_holders.view(),
+            asset_definitions_by_name: self.asset_definitions_by_name.view(),
             roles: self.roles.view(),
             account_permissions: self.account_permissions.view(),
             account_roles: self.account_roles.view(),
+            role_holders: self.role_holders.view(),
+            account_effective_permissions: self.account_effective_permissions.view(),
             triggers: self.triggers.view(),
             executor: self.executor.view(),
             executor_data_model: self.executor_data_model.view(),
@@ -330,13 +518,33 @@ pub trait WorldReadOnly {
     fn parameters(&self) -> &Parameters;
     fn trusted_peers_ids(&self) -> &PeersIds;
     fn domains(&self) -> &impl StorageReadOnly<DomainId, Domain>;
+    fn accounts(&self) -> &impl StorageReadOnly<AccountId, Account>;
+    fn assets(&self) -> &impl StorageReadOnly<AccountIdWithAssetDefinition, Asset>;
+    fn asset_holders(&self) -> &impl StorageReadOnly<AssetDefinitionIdWithHolder, ()>;
+    fn asset_definitions_by_name(&self) -> &impl StorageReadOnly<AssetDefinitionIdWithName, ()>;
     fn roles(&self) -> &impl StorageReadOnly<RoleId, Role>;
     fn account_permissions(&self) -> &impl StorageReadOnly<AccountId, Permissions>;
     fn account_roles(&self) -> &impl StorageReadOnly<RoleIdWithOwner, ()>;
+    fn role_holders(&self) -> &impl StorageReadOnly<RoleIdWithHolder, ()>;
+    fn account_effective_permissions(&self) -> &impl StorageReadOnly<AccountId, Permissions>;
     fn triggers(&self) -> &impl TriggerSetReadOnly;
     fn executor(&self) -> &Executor;
     fn executor_data_model(&self) -> &ExecutorDataModel;
 
+    /// Tracer of the most accessed keys, if tracing is enabled
+    #[inline]
+    fn hot_keys(&self) -> Option<&HotKeys> {
+        None
+    }
+
+    /// Record an access to the key produced by `key` if tracing is enabled
+    #[inline]
+    fn trace_hot_key(&self, access: Access, key: impl FnOnce() -> HotKey) {
+        if let Some(hot_keys) = self.hot_keys() {
+            hot_keys.record(access, key);
+        }
+    }
+
     // Domain-related methods
 
     /// Get `Domain` without an ability to modify it.
@@ -378,12 +586,12 @@ pub trait WorldReadOnly {
     /// # Errors
     /// Fails if there is no domain or account
     fn account(&self, id: &AccountId) -> Result<&Account, FindError> {
-        self.domain(&id.domain_id).and_then(|domain| {
-            domain
-                .accounts
-                .get(id)
-                .ok_or_else(|| FindError::Account(id.clone()))
-        })
+        self.trace_hot_key(Access::Read, || HotKey::Account(id.clone()));
+        if let Some(account) = self.accounts().get(id) {
+            return Ok(account);
+        }
+        self.domain(&id.domain_id)?;
+        Err(FindError::Account(id.clone()))
     }
 
     /// Get `Account` and pass it to closure.
@@ -395,24 +603,49 @@ pub trait WorldReadOnly {
         id: &AccountId,
         f: impl FnOnce(&'slf Account) -> T,
     ) -> Result<T, QueryExecutionFail> {
-        let domain = self.domain(&id.domain_id)?;
-        let account = domain
-            .accounts
-            .get(id)
-            .ok_or(FindError::Account(id.clone()))?;
+        let account = self.account(id)?;
         Ok(f(account))
     }
 
+    /// Returns reference for accounts map
+    #[inline]
+    fn accounts_iter(&self) -> impl Iterator<Item = &Account> {
+        self.accounts().iter().map(|(_, account)| account)
+    }
+
+    /// Get an iterator over [`Account`]s of the [`Domain`]
+    // NOTE: have to use concreate type because don't want to capture lifetme of `id`
+    #[allow(clippy::type_complexity)]
+    fn accounts_in_domain_iter<'slf>(
+        &'slf self,
+        id: &DomainId,
+    ) -> core::iter::Map<
+        RangeIter<'slf, AccountId, Account>,
+        fn((&'slf AccountId, &'slf Account)) -> &'slf Account,
+    > {
+        self.accounts()
+            .range(AccountByDomainBounds::new(id))
+            .map(|(_, account)| account)
+    }
+
     /// Get `Account`'s `Asset`s
     ///
     /// # Errors
     /// Fails if there is no domain or account
-    fn account_assets(
-        &self,
+    // NOTE: have to use concreate type because don't want to capture lifetme of `id`
+    #[allow(clippy::type_complexity)]
+    fn account_assets<'slf>(
+        &'slf self,
         id: &AccountId,
-    ) -> Result<std::collections::btree_map::Values<'_, AssetDefinitionId, Asset>, QueryExecutionFail>
-    {
-        self.map_account(id, |account| account.assets.values())
+    ) -> Result<
+        core::iter::Map<
+            RangeIter<'slf, AccountIdWithAssetDefinition, Asset>,
+            fn((&'slf AccountIdWithAssetDefinition, &'slf Asset)) -> &'slf Asset,
+        >,
+        QueryExecutionFail,
+    > {
+        self.account(id)?;
+        Ok(self.assets_in_account_iter(id))
     }
 
     /// Get [`Account`]'s [`RoleId`]s
@@ -430,6 +663,21 @@ pub trait WorldReadOnly {
             .map(|(role, ())| &role.role_id)
     }
 
+    /// Get an iterator over [`AccountId`]s of the holders of the [`Role`]
+    // NOTE: have to use concreate type because don't want to capture lifetme of `id`
+    #[allow(clippy::type_complexity)]
+    fn role_holders_iter<'slf>(
+        &'slf self,
+        id: &RoleId,
+    ) -> core::iter::Map<
+        RangeIter<'slf, RoleIdWithHolder, ()>,
+        fn((&'slf RoleIdWithHolder, &'slf ())) -> &'slf AccountId,
+    > {
+        self.role_holders()
+            .range(HolderByRoleBounds::new(id))
+            .map(|(holder, ())| &holder.account_id)
+    }
+
     /// Return a set of all permission tokens granted to this account.
     ///
     /// # Errors
@@ -438,20 +686,13 @@ pub trait WorldReadOnly {
     fn account_permissions_iter<'slf>(
         &'slf self,
         account_id: &AccountId,
-    ) -> Result<std::collections::btree_set::IntoIter<&'slf Permission>, FindError> {
+    ) -> Result<std::collections::btree_set::Iter<'slf, Permission>, FindError> {
         self.account(account_id)?;
 
-        let mut tokens = self
-            .account_inherent_permissions(account_id)
-            .collect::<BTreeSet<_>>();
-
-        for role_id in self.account_roles_iter(account_id) {
-            if let Some(role) = self.roles().get(role_id) {
-                tokens.extend(role.permissions.iter());
-            }
-        }
-
-        Ok(tokens.into_iter())
+        Ok(self
+            .account_effective_permissions()
+            .get(account_id)
+            .map_or_else(Default::default, std::collections::BTreeSet::iter))
     }
 
     /// Return a set of permission tokens granted to this account not as part of any role.
@@ -489,16 +730,66 @@ pub trait WorldReadOnly {
     /// - The [`Account`] with which the [`Asset`] is associated doesn't exist.
     /// - The [`Domain`] with which the [`Account`] is associated doesn't exist.
     fn asset(&self, id: &AssetId) -> Result<Asset, QueryExecutionFail> {
-        self.map_account(
-            &id.account_id,
-            |account| -> Result<Asset, QueryExecutionFail> {
-                account
-                    .assets
-                    .get(&id.definition_id)
-                    .ok_or_else(|| QueryExecutionFail::from(FindError::Asset(id.clone())))
-                    .cloned()
-            },
-        )?
+        self.trace_hot_key(Access::Read, || HotKey::Account(id.account_id.clone()));
+        if let Some(asset) = self
+            .assets()
+            .get(&AccountIdWithAssetDefinition::from(id.clone()))
+        {
+            return Ok(asset.clone());
+        }
+        self.account(&id.account_id)?;
+        Err(FindError::Asset(id.clone()).into())
+    }
+
+    /// Returns reference for assets map
+    #[inline]
+    fn assets_iter(&self) -> impl Iterator<Item = &Asset> {
+        self.assets().iter().map(|(_, asset)| asset)
+    }
+
+    /// Get an iterator over [`AccountId`]s of the holders of assets of the [`AssetDefinition`]
+    // NOTE: have to use concreate type because don't want to capture lifetme of `id`
+    #[allow(clippy::type_complexity)]
+    fn asset_holders_iter<'slf>(
+        &'slf self,
+        id: &AssetDefinitionId,
+    ) -> core::iter::Map<
+        RangeIter<'slf, AssetDefinitionIdWithHolder, ()>,
+        fn((&'slf AssetDefinitionIdWithHolder, &'slf ())) -> &'slf AccountId,
+    > {
+        self.asset_holders()
+            .range(HolderByAssetDefinitionBounds::new(id))
+            .map(|(holder, ())| &holder.account_id)
+    }
+
+    /// Get an iterator over [`AssetDefinitionId`]s with the given [`Name`]
+    // NOTE: have to use concreate type because don't want to capture lifetme of `name`
+    #[allow(clippy::type_complexity)]
+    fn asset_definitions_by_name_iter<'slf>(
+        &'slf self,
+        name: &Name,
+    ) -> core::iter::Map<
+        RangeIter<'slf, AssetDefinitionIdWithName, ()>,
+        fn((&'slf AssetDefinitionIdWithName, &'slf ())) -> &'slf AssetDefinitionId,
+    > {
+        self.asset_definitions_by_name()
+            .range(AssetDefinitionByNameBounds::new(name))
+            .map(|(key, ())| &key.definition_id)
+    }
+
+    /// Get an iterator over [`Asset`]s of the [`Account`]
+    // NOTE: have to use concreate type because don't want to capture lifetme of `id`
+    #[allow(clippy::type_complexity)]
+    fn assets_in_account_iter<'slf>(
+        &'slf self,
+        id: &AccountId,
+    ) -> core::iter::Map<
+        RangeIter<'slf, AccountIdWithAssetDefinition, Asset>,
+        fn((&'slf AccountIdWithAssetDefinition, &'slf Asset)) -> &'slf Asset,
+    > {
+        self.assets()
+            .range(AssetByAccountBounds::new(id))
+            .map(|(_, asset)| asset)
     }
 
     // AssetDefinition-related methods
@@ -508,6 +799,7 @@ pub trait WorldReadOnly {
     /// # Errors
     /// - Asset definition entry not found
     fn asset_definition(&self, asset_id: &AssetDefinitionId) -> Result<AssetDefinition, FindError> {
+        self.trace_hot_key(Access::Read, || HotKey::AssetDefinition(asset_id.clone()));
         self.domain(&asset_id.domain_id)?
             .asset_definitions
             .get(asset_id)
@@ -560,7 +852,7 @@ pub trait WorldReadOnly {
 }
 
 macro_rules! impl_world_ro {
-    ($($ident:ty),*) => {$(
+    ($($ident:ty $({ $($item:item)* })?),*) => {$(
         impl WorldReadOnly for $ident {
             fn parameters(&self) -> &Parameters {
                 &self.parameters
@@ -571,6 +863,18 @@ macro_rules! impl_world_ro {
             fn domains(&self) -> &impl StorageReadOnly<DomainId, Domain> {
                 &self.domains
             }
+            fn accounts(&self) -> &impl StorageReadOnly<AccountId, Account> {
+                &self.accounts
+            }
+            fn assets(&self) -> &impl StorageReadOnly<AccountIdWithAssetDefinition, Asset> {
+                &self.assets
+            }
+            fn asset_holders(&self) -> &impl StorageReadOnly<AssetDefinitionIdWithHolder, ()> {
+                &self.asset_holders
+            }
+            fn asset_definitions_by_name(&self) -> &impl StorageReadOnly<AssetDefinitionIdWithName, ()> {
+                &self.asset_definitions_by_name
+            }
             fn roles(&self) -> &impl StorageReadOnly<RoleId, Role> {
                 &self.roles
             }
@@ -580,6 +884,12 @@ macro_rules! impl_world_ro {
             fn account_roles(&self) -> &impl StorageReadOnly<RoleIdWithOwner, ()> {
                 &self.account_roles
             }
+            fn role_holders(&self) -> &impl StorageReadOnly<RoleIdWithHolder, ()> {
+                &self.role_holders
+            }
+            fn account_effective_permissions(&self) -> &impl StorageReadOnly<AccountId, Permissions> {
+                &self.account_effective_permissions
+            }
             fn triggers(&self) -> &impl TriggerSetReadOnly {
                 &self.triggers
             }
@@ -589,12 +899,19 @@ macro_rules! impl_world_ro {
             fn executor_data_model(&self) -> &ExecutorDataModel {
                 &self.executor_data_model
             }
+            $($($item)*)?
         }
     )*};
 }
 
 impl_world_ro! {
-    WorldBlock<'_>, WorldTransaction<'_, '_>, WorldView<'_>
+    WorldBlock<'_>,
+    WorldTransaction<'_, '_> {
+        fn hot_keys(&self) -> Option<&HotKeys> {
+            self.hot_keys
+        }
+    },
+    WorldView<'_>
 }
 
 impl<'world> WorldBlock<'world> {
@@ -604,9 +921,15 @@ impl<'world> WorldBlock<'world> {
             parameters: self.parameters.transaction(),
             trusted_peers_ids: self.trusted_peers_ids.transaction(),
             domains: self.domains.transaction(),
+            accounts: self.accounts.transaction(),
+            assets: self.assets.transaction(),
+            asset_holders: self.asset_holders.transaction(),
+            asset_definitions_by_name: self.asset_definitions_by_name.transaction(),
             roles: self.roles.transaction(),
             account_permissions: self.account_permissions.transaction(),
             account_roles: self.account_roles.transaction(),
+            role_holders: self.role_holders.transaction(),
+            account_effective_permissions: self.account_effective_permissions.transaction(),
             triggers: self.triggers.transaction(),
             executor: self.executor.transaction(),
             executor_data_model: self.executor_data_model.transaction(),
@@ -614,18 +937,34 @@ impl<'world> WorldBlock<'world> {
                 events_buffer: &mut self.events_buffer,
                 events_created_in_transaction: 0,
             },
+            hot_keys: self.hot_keys,
         }
     }
 
+    /// Trace accesses made during execution of the block with `hot_keys`
+    fn trace_hot_keys(mut self, hot_keys: Option<&'world HotKeys>) -> Self {
+        if let Some(hot_keys) = hot_keys {
+            hot_keys.start_block();
+        }
+        self.hot_keys = hot_keys;
+        self
+    }
+
     /// Commit block's changes
     pub fn commit(self) {
         // IMPORTANT!!! Commit fields in reverse order, this way consistent results are insured
         self.executor_data_model.commit();
         self.executor.commit();
         self.triggers.commit();
+        self.account_effective_permissions.commit();
+        self.role_holders.commit();
         self.account_roles.commit();
         self.account_permissions.commit();
         self.roles.commit();
+        self.asset_definitions_by_name.commit();
+        self.asset_holders.commit();
+        self.assets.commit();
+        self.accounts.commit();
         self.domains.commit();
         self.trusted_peers_ids.commit();
         self.parameters.commit();
@@ -638,9 +977,15 @@ impl WorldTransaction<'_, '_> {
         self.executor_data_model.apply();
         self.executor.apply();
         self.triggers.apply();
+        self.account_effective_permissions.apply();
+        self.role_holders.apply();
         self.account_roles.apply();
         self.account_permissions.apply();
         self.roles.apply();
+        self.asset_definitions_by_name.apply();
+        self.asset_holders.apply();
+        self.assets.apply();
+        self.accounts.apply();
         self.domains.apply();
         self.trusted_peers_ids.apply();
         self.parameters.apply();
@@ -664,12 +1009,35 @@ impl WorldTransaction<'_, '_> {
     /// # Errors
     /// Fail if domain or account not found
     pub fn account_mut(&mut self, id: &AccountId) -> Result<&mut Account, FindError> {
-        self.domain_mut(&id.domain_id).and_then(move |domain| {
-            domain
-                .accounts
-                .get_mut(id)
-                .ok_or_else(|| FindError::Account(id.clone()))
-        })
+        self.trace_hot_key(Access::Write, || HotKey::Account(id.clone()));
+        if self.accounts.get(id).is_none() {
+            self.domain(&id.domain_id)?;
+            return Err(FindError::Account(id.clone()));
+        }
+        Ok(self
+            .accounts
+            .get_mut(id)
+            .expect("Account is checked to exist above"))
+    }
+
+    /// Remove [`Account`] together with its [`Asset`]s and return it
+    ///
+    /// # Errors
+    /// Fail if domain or account not found
+    pub fn remove_account(&mut self, id: &AccountId) -> Result<Account, FindError> {
+        let Some(account) = self.accounts.remove(id.clone()) else {
+            self.domain(&id.domain_id)?;
+            return Err(FindError::Account(id.clone()));
+        };
+        let assets = self
+            .assets_in_account_iter(id)
+            .map(|asset| asset.id().clone())
+            .collect::<Vec<_>>();
+        for asset_id in assets {
+            self.assets.remove(asset_id.clone().into());
+            self.asset_holders.remove(asset_id.into());
+        }
+        Ok(account)
     }
 
     /// Add [`permission`](Permission) to the [`Account`] if the account does not have this permission yet.
@@ -677,7 +1045,7 @@ impl WorldTransaction<'_, '_> {
     /// Return a Boolean value indicating whether or not the  [`Account`] already had this permission.
     pub fn add_account_permission(&mut self, account: &AccountId, token: Permission) -> bool {
         // `match` here instead of `map_or_else` to avoid cloning token into each closure
-        match self.account_permissions.get_mut(account) {
+        let had_permission = match self.account_permissions.get_mut(account) {
             None => {
                 self.account_permissions
                     .insert(account.clone(), BTreeSet::from([token]));
@@ -690,15 +1058,94 @@ impl WorldTransaction<'_, '_> {
                 permissions.insert(token);
                 false
             }
-        }
+        };
+        self.update_account_effective_permissions(account);
+        had_permission
     }
 
     /// Remove a [`permission`](Permission) from the [`Account`] if the account has this permission.
     /// Return a Boolean value indicating whether the [`Account`] had this permission.
     pub fn remove_account_permission(&mut self, account: &AccountId, token: &Permission) -> bool {
-        self.account_permissions
+        let removed = self
+            .account_permissions
             .get_mut(account)
-            .map_or(false, |permissions| permissions.remove(token))
+            .map_or(false, |permissions| permissions.remove(token));
+        if removed {
+            self.update_account_effective_permissions(account);
+        }
+        removed
+    }
+
+    /// Recompute permission tokens of the [`Account`] from its inherent tokens and the tokens of its roles.
+    ///
+    /// Must be called after any change to inherent permissions or roles of the account.
+    pub fn update_account_effective_permissions(&mut self, account: &AccountId) {
+        let mut permissions = self
+            .account_inherent_permissions(account)
+            .cloned()
+            .collect::<Permissions>();
+        for role_id in self.account_roles_iter(account) {
+            if let Some(role) = self.roles.get(role_id) {
+                permissions.extend(role.permissions.iter().cloned());
+            }
+        }
+
+        if permissions.is_empty() {
+            self.account_effective_permissions.remove(account.clone());
+        } else {
+            self.account_effective_permissions
+                .insert(account.clone(), permissions);
+        }
+    }
+
+    /// Recompute permission tokens of every [`Account`] granted the [`Role`].
+    ///
+    /// Must be called after the role is replaced as a whole.
+    pub fn update_role_effective_permissions(&mut self, role_id: &RoleId) {
+        let holders = self.role_holders_iter(role_id).cloned().collect::<Vec<_>>();
+        for account_id in holders {
+            self.update_account_effective_permissions(&account_id);
+        }
+    }
+
+    /// Add a permission `token` just granted to the [`Role`] to the tokens of every [`Account`]
+    /// granted the role.
+    pub fn add_role_permission_to_holders(&mut self, role_id: &RoleId, token: &Permission) {
+        let holders = self.role_holders_iter(role_id).cloned().collect::<Vec<_>>();
+        for account_id in holders {
+            if let Some(permissions) = self.account_effective_permissions.get_mut(&account_id) {
+                permissions.insert(token.clone());
+            } else {
+                self.account_effective_permissions
+                    .insert(account_id, BTreeSet::from([token.clone()]));
+            }
+        }
+    }
+
+    /// Remove a permission `token` just revoked from the [`Role`] from the tokens of every
+    /// [`Account`] granted the role.
+    ///
+    /// The token is kept for accounts which have it inherently or through another role.
+    pub fn remove_role_permission_from_holders(&mut self, role_id: &RoleId, token: &Permission) {
+        let holders = self.role_holders_iter(role_id).cloned().collect::<Vec<_>>();
+        for account_id in holders {
+            let still_granted = self.account_contains_inherent_permission(&account_id, token)
+                || self.account_roles_iter(&account_id).any(|role_id| {
+                    self.roles
+                        .get(role_id)
+                        .map_or(false, |role| role.permissions.contains(token))
+                });
+            if still_granted {
+                continue;
+            }
+            let Some(permissions) = self.account_effective_permissions.get_mut(&account_id) else {
+                continue;
+            };
+            permissions.remove(token);
+            if permissions.is_empty() {
+                self.account_effective_permissions.remove(account_id);
+            }
+        }
     }
 
     /// Get mutable reference to [`Asset`]
@@ -706,12 +1153,16 @@ impl WorldTransaction<'_, '_> {
     /// # Errors
     /// If domain, account or asset not found
     pub fn asset_mut(&mut self, id: &AssetId) -> Result<&mut Asset, FindError> {
-        self.account_mut(&id.account_id).and_then(move |account| {
-            account
-                .assets
-                .get_mut(&id.definition_id)
-                .ok_or_else(|| FindError::Asset(id.clone()))
-        })
+        self.trace_hot_key(Access::Write, || HotKey::Account(id.account_id.clone()));
+        let key = AccountIdWithAssetDefinition::from(id.clone());
+        if self.assets.get(&key).is_none() {
+            self.account(&id.account_id)?;
+            return Err(FindError::Asset(id.clone()));
+        }
+        Ok(self
+            .assets
+            .get_mut(&key)
+            .expect("Asset is checked to exist above"))
     }
 
     /// Get asset or inserts new with `default_asset_value`.
@@ -724,6 +1175,9 @@ impl WorldTransaction<'_, '_> {
         asset_id: AssetId,
         default_asset_value: impl Into<AssetValue>,
     ) -> Result<&mut Asset, Error> {
+        self.trace_hot_key(Access::Write, || {
+            HotKey::Account(asset_id.account_id.clone())
+        });
         // Check that asset definition exists
         {
             let asset_definition_id = &asset_id.definition_id;
@@ -738,28 +1192,34 @@ impl WorldTransaction<'_, '_> {
                 .ok_or(FindError::AssetDefinition(asset_definition_id.clone()))?;
         }
 
-        let account_id = &asset_id.account_id;
-        let account_domain = self
-            .domains
-            .get_mut(&asset_id.account_id.domain_id)
-            .ok_or(FindError::Domain(asset_id.account_id.domain_id.clone()))?;
-        let account = account_domain
-            .accounts
-            .get_mut(account_id)
-            .ok_or(FindError::Account(account_id.clone()))?;
+        self.account(&asset_id.account_id)?;
 
-        Ok(account
-            .assets
-            .entry(asset_id.definition_id.clone())
-            .or_insert_with(|| {
-                let asset = Asset::new(asset_id, default_asset_value.into());
-                Self::emit_events_impl(
-                    &mut self.triggers,
-                    &mut self.events_buffer,
-                    Some(AccountEvent::Asset(AssetEvent::Created(asset.clone()))),
-                );
-                asset
-            }))
+        let key = AccountIdWithAssetDefinition::from(asset_id.clone());
+        if self.assets.get(&key).is_none() {
+            let asset = Asset::new(asset_id.clone(), default_asset_value.into());
+            Self::emit_events_impl(
+                &mut self.triggers,
+                &mut self.events_buffer,
+                Some(AccountEvent::Asset(AssetEvent::Created(asset.clone()))),
+            );
+            self.assets.insert(key.clone(), asset);
+            self.asset_holders.insert(asset_id.into(), ());
+        }
+        Ok(self.assets.get_mut(&key).expect("Asset is inserted above"))
+    }
+
+    /// Remove [`Asset`] and return it
+    ///
+    /// # Errors
+    /// If domain, account or asset not found
+    pub fn remove_asset(&mut self, id: &AssetId) -> Result<Asset, FindError> {
+        self.trace_hot_key(Access::Write, || HotKey::Account(id.account_id.clone()));
+        if let Some(asset) = self.assets.remove(id.clone().into()) {
+            self.asset_holders.remove(id.clone().into());
+            return Ok(asset);
+        }
+        self.account(&id.account_id)?;
+        Err(FindError::Asset(id.clone()))
     }
 
     /// Get mutable reference to [`AssetDefinition`]
@@ -770,6 +1230,7 @@ impl WorldTransaction<'_, '_> {
         &mut self,
         id: &AssetDefinitionId,
     ) -> Result<&mut AssetDefinition, FindError> {
+        self.trace_hot_key(Access::Write, || HotKey::AssetDefinition(id.clone()));
         self.domain_mut(&id.domain_id).and_then(|domain| {
             domain
                 .asset_definitions
@@ -788,6 +1249,9 @@ impl WorldTransaction<'_, '_> {
         definition_id: &AssetDefinitionId,
         increment: Numeric,
     ) -> Result<(), Error> {
+        self.trace_hot_key(Access::Write, || {
+            HotKey::AssetDefinition(definition_id.clone())
+        });
         let domain = self.domain_mut(&definition_id.domain_id)?;
         let asset_total_amount: &mut Numeric = domain
             .asset_total_quantities.get_mut(definition_id)
@@ -819,6 +1283,9 @@ impl WorldTransaction<'_, '_> {
         definition_id: &AssetDefinitionId,
         decrement: Numeric,
     ) -> Result<(), Error> {
+        self.trace_hot_key(Access::Write, || {
+            HotKey::AssetDefinition(definition_id.clone())
+        });
         let domain = self.domain_mut(&definition_id.domain_id)?;
         let asset_total_amount: &mut Numeric = domain
             .asset_total_quantities.get_mut(definition_id)
@@ -934,11 +1401,13 @@ impl State {
         query_handle: LiveQueryStoreHandle,
     ) -> Self {
         Self {
+            state_root: StateRoot::from_world(&world),
             world,
             config: Cell::new(config),
-            transactions: Storage::new(),
-            block_hashes: Cell::new(Vec::new()),
+            transactions: TxSet::default(),
+            block_hashes: Cell::new(BlockHashes::default()),
             new_tx_amounts: Arc::new(Mutex::new(Vec::new())),
+            hot_keys: None,
             engine: wasm::create_engine(),
             kura,
             query_handle,
@@ -948,10 +1417,11 @@ impl State {
     /// Create structure to execute a block
     pub fn block(&self) -> StateBlock<'_> {
         StateBlock {
-            world: self.world.block(),
+            world: self.world.block().trace_hot_keys(self.hot_keys.as_ref()),
             config: self.config.block(),
             block_hashes: self.block_hashes.block(),
             transactions: self.transactions.block(),
+            state_root: self.state_root.block(),
             engine: &self.engine,
             kura: &self.kura,
             query_handle: &self.query_handle,
@@ -962,10 +1432,14 @@ impl State {
     /// Create structure to execute a block while reverting changes made in the latest block
     pub fn block_and_revert(&self) -> StateBlock<'_> {
         StateBlock {
-            world: self.world.block_and_revert(),
+            world: self
+                .world
+                .block_and_revert()
+                .trace_hot_keys(self.hot_keys.as_ref()),
             config: self.config.block_and_revert(),
             block_hashes: self.block_hashes.block_and_revert(),
             transactions: self.transactions.block_and_revert(),
+            state_root: self.state_root.block_and_revert(),
             engine: &self.engine,
             kura: &self.kura,
             query_handle: &self.query_handle,
@@ -980,6 +1454,7 @@ impl State {
             config: self.config.view(),
             block_hashes: self.block_hashes.view(),
             transactions: self.transactions.view(),
+            state_root: self.state_root.view(),
             engine: &self.engine,
             kura: &self.kura,
             query_handle: &self.query_handle,
@@ -993,8 +1468,8 @@ impl State {
 pub trait StateReadOnly {
     fn world(&self) -> &impl WorldReadOnly;
     fn config(&self) -> &Config;
-    fn block_hashes(&self) -> &[HashOf<SignedBlock>];
-    fn transactions(&self) -> &impl StorageReadOnly<HashOf<SignedTransaction>, u64>;
+    fn block_hashes(&self) -> &BlockHashes;
+    fn transactions(&self) -> &impl TxSetReadOnly;
     fn engine(&self) -> &wasmtime::Engine;
     fn kura(&self) -> &Kura;
     fn query_handle(&self) -> &LiveQueryStoreHandle;
@@ -1011,7 +1486,7 @@ pub trait StateReadOnly {
 
     /// Return the hash of the latest block
     fn latest_block_hash(&self) -> Option<HashOf<SignedBlock>> {
-        self.block_hashes().iter().nth_back(0).copied()
+        self.block_hashes().last().copied()
     }
 
     /// Return the view change index of the latest block
@@ -1023,17 +1498,22 @@ pub trait StateReadOnly {
 
     /// Return the hash of the block one before the latest block
     fn prev_block_hash(&self) -> Option<HashOf<SignedBlock>> {
-        self.block_hashes().iter().nth_back(1).copied()
+        let block_hashes = self.block_hashes();
+        block_hashes
+            .len()
+            .checked_sub(2)
+            .and_then(|index| block_hashes.get(index))
+            .copied()
     }
 
-    /// Load all blocks in the block chain from disc
+    /// Load all blocks in the block chain from disc, skipping blocks pruned from [`Kura`]
     fn all_blocks(&self) -> impl DoubleEndedIterator<Item = Arc<SignedBlock>> + '_ {
         let block_count = self.block_hashes().len() as u64;
-        (1..=block_count).map(|height| {
-            self.kura()
-                .get_block_by_height(height)
-                .expect("Failed to load block.")
-        })
+        let pruned = self.kura().pruned_block_heights();
+        (1..pruned.start.min(block_count + 1))
+            .chain(pruned.end..=block_count)
+            // Blocks might also be pruned while iterating
+            .filter_map(|height| self.kura().get_block_by_height(height))
     }
 
     /// Return a vector of blockchain blocks after the block with the given `hash`
@@ -1042,7 +1522,7 @@ pub trait StateReadOnly {
         hash: Option<HashOf<SignedBlock>>,
     ) -> Vec<HashOf<SignedBlock>> {
         hash.map_or_else(
-            || self.block_hashes().to_vec(),
+            || self.block_hashes().iter().copied().collect(),
             |block_hash| {
                 self.block_hashes()
                     .iter()
@@ -1057,8 +1537,7 @@ pub trait StateReadOnly {
     /// Return an iterator over blockchain block hashes starting with the block of the given `height`
     fn block_hashes_from_height(&self, height: usize) -> Vec<HashOf<SignedBlock>> {
         self.block_hashes()
-            .iter()
-            .skip(height.saturating_sub(1))
+            .iter_from(height.saturating_sub(1))
             .copied()
             .collect()
     }
@@ -1071,10 +1550,20 @@ pub trait StateReadOnly {
 
     /// Find a [`SignedBlock`] by hash.
     fn block_with_tx(&self, hash: &HashOf<SignedTransaction>) -> Option<Arc<SignedBlock>> {
-        let height = *self.transactions().get(hash)?;
+        let height = self.transactions().get(hash)?;
         self.kura().get_block_by_height(height)
     }
 
+    /// Find a [`SignedBlock`] containing the transaction with the given hash
+    /// together with the position of the transaction in it.
+    fn block_with_tx_position(
+        &self,
+        hash: &HashOf<SignedTransaction>,
+    ) -> Option<(Arc<SignedBlock>, usize)> {
+        let height = self.transactions().get(hash)?;
+        self.kura().get_block_with_transaction(height, hash)
+    }
+
     /// Returns [`Some`] milliseconds since the genesis block was
     /// committed, or [`None`] if it wasn't.
     #[inline]
@@ -1115,10 +1604,10 @@ macro_rules! impl_state_ro {
             fn config(&self) -> &Config {
                 &self.config
             }
-            fn block_hashes(&self) -> &[HashOf<SignedBlock>] {
+            fn block_hashes(&self) -> &BlockHashes {
                 &self.block_hashes
             }
-            fn transactions(&self) -> &impl StorageReadOnly<HashOf<SignedTransaction>, u64> {
+            fn transactions(&self) -> &impl TxSetReadOnly {
                 &self.transactions
             }
             fn engine(&self) -> &wasmtime::Engine {
@@ -1158,10 +1647,16 @@ impl<'state> StateBlock<'state> {
 
     /// Commit changes aggregated during application of block
     pub fn commit(self) {
+        if let Some(hot_keys) = self.world.hot_keys {
+            hot_keys.finish_block(self.height());
+        }
+        let height = self.height();
         self.transactions.commit();
         self.block_hashes.commit();
         self.config.commit();
         self.world.commit();
+        // Committed last so that recorded changes are never ahead of the world
+        self.state_root.commit(height);
     }
 
     /// Commit `CommittedBlock` with changes in form of **Iroha Special
@@ -1252,6 +1747,8 @@ impl<'state> StateBlock<'state> {
             }
             .into(),
         );
+        self.state_root
+            .update(&self.world, &self.world.events_buffer);
         core::mem::take(&mut self.world.events_buffer)
     }
 
@@ -1400,6 +1897,8 @@ impl StateTransaction<'_, '_> {
     ) -> Result<()> {
         use triggers::set::ExecutableRef::*;
         let authority = action.authority();
+        self.world
+            .trace_hot_key(Access::Write, || HotKey::Trigger(id.clone()));
 
         match action.executable() {
             Instructions(instructions) => {
@@ -1431,7 +1930,7 @@ mod range_bounds {
     use iroha_primitives::{cmpext::MinMaxExt, impl_as_dyn_key};
 
     use super::*;
-    use crate::role::RoleIdWithOwner;
+    use crate::role::{RoleIdWithHolder, RoleIdWithOwner};
 
     /// Key for range queries over account for roles
     #[derive(PartialEq, Eq, PartialOrd, Ord, Copy, Clone)]
@@ -1486,9 +1985,318 @@ mod range_bounds {
         key: RoleIdByAccount<'_>,
         trait: AsRoleIdByAccount
     }
+
+    /// Key for range queries over domain for accounts
+    #[derive(PartialEq, Eq, PartialOrd, Ord, Copy, Clone)]
+    pub struct AccountByDomain<'acc> {
+        domain_id: &'acc DomainId,
+        signatory: MinMaxExt<&'acc PublicKey>,
+    }
+
+    /// Bounds for range quired over domain for accounts
+    pub struct AccountByDomainBounds<'acc> {
+        start: AccountByDomain<'acc>,
+        end: AccountByDomain<'acc>,
+    }
+
+    impl<'acc> AccountByDomainBounds<'acc> {
+        /// Create range bounds for range quires of accounts over domain
+        pub fn new(domain_id: &'acc DomainId) -> Self {
+            Self {
+                start: AccountByDomain {
+                    domain_id,
+                    signatory: MinMaxExt::Min,
+                },
+                end: AccountByDomain {
+                    domain_id,
+                    signatory: MinMaxExt::Max,
+                },
+            }
+        }
+    }
+
+    impl<'acc> RangeBounds<dyn AsAccountByDomain + 'acc> for AccountByDomainBounds<'acc> {
+        fn start_bound(&self) -> Bound<&(dyn AsAccountByDomain + 'acc)> {
+            Bound::Excluded(&self.start)
+        }
+
+        fn end_bound(&self) -> Bound<&(dyn AsAccountByDomain + 'acc)> {
+            Bound::Excluded(&self.end)
+        }
+    }
+
+    impl AsAccountByDomain for AccountId {
+        fn as_key(&self) -> AccountByDomain<'_> {
+            AccountByDomain {
+                domain_id: &self.domain_id,
+                signatory: (&self.signatory).into(),
+            }
+        }
+    }
+
+    impl_as_dyn_key! {
+        target: AccountId,
+        key: AccountByDomain<'_>,
+        trait: AsAccountByDomain
+    }
+
+    /// Key for range queries over account for assets
+    #[derive(PartialEq, Eq, PartialOrd, Ord, Copy, Clone)]
+    pub struct AssetByAccount<'asset> {
+        account_id: &'asset AccountId,
+        definition_id: MinMaxExt<&'asset AssetDefinitionId>,
+    }
+
+    /// Bounds for range quired over account for assets
+    pub struct AssetByAccountBounds<'asset> {
+        start: AssetByAccount<'asset>,
+        end: AssetByAccount<'asset>,
+    }
+
+    impl<'asset> AssetByAccountBounds<'asset> {
+        /// Create range bounds for range quires of assets over account
+        pub fn new(account_id: &'asset AccountId) -> Self {
+            Self {
+                start: AssetByAccount {
+                    account_id,
+                    definition_id: MinMaxExt::Min,
+                },
+                end: AssetByAccount {
+                    account_id,
+                    definition_id: MinMaxExt::Max,
+                },
+            }
+        }
+    }
+
+    impl<'asset> RangeBounds<dyn AsAssetByAccount + 'asset> for AssetByAccountBounds<'asset> {
+        fn start_bound(&self) -> Bound<&(dyn AsAssetByAccount + 'asset)> {
+            Bound::Excluded(&self.start)
+        }
+
+        fn end_bound(&self) -> Bound<&(dyn AsAssetByAccount + 'asset)> {
+            Bound::Excluded(&self.end)
+        }
+    }
+
+    impl AsAssetByAccount for AccountIdWithAssetDefinition {
+        fn as_key(&self) -> AssetByAccount<'_> {
+            AssetByAccount {
+                account_id: &self.account_id,
+                definition_id: (&self.definition_id).into(),
+            }
+        }
+    }
+
+    impl_as_dyn_key! {
+        target: AccountIdWithAssetDefinition,
+        key: AssetByAccount<'_>,
+        trait: AsAssetByAccount
+    }
+
+    /// Key for range queries over asset definition for holders
+    #[derive(PartialEq, Eq, PartialOrd, Ord, Copy, Clone)]
+    pub struct HolderByAssetDefinition<'holder> {
+        definition_id: &'holder AssetDefinitionId,
+        account_id: MinMaxExt<&'holder AccountId>,
+    }
+
+    /// Bounds for range quired over asset definition for holders
+    pub struct HolderByAssetDefinitionBounds<'holder> {
+        start: HolderByAssetDefinition<'holder>,
+        end: HolderByAssetDefinition<'holder>,
+    }
+
+    impl<'holder> HolderByAssetDefinitionBounds<'holder> {
+        /// Create range bounds for range quires of holders over asset definition
+        pub fn new(definition_id: &'holder AssetDefinitionId) -> Self {
+            Self {
+                start: HolderByAssetDefinition {
+                    definition_id,
+                    account_id: MinMaxExt::Min,
+                },
+                end: HolderByAssetDefinition {
+                    definition_id,
+                    account_id: MinMaxExt::Max,
+                },
+            }
+        }
+    }
+
+    impl<'holder> RangeBounds<dyn AsHolderByAssetDefinition + 'holder>
+        for HolderByAssetDefinitionBounds<'holder>
+    {
+        fn start_bound(&self) -> Bound<&(dyn AsHolderByAssetDefinition + 'holder)> {
+            Bound::Excluded(&self.start)
+        }
+
+        fn end_bound(&self) -> Bound<&(dyn AsHolderByAssetDefinition + 'holder)> {
+            Bound::Excluded(&self.end)
+        }
+    }
+
+    impl AsHolderByAssetDefinition for AssetDefinitionIdWithHolder {
+        fn as_key(&self) -> HolderByAssetDefinition<'_> {
+            HolderByAssetDefinition {
+                definition_id: &self.definition_id,
+                account_id: (&self.account_id).into(),
+            }
+        }
+    }
+
+    impl_as_dyn_key! {
+        target: AssetDefinitionIdWithHolder,
+        key: HolderByAssetDefinition<'_>,
+        trait: AsHolderByAssetDefinition
+    }
+
+    /// Key for range queries over role for holders
+    #[derive(PartialEq, Eq, PartialOrd, Ord, Copy, Clone)]
+    pub struct HolderByRole<'holder> {
+        role_id: &'holder RoleId,
+        account_id: MinMaxExt<&'holder AccountId>,
+    }
+
+    /// Bounds for range quired over role for holders
+    pub struct HolderByRoleBounds<'holder> {
+        start: HolderByRole<'holder>,
+        end: HolderByRole<'holder>,
+    }
+
+    impl<'holder> HolderByRoleBounds<'holder> {
+        /// Create range bounds for range quires of holders over role
+        pub fn new(role_id: &'holder RoleId) -> Self {
+            Self {
+                start: HolderByRole {
+                    role_id,
+                    account_id: MinMaxExt::Min,
+                },
+                end: HolderByRole {
+                    role_id,
+                    account_id: MinMaxExt::Max,
+                },
+            }
+        }
+    }
+
+    impl<'holder> RangeBounds<dyn AsHolderByRole + 'holder> for HolderByRoleBounds<'holder> {
+        fn start_bound(&self) -> Bound<&(dyn AsHolderByRole + 'holder)> {
+            Bound::Excluded(&self.start)
+        }
+
+        fn end_bound(&self) -> Bound<&(dyn AsHolderByRole + 'holder)> {
+            Bound::Excluded(&self.end)
+        }
+    }
+
+    impl AsHolderByRole for RoleIdWithHolder {
+        fn as_key(&self) -> HolderByRole<'_> {
+            HolderByRole {
+                role_id: &self.role_id,
+                account_id: (&self.account_id).into(),
+            }
+        }
+    }
+
+    impl_as_dyn_key! {
+        target: RoleIdWithHolder,
+        key: HolderByRole<'_>,
+        trait: AsHolderByRole
+    }
+
+    /// Key for range queries over name for asset definitions
+    #[derive(PartialEq, Eq, PartialOrd, Ord, Copy, Clone)]
+    pub struct AssetDefinitionByName<'def> {
+        name: &'def Name,
+        definition_id: MinMaxExt<&'def AssetDefinitionId>,
+    }
+
+    /// Bounds for range quired over name for asset definitions
+    pub struct AssetDefinitionByNameBounds<'def> {
+        start: AssetDefinitionByName<'def>,
+        end: AssetDefinitionByName<'def>,
+    }
+
+    impl<'def> AssetDefinitionByNameBounds<'def> {
+        /// Create range bounds for range quires of asset definitions over name
+        pub fn new(name: &'def Name) -> Self {
+            Self {
+                start: AssetDefinitionByName {
+                    name,
+                    definition_id: MinMaxExt::Min,
+                },
+                end: AssetDefinitionByName {
+                    name,
+                    definition_id: MinMaxExt::Max,
+                },
+            }
+        }
+    }
+
+    impl<'def> RangeBounds<dyn AsAssetDefinitionByName + 'def> for AssetDefinitionByNameBounds<'def> {
+        fn start_bound(&self) -> Bound<&(dyn AsAssetDefinitionByName + 'def)> {
+            Bound::Excluded(&self.start)
+        }
+
+        fn end_bound(&self) -> Bound<&(dyn AsAssetDefinitionByName + 'def)> {
+            Bound::Excluded(&self.end)
+        }
+    }
+
+    impl AsAssetDefinitionByName for AssetDefinitionIdWithName {
+        fn as_key(&self) -> AssetDefinitionByName<'_> {
+            AssetDefinitionByName {
+                name: &self.name,
+                definition_id: (&self.definition_id).into(),
+            }
+        }
+    }
+
+    impl_as_dyn_key! {
+        target: AssetDefinitionIdWithName,
+        key: AssetDefinitionByName<'_>,
+        trait: AsAssetDefinitionByName
+    }
+}
+
+pub(crate) mod serialize {
+    use serde::Serializer;
+
+    use super::*;
+
+    /// Entries of a view of a [`Storage`], serialized as a map the storage is deserialized from
+    pub struct Entries<'s, K, V, S> {
+        storage: &'s S,
+        _marker: PhantomData<fn() -> (K, V)>,
+    }
+
+    impl<'s, K, V, S: StorageReadOnly<K, V>> Entries<'s, K, V, S> {
+        pub fn new(storage: &'s S) -> Self {
+            Self {
+                storage,
+                _marker: PhantomData,
+            }
+        }
+    }
+
+    impl<K, V, S> Serialize for Entries<'_, K, V, S>
+    where
+        K: Ord + Clone + Serialize,
+        V: Clone + Serialize,
+        S: StorageReadOnly<K, V>,
+    {
+        fn serialize<Ser: Serializer>(&self, serializer: Ser) -> Result<Ser::Ok, Ser::Error> {
+            serializer.collect_map(self.storage.iter())
+        }
+    }
+
+    /// Value serialized with its WASM contracts referred to by hash, which are resolved
+    /// with [`WasmSeed::with_contracts`](super::deserialize::WasmSeed::with_contracts)
+    pub struct WasmByHash<'v, T: ?Sized>(pub &'v T);
 }
 
 pub(crate) mod deserialize {
+    use serde::Deserialize;
     use storage::serde::CellSeeded;
 
     use super::*;
@@ -1497,16 +2305,68 @@ pub(crate) mod deserialize {
     #[derive(Clone, Copy)]
     pub struct WasmSeed<'e, T> {
         pub engine: &'e wasmtime::Engine,
+        /// Modules compiled ahead of deserialization
+        pub modules: Option<&'e wasm::CompiledModules>,
+        /// Contracts which are referred to by hash instead of being stored in place
+        pub contracts: Option<&'e wasm::ContractsByHash>,
         _marker: PhantomData<T>,
     }
 
     impl<'e, T> WasmSeed<'e, T> {
+        pub fn new(engine: &'e wasmtime::Engine) -> Self {
+            Self {
+                engine,
+                modules: None,
+                contracts: None,
+                _marker: PhantomData,
+            }
+        }
+
+        /// Use `modules` instead of compiling their contracts again
+        #[must_use]
+        pub fn with_modules(mut self, modules: &'e wasm::CompiledModules) -> Self {
+            self.modules = Some(modules);
+            self
+        }
+
+        /// Resolve contracts referred to by hash against `contracts`
+        #[must_use]
+        pub fn with_contracts(mut self, contracts: &'e wasm::ContractsByHash) -> Self {
+            self.contracts = Some(contracts);
+            self
+        }
+
         pub fn cast<U>(&self) -> WasmSeed<'e, U> {
             WasmSeed {
                 engine: self.engine,
+                modules: self.modules,
+                contracts: self.contracts,
                 _marker: PhantomData,
             }
         }
+
+        /// Get the contract referred to by `hash`
+        pub fn contract<E: serde::de::Error>(
+            &self,
+            hash: &HashOf<WasmSmartContract>,
+        ) -> Result<WasmSmartContract, E> {
+            self.contracts
+                .and_then(|contracts| contracts.get(hash))
+                .cloned()
+                .ok_or_else(|| E::custom(format!("contract {hash} is not stored with modules")))
+        }
+
+        /// Take the precompiled module of `contract` if there is one, otherwise compile it
+        pub fn load_module(&self, contract: &WasmSmartContract) -> wasm::Result<wasmtime::Module> {
+            if let Some(module) = self
+                .modules
+                .and_then(|modules| modules.get(&HashOf::new(contract)))
+            {
+                return Ok(module.clone());
+            }
+
+            wasm::load_module(self.engine, contract)
+        }
     }
 
     impl<'e, 'de, T> DeserializeSeed<'de> for WasmSeed<'e, Option<T>>
@@ -1557,6 +2417,24 @@ pub(crate) mod deserialize {
         }
     }
 
+    /// [`Domain`] which may still hold its accounts, as stored before they had a storage
+    #[derive(Deserialize)]
+    struct LegacyDomain {
+        #[serde(flatten)]
+        domain: Domain,
+        #[serde(default)]
+        accounts: BTreeMap<AccountId, LegacyAccount>,
+    }
+
+    /// [`Account`] which may still hold its assets, as stored before they had a storage
+    #[derive(Deserialize)]
+    struct LegacyAccount {
+        #[serde(flatten)]
+        account: Account,
+        #[serde(default)]
+        assets: BTreeMap<AssetDefinitionId, Asset>,
+    }
+
     impl<'de> DeserializeSeed<'de> for WasmSeed<'_, World> {
         type Value = World;
 
@@ -1582,9 +2460,14 @@ pub(crate) mod deserialize {
                     let mut parameters = None;
                     let mut trusted_peers_ids = None;
                     let mut domains = None;
+                    let mut accounts = None;
+                    let mut assets = None;
+                    let mut asset_holders = None;
+                    let mut asset_definitions_by_name = None;
                     let mut roles = None;
                     let mut account_permissions = None;
                     let mut account_roles = None;
+                    let mut account_effective_permissions = None;
                     let mut triggers = None;
                     let mut executor = None;
                     let mut executor_data_model = None;
@@ -1598,7 +2481,20 @@ pub(crate) mod deserialize {
                                 trusted_peers_ids = Some(map.next_value()?);
                             }
                             "domains" => {
-                                domains = Some(map.next_value()?);
+                                domains =
+                                    Some(map.next_value::<BTreeMap<DomainId, LegacyDomain>>()?);
+                            }
+                            "accounts" => {
+                                accounts = Some(map.next_value()?);
+                            }
+                            "assets" => {
+                                assets = Some(map.next_value()?);
+                            }
+                            "asset_holders" => {
+                                asset_holders = Some(map.next_value()?);
+                            }
+                            "asset_definitions_by_name" => {
+                                asset_definitions_by_name = Some(map.next_value()?);
                             }
                             "roles" => {
                                 roles = Some(map.next_value()?);
@@ -1609,6 +2505,9 @@ pub(crate) mod deserialize {
                             "account_roles" => {
                                 account_roles = Some(map.next_value()?);
                             }
+                            "account_effective_permissions" => {
+                                account_effective_permissions = Some(map.next_value()?);
+                            }
                             "triggers" => {
                                 triggers =
                                     Some(map.next_value_seed(self.loader.cast::<TriggerSet>())?);
@@ -1626,19 +2525,68 @@ pub(crate) mod deserialize {
                         }
                     }
 
+                    let domains =
+                        domains.ok_or_else(|| serde::de::Error::missing_field("domains"))?;
+                    let roles = roles.ok_or_else(|| serde::de::Error::missing_field("roles"))?;
+                    let account_permissions = account_permissions
+                        .ok_or_else(|| serde::de::Error::missing_field("account_permissions"))?;
+                    let account_roles = account_roles
+                        .ok_or_else(|| serde::de::Error::missing_field("account_roles"))?;
+
+                    // Snapshots taken before accounts and assets got storages of their own
+                    // nest them in domains and lack the indexes, which are rebuilt instead
+                    let mut nested_accounts = Vec::new();
+                    let mut nested_assets = Vec::new();
+                    let domains: Storage<_, _> = domains
+                        .into_iter()
+                        .map(|(domain_id, LegacyDomain { domain, accounts })| {
+                            for LegacyAccount { account, assets } in accounts.into_values() {
+                                nested_assets.extend(assets.into_values());
+                                nested_accounts.push(account);
+                            }
+                            (domain_id, domain)
+                        })
+                        .collect();
+                    let accounts = accounts.unwrap_or_else(|| {
+                        nested_accounts
+                            .into_iter()
+                            .map(|account| (account.id().clone(), account))
+                            .collect()
+                    });
+                    let assets = assets.unwrap_or_else(|| {
+                        nested_assets
+                            .into_iter()
+                            .map(|asset| (asset.id().clone().into(), asset))
+                            .collect()
+                    });
+                    let asset_holders =
+                        asset_holders.unwrap_or_else(|| World::asset_holders_of(&assets));
+                    let asset_definitions_by_name = asset_definitions_by_name
+                        .unwrap_or_else(|| World::asset_definitions_by_name_of(&domains));
+                    let account_effective_permissions = account_effective_permissions
+                        .unwrap_or_else(|| {
+                            World::account_effective_permissions_of(
+                                &account_permissions,
+                                &roles,
+                                &account_roles,
+                            )
+                        });
+
                     Ok(World {
                         parameters: parameters
                             .ok_or_else(|| serde::de::Error::missing_field("parameters"))?,
                         trusted_peers_ids: trusted_peers_ids
                             .ok_or_else(|| serde::de::Error::missing_field("trusted_peers_ids"))?,
-                        domains: domains
-                            .ok_or_else(|| serde::de::Error::missing_field("domains"))?,
-                        roles: roles.ok_or_else(|| serde::de::Error::missing_field("roles"))?,
-                        account_permissions: account_permissions.ok_or_else(|| {
-                            serde::de::Error::missing_field("account_permissions")
-                        })?,
-                        account_roles: account_roles
-                            .ok_or_else(|| serde::de::Error::missing_field("account_roles"))?,
+                        domains,
+                        accounts,
+                        assets,
+                        asset_holders,
+                        asset_definitions_by_name,
+                        roles,
+                        account_permissions,
+                        role_holders: World::role_holders_of(&account_roles),
+                        account_roles,
+                        account_effective_permissions,
                         triggers: triggers
                             .ok_or_else(|| serde::de::Error::missing_field("triggers"))?,
                         executor: executor
@@ -1656,9 +2604,14 @@ pub(crate) mod deserialize {
                     "parameters",
                     "trusted_peers_ids",
                     "domains",
+                    "accounts",
+                    "assets",
+                    "asset_holders",
+                    "asset_definitions_by_name",
                     "roles",
                     "account_permissions",
                     "account_roles",
+                    "account_effective_permissions",
                     "triggers",
                     "executor",
                     "executor_data_model",
@@ -1676,6 +2629,31 @@ pub(crate) mod deserialize {
         pub query_handle: LiveQueryStoreHandle,
     }
 
+    impl KuraSeed {
+        /// Assemble [`State`] from its deserialized parts
+        pub fn assemble(
+            self,
+            world: World,
+            config: Cell<Config>,
+            block_hashes: Cell<BlockHashes>,
+            transactions: TxSet,
+            engine: wasmtime::Engine,
+        ) -> State {
+            State {
+                state_root: StateRoot::from_world(&world),
+                world,
+                config,
+                block_hashes,
+                transactions,
+                kura: self.kura,
+                query_handle: self.query_handle,
+                engine,
+                new_tx_amounts: Arc::new(Mutex::new(Vec::new())),
+                hot_keys: None,
+            }
+        }
+    }
+
     impl<'de> DeserializeSeed<'de> for KuraSeed {
         type Value = State;
 
@@ -1705,10 +2683,7 @@ pub(crate) mod deserialize {
 
                     let engine = wasm::create_engine();
 
-                    let wasm_seed: WasmSeed<()> = WasmSeed {
-                        engine: &engine,
-                        _marker: PhantomData,
-                    };
+                    let wasm_seed: WasmSeed<()> = WasmSeed::new(&engine);
 
                     while let Some(key) = map.next_key::<String>()? {
                         match key.as_str() {
@@ -1728,18 +2703,15 @@ pub(crate) mod deserialize {
                         }
                     }
 
-                    Ok(State {
-                        world: world.ok_or_else(|| serde::de::Error::missing_field("world"))?,
-                        config: config.ok_or_else(|| serde::de::Error::missing_field("config"))?,
-                        block_hashes: block_hashes
+                    Ok(self.loader.assemble(
+                        world.ok_or_else(|| serde::de::Error::missing_field("world"))?,
+                        config.ok_or_else(|| serde::de::Error::missing_field("config"))?,
+                        block_hashes
                             .ok_or_else(|| serde::de::Error::missing_field("block_hashes"))?,
-                        transactions: transactions
+                        transactions
                             .ok_or_else(|| serde::de::Error::missing_field("transactions"))?,
-                        kura: self.loader.kura,
-                        query_handle: self.loader.query_handle,
                         engine,
-                        new_tx_amounts: Arc::new(Mutex::new(Vec::new())),
-                    })
+                    ))
                 }
             }
 
@@ -1761,7 +2733,7 @@ mod tests {
     use super::*;
     use crate::{
         block::ValidBlock, query::store::LiveQueryStore, role::RoleIdWithOwner,
-        sumeragi::network_topology::Topology,
+        state_root::StateRootReadOnly as _, sumeragi::network_topology::Topology,
     };
 
     /// Used to inject faulty payload for testing
@@ -1827,6 +2799,103 @@ mod tests {
         );
     }
 
+    #[tokio::test]
+    async fn state_root_matches_rebuild() {
+        let (alice_id, _alice_keypair) = gen_account_in("wonderland");
+        let (bob_id, _bob_keypair) = gen_account_in("wonderland");
+        let rose_id: AssetDefinitionId = "rose#wonderland".parse().unwrap();
+        let domain = Domain::new(alice_id.domain_id.clone()).build(&alice_id);
+        let account = Account::new(alice_id.clone()).build(&alice_id);
+
+        let kura = Kura::blank_kura_for_testing();
+        let query_handle = LiveQueryStore::test().start();
+        let state = State::new(
+            World::with([domain], [account], UniqueVec::new()),
+            kura,
+            query_handle,
+        );
+        let genesis_root = state.view().state_root.root();
+
+        let mut state_block = state.block();
+        let mut state_transaction = state_block.transaction();
+        let instructions: [InstructionBox; 5] = [
+            Register::asset_definition(AssetDefinition::numeric(rose_id.clone())).into(),
+            Mint::asset_numeric(10_u32, AssetId::new(rose_id.clone(), alice_id.clone())).into(),
+            Register::account(Account::new(bob_id.clone())).into(),
+            Mint::asset_numeric(5_u32, AssetId::new(rose_id, bob_id.clone())).into(),
+            // Bob's asset is removed without an event
+            Unregister::account(bob_id).into(),
+        ];
+        for instruction in instructions {
+            instruction
+                .execute(&alice_id, &mut state_transaction)
+                .expect("Instruction should succeed");
+        }
+        state_transaction.apply();
+        let block = new_dummy_block_with_payload(|payload| payload.header.height = 1);
+        let _events = state_block.apply(&block).unwrap();
+        state_block.commit();
+
+        let state_root = state.view().state_root.root();
+        assert_ne!(state_root, genesis_root);
+        assert_eq!(state_root, StateRoot::from_world(&state.world).root());
+    }
+
+    #[tokio::test]
+    async fn state_root_matches_rebuild_after_deleting_holders() {
+        let (alice_id, _alice_keypair) = gen_account_in("wonderland");
+        let (bob_id, _bob_keypair) = gen_account_in("wonderland");
+        let (carol_id, _carol_keypair) = gen_account_in("garden");
+        let rose_id: AssetDefinitionId = "rose#wonderland".parse().unwrap();
+        let tulip_id: AssetDefinitionId = "tulip#garden".parse().unwrap();
+        let domain = Domain::new(alice_id.domain_id.clone()).build(&alice_id);
+        let account = Account::new(alice_id.clone()).build(&alice_id);
+
+        let kura = Kura::blank_kura_for_testing();
+        let query_handle = LiveQueryStore::test().start();
+        let state = State::new(
+            World::with([domain], [account], UniqueVec::new()),
+            kura,
+            query_handle,
+        );
+
+        let blocks: [Vec<InstructionBox>; 2] = [
+            vec![
+                Register::asset_definition(AssetDefinition::numeric(rose_id.clone())).into(),
+                Register::account(Account::new(bob_id.clone())).into(),
+                Mint::asset_numeric(5_u32, AssetId::new(rose_id.clone(), bob_id.clone())).into(),
+                Register::domain(Domain::new(carol_id.domain_id.clone())).into(),
+                Register::account(Account::new(carol_id.clone())).into(),
+                Register::asset_definition(AssetDefinition::numeric(tulip_id.clone())).into(),
+                Mint::asset_numeric(7_u32, AssetId::new(tulip_id, carol_id.clone())).into(),
+                Mint::asset_numeric(3_u32, AssetId::new(rose_id, carol_id.clone())).into(),
+            ],
+            // Assets of deleted accounts are removed without events
+            vec![
+                Unregister::account(bob_id).into(),
+                Unregister::domain(carol_id.domain_id).into(),
+            ],
+        ];
+        for (height, instructions) in (1_u64..).zip(blocks) {
+            let mut state_block = state.block();
+            let mut state_transaction = state_block.transaction();
+            for instruction in instructions {
+                instruction
+                    .execute(&alice_id, &mut state_transaction)
+                    .expect("Instruction should succeed");
+            }
+            state_transaction.apply();
+            let block = new_dummy_block_with_payload(|payload| payload.header.height = height);
+            let _events = state_block.apply(&block).unwrap();
+            state_block.commit();
+
+            assert_eq!(
+                state.view().state_root.root(),
+                StateRoot::from_world(&state.world).root()
+            );
+        }
+    }
+
     #[test]
     fn role_account_range() {
         let (account_id, _account_keypair) = gen_account_in("wonderland");
@@ -1848,4 +2917,59 @@ mod tests {
             assert_eq!(&role.account_id, &account_id);
         }
     }
+
+    #[test]
+    fn account_domain_range() {
+        let accounts = [
+            gen_account_in("wonderland").0,
+            gen_account_in("wonderland").0,
+            gen_account_in("a").0,
+            gen_account_in("b").0,
+            gen_account_in("z").0,
+            gen_account_in("z").0,
+        ];
+        let map = BTreeSet::from(accounts);
+
+        let domain_id = "kingdom".parse().unwrap();
+        let range = map.range(AccountByDomainBounds::new(&domain_id));
+        assert_eq!(range.count(), 0);
+
+        let domain_id = "wonderland".parse().unwrap();
+        let range = map
+            .range(AccountByDomainBounds::new(&domain_id))
+            .collect::<Vec<_>>();
+        assert_eq!(range.len(), 2);
+        for account_id in range {
+            assert_eq!(account_id.domain_id, domain_id);
+        }
+    }
+
+    #[test]
+    fn asset_account_range() {
+        let (alice_id, _) = gen_account_in("wonderland");
+        let (bob_id, _) = gen_account_in("wonderland");
+        let definitions = ["a#wonderland", "xor#wonderland", "z#a", "z#z"]
+            .map(|definition_id| definition_id.parse::<AssetDefinitionId>().unwrap());
+        let map = definitions
+            .iter()
+            .flat_map(|definition_id| {
+                [
+                    AccountIdWithAssetDefinition::new(alice_id.clone(), definition_id.clone()),
+                    AccountIdWithAssetDefinition::new(bob_id.clone(), definition_id.clone()),
+                ]
+            })
+            .collect::<BTreeSet<_>>();
+
+        let (carol_id, _) = gen_account_in("wonderland");
+        let range = map.range(AssetByAccountBounds::new(&carol_id));
+        assert_eq!(range.count(), 0);
+
+        let range = map
+            .range(AssetByAccountBounds::new(&alice_id))
+            .collect::<Vec<_>>();
+        assert_eq!(range.len(), definitions.len());
+        for asset_id in range {
+            assert_eq!(asset_id.account_id, alice_id);
+        }
+    }
 }
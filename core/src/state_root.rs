@@ -0,0 +1,689 @@
+//! Commitment to the world state which is updated incrementally as blocks are applied.
+//!
+//! Every entry of the committed storages (domains, asset total quantities, accounts, assets,
+//! roles, account permissions, account roles and triggers) is a [`StateLeaf`] whose hash binds
+//! its key and value. Leaves are spread over a fixed number of buckets by the hash of their
+//! key. The digest of a bucket is the wrapping sum of its leaf hashes, so it is updated in
+//! constant time when a leaf changes, and bucket digests are the leaves of a fixed binary
+//! Merkle tree whose root is the [`state root`](StateRootReadOnly::root).
+//!
+//! Leaves touched by a block are derived from the data events the block produced, so only
+//! those leaves and the tree paths of their buckets are rehashed. Entries which are removed
+//! without events together with a deleted account or domain are found by range queries over
+//! the leaves of the deleted entity.
+//!
+//! The bucket digest is an additive multiset hash: it is meant to detect peers which
+//! diverged, it is not a proof of membership of a particular entry.
+//!
+//! Leaves changed by committed blocks can be recorded in the [`ChangeLog`], which is used
+//! to write snapshots of only the entries changed since the previous snapshot.
+
+use std::{
+    collections::BTreeSet,
+    sync::atomic::{AtomicBool, Ordering},
+};
+
+use iroha_crypto::Hash;
+use iroha_data_model::{events::EventBox, prelude::*, role::RoleId};
+use parity_scale_codec::Encode;
+use parking_lot::Mutex;
+use range_bounds::LeafBounds;
+use storage::storage::{Block as StorageBlock, Storage, StorageReadOnly, View as StorageView};
+
+use crate::{
+    asset::AccountIdWithAssetDefinition,
+    role::RoleIdWithOwner,
+    smartcontracts::triggers::{
+        set::{ExecutableRef, SetReadOnly as _},
+        specialized::LoadedActionTrait as _,
+    },
+    state::{World, WorldReadOnly},
+};
+
+/// Number of buckets, leaves of the Merkle tree
+const BUCKETS: u16 = 1 << 12;
+/// Index of the root in the Merkle tree.
+/// Children of the node `i` are `2 * i` and `2 * i + 1`, bucket `b` is the node `BUCKETS + b`.
+const ROOT: u16 = 1;
+
+/// Entry of the world state covered by the state root
+#[derive(Debug, Clone, PartialEq, Eq, PartialOrd, Ord, Encode)]
+pub enum StateLeaf {
+    /// [`Domain`], its asset definitions included
+    Domain(DomainId),
+    /// Total quantity of an [`AssetDefinition`], kept apart from the domain so that
+    /// minting or burning doesn't rehash the whole domain
+    AssetTotalQuantity(AssetDefinitionId),
+    /// [`Account`]
+    Account(AccountId),
+    /// [`Asset`], keyed as in its storage so that assets of an account are adjacent
+    Asset(AccountIdWithAssetDefinition),
+    /// [`Role`]
+    Role(RoleId),
+    /// Permissions granted to an [`Account`] directly
+    AccountPermissions(AccountId),
+    /// [`Role`] granted to an [`Account`]
+    AccountRole(RoleIdWithOwner),
+    /// [`Trigger`]
+    Trigger(TriggerId),
+}
+
+impl StateLeaf {
+    /// Every leaf of the `world`
+    fn all(world: &impl WorldReadOnly) -> impl Iterator<Item = Self> + '_ {
+        let domains = world
+            .domains()
+            .iter()
+            .map(|(id, _)| Self::Domain(id.clone()));
+        let asset_total_quantities = world.domains().iter().flat_map(|(_, domain)| {
+            domain
+                .asset_total_quantities
+                .keys()
+                .cloned()
+                .map(Self::AssetTotalQuantity)
+        });
+        let accounts = world
+            .accounts()
+            .iter()
+            .map(|(id, _)| Self::Account(id.clone()));
+        let assets = world.assets().iter().map(|(id, _)| Self::Asset(id.clone()));
+        let roles = world.roles().iter().map(|(id, _)| Self::Role(id.clone()));
+        let account_permissions = world
+            .account_permissions()
+            .iter()
+            .map(|(id, _)| Self::AccountPermissions(id.clone()));
+        let account_roles = world
+            .account_roles()
+            .iter()
+            .map(|(id, ())| Self::AccountRole(id.clone()));
+        let triggers = world.triggers().ids_iter().cloned().map(Self::Trigger);
+
+        domains
+            .chain(asset_total_quantities)
+            .chain(accounts)
+            .chain(assets)
+            .chain(roles)
+            .chain(account_permissions)
+            .chain(account_roles)
+            .chain(triggers)
+    }
+
+    /// Bucket of the leaf, which only depends on its key
+    fn bucket(&self) -> u16 {
+        let key_hash = Hash::new(self.encode());
+        let [first, second, ..] = *key_hash.as_ref();
+        u16::from_le_bytes([first, second]) % BUCKETS
+    }
+
+    /// Whether the entry of the leaf is present in the `world`
+    fn exists(&self, world: &impl WorldReadOnly) -> bool {
+        match self {
+            Self::Domain(id) => world.domains().get(id).is_some(),
+            Self::AssetTotalQuantity(id) => world
+                .domains()
+                .get(&id.domain_id)
+                .is_some_and(|domain| domain.asset_total_quantities.contains_key(id)),
+            Self::Account(id) => world.accounts().get(id).is_some(),
+            Self::Asset(id) => world.assets().get(id).is_some(),
+            Self::Role(id) => world.roles().get(id).is_some(),
+            Self::AccountPermissions(id) => world.account_permissions().get(id).is_some(),
+            Self::AccountRole(id) => world.account_roles().get(id).is_some(),
+            Self::Trigger(id) => world.triggers().ids().get(id).is_some(),
+        }
+    }
+
+    /// Hash of the leaf key and its value in the `world`, [`None`] if the entry isn't present
+    fn hash(&self, world: &impl WorldReadOnly) -> Option<Hash> {
+        let value = match self {
+            Self::Domain(id) => world.domains().get(id).map(|domain| {
+                // Total quantities are committed to by their own leaves
+                (
+                    &domain.id,
+                    &domain.asset_definitions,
+                    &domain.logo,
+                    &domain.metadata,
+                    &domain.owned_by,
+                )
+                    .encode()
+            }),
+            Self::AssetTotalQuantity(id) => world
+                .domains()
+                .get(&id.domain_id)
+                .and_then(|domain| domain.asset_total_quantities.get(id))
+                .map(Encode::encode),
+            Self::Account(id) => world.accounts().get(id).map(Encode::encode),
+            Self::Asset(id) => world.assets().get(id).map(Encode::encode),
+            Self::Role(id) => world.roles().get(id).map(Encode::encode),
+            Self::AccountPermissions(id) => world.account_permissions().get(id).map(Encode::encode),
+            Self::AccountRole(id) => world.account_roles().get(id).map(|()| Vec::new()),
+            Self::Trigger(id) => world.triggers().inspect_by_id(id, |action| {
+                let action = action.clone_and_box();
+                // Wasm blobs are committed to by their hash
+                let executable = match action.executable() {
+                    ExecutableRef::Wasm(blob_hash) => (0_u8, blob_hash).encode(),
+                    ExecutableRef::Instructions(instructions) => (1_u8, instructions).encode(),
+                };
+                (
+                    &action.authority,
+                    &action.repeats,
+                    &action.filter,
+                    &action.metadata,
+                    executable,
+                )
+                    .encode()
+            }),
+        }?;
+
+        Some(Hash::new((self, value).encode()))
+    }
+}
+
+/// Wrapping sum of the hashes of leaves in a bucket
+#[derive(Debug, Clone, Copy, Default, PartialEq, Eq)]
+struct BucketDigest([u64; 4]);
+
+impl BucketDigest {
+    fn add(&mut self, leaf: &Hash) {
+        for (limb, leaf_limb) in self.0.iter_mut().zip(Self::limbs(leaf)) {
+            *limb = limb.wrapping_add(leaf_limb);
+        }
+    }
+
+    fn sub(&mut self, leaf: &Hash) {
+        for (limb, leaf_limb) in self.0.iter_mut().zip(Self::limbs(leaf)) {
+            *limb = limb.wrapping_sub(leaf_limb);
+        }
+    }
+
+    fn limbs(leaf: &Hash) -> impl Iterator<Item = u64> + '_ {
+        leaf.as_ref()
+            .chunks_exact(8)
+            .map(|limb| u64::from_le_bytes(limb.try_into().expect("Chunk of 8 bytes")))
+    }
+
+    fn hash(&self) -> Hash {
+        let bytes: Vec<u8> = self.0.iter().flat_map(|limb| limb.to_le_bytes()).collect();
+        Hash::new(bytes)
+    }
+}
+
+/// Leaves changed by a range of committed blocks
+#[derive(Debug, Clone, PartialEq, Eq)]
+pub struct Changes {
+    /// Height of the first block whose changes are recorded
+    pub from_height: u64,
+    /// Height of the latest block whose changes are recorded
+    pub to_height: u64,
+    /// Leaves whose hash changed
+    pub leaves: BTreeSet<StateLeaf>,
+    /// Whether entries might have changed without being recorded, e.g. by executor migration
+    pub all: bool,
+}
+
+/// Leaves changed by blocks committed since the log was last drained.
+///
+/// Recording is disabled until [`enable`](Self::enable) is called, so that changes don't
+/// pile up when nobody drains them.
+#[derive(Debug, Default)]
+pub struct ChangeLog {
+    enabled: AtomicBool,
+    changes: Mutex<Option<Changes>>,
+}
+
+impl ChangeLog {
+    /// Start recording changes of committed blocks
+    pub fn enable(&self) {
+        self.enabled.store(true, Ordering::Release);
+    }
+
+    /// Whether changes are recorded
+    pub fn is_enabled(&self) -> bool {
+        self.enabled.load(Ordering::Acquire)
+    }
+
+    /// Take changes recorded so far, [`None`] if no block was committed since the last call
+    pub fn drain(&self) -> Option<Changes> {
+        self.changes.lock().take()
+    }
+
+    fn record(&self, height: u64, leaves: BTreeSet<StateLeaf>, all: bool) {
+        let mut changes = self.changes.lock();
+        let changes = changes.get_or_insert_with(|| Changes {
+            from_height: height,
+            to_height: height,
+            leaves: BTreeSet::new(),
+            all: false,
+        });
+        // Height is lower if the latest block was reverted
+        changes.from_height = changes.from_height.min(height);
+        changes.to_height = height;
+        changes.leaves.extend(leaves);
+        changes.all |= all;
+    }
+}
+
+/// Commitment to the world state
+pub struct StateRoot {
+    /// Hashes of the leaves
+    leaves: Storage<StateLeaf, Hash>,
+    /// Digests of the buckets, a missing bucket is empty
+    buckets: Storage<u16, BucketDigest>,
+    /// Nodes of the Merkle tree over the buckets
+    nodes: Storage<u16, Hash>,
+    /// Leaves changed by committed blocks
+    change_log: ChangeLog,
+}
+
+/// Block-local changes to the [`StateRoot`]
+pub struct StateRootBlock<'state> {
+    leaves: StorageBlock<'state, StateLeaf, Hash>,
+    buckets: StorageBlock<'state, u16, BucketDigest>,
+    nodes: StorageBlock<'state, u16, Hash>,
+    change_log: &'state ChangeLog,
+    /// Leaves changed by the block, only collected if the change log is enabled
+    changed: BTreeSet<StateLeaf>,
+    /// Whether entries might have changed without being touched
+    changed_all: bool,
+}
+
+/// Consistent point in time view of the [`StateRoot`]
+pub struct StateRootView<'state> {
+    nodes: StorageView<'state, u16, Hash>,
+}
+
+impl StateRoot {
+    /// Build the commitment to every entry of the `world`.
+    ///
+    /// Takes time proportional to the size of the world, so it's only done on startup.
+    pub fn from_world(world: &World) -> Self {
+        let state_root = Self {
+            leaves: Storage::new(),
+            buckets: Storage::new(),
+            nodes: Storage::new(),
+            change_log: ChangeLog::default(),
+        };
+        let mut block = state_root.block();
+        block.rehash_nodes((0..BUCKETS).collect());
+        let world = world.view();
+        block.update_leaves(&world, StateLeaf::all(&world).collect());
+        block.commit(0);
+        state_root
+    }
+
+    /// Create struct to apply changes of a block
+    pub fn block(&self) -> StateRootBlock<'_> {
+        StateRootBlock {
+            leaves: self.leaves.block(),
+            buckets: self.buckets.block(),
+            nodes: self.nodes.block(),
+            change_log: &self.change_log,
+            changed: BTreeSet::new(),
+            changed_all: false,
+        }
+    }
+
+    /// Create struct to apply changes of a block while reverting changes made in the latest block
+    pub fn block_and_revert(&self) -> StateRootBlock<'_> {
+        StateRootBlock {
+            leaves: self.leaves.block_and_revert(),
+            buckets: self.buckets.block_and_revert(),
+            nodes: self.nodes.block_and_revert(),
+            change_log: &self.change_log,
+            changed: BTreeSet::new(),
+            changed_all: false,
+        }
+    }
+
+    /// Leaves changed by committed blocks
+    pub fn change_log(&self) -> &ChangeLog {
+        &self.change_log
+    }
+
+    /// Create point in time view of [`Self`]
+    pub fn view(&self) -> StateRootView<'_> {
+        StateRootView {
+            nodes: self.nodes.view(),
+        }
+    }
+}
+
+/// Trait to read the root of [`StateRootBlock`] and [`StateRootView`]
+pub trait StateRootReadOnly {
+    /// Nodes of the Merkle tree over the buckets
+    fn nodes(&self) -> &impl StorageReadOnly<u16, Hash>;
+
+    /// Root of the commitment to the world state
+    fn root(&self) -> Hash {
+        *self
+            .nodes()
+            .get(&ROOT)
+            .expect("Tree is built on construction")
+    }
+}
+
+impl StateRootReadOnly for StateRootBlock<'_> {
+    fn nodes(&self) -> &impl StorageReadOnly<u16, Hash> {
+        &self.nodes
+    }
+}
+
+impl StateRootReadOnly for StateRootView<'_> {
+    fn nodes(&self) -> &impl StorageReadOnly<u16, Hash> {
+        &self.nodes
+    }
+}
+
+impl StateRootBlock<'_> {
+    /// Rehash leaves of the `world` touched by `events` and the tree paths of their buckets
+    pub fn update<'event>(
+        &mut self,
+        world: &impl WorldReadOnly,
+        events: impl IntoIterator<Item = &'event EventBox>,
+    ) {
+        let mut touched = BTreeSet::new();
+        let mut deleted_authority = false;
+        for event in events {
+            match event {
+                EventBox::Data(DataEvent::Domain(event)) => {
+                    deleted_authority |= self.touched_by_domain_event(event, &mut touched);
+                }
+                EventBox::Data(DataEvent::Role(event)) => {
+                    // Role is revoked from its holders with events before it's deleted
+                    touched.insert(StateLeaf::Role(event.origin_id().clone()));
+                }
+                EventBox::Data(DataEvent::Trigger(event)) => {
+                    touched.insert(StateLeaf::Trigger(event.origin_id().clone()));
+                }
+                EventBox::TriggerCompleted(event) => {
+                    // Repetitions of the trigger were decreased
+                    touched.insert(StateLeaf::Trigger(event.trigger_id().clone()));
+                }
+                EventBox::Data(DataEvent::Executor(_)) => {
+                    // Migration of the executor may change any entry without emitting events
+                    touched.extend(self.leaves.iter().map(|(leaf, _)| leaf.clone()));
+                    touched.extend(StateLeaf::all(world));
+                    self.changed_all = true;
+                }
+                _ => {}
+            }
+        }
+
+        if deleted_authority {
+            // Triggers of a deleted authority are removed without emitting events.
+            // There is no index of triggers by authority, unregistering scans them all as well.
+            touched.extend(
+                self.leaves
+                    .range(LeafBounds::triggers())
+                    .filter(|(leaf, _)| !leaf.exists(world))
+                    .map(|(leaf, _)| leaf.clone()),
+            );
+        }
+
+        self.update_leaves(world, touched);
+    }
+
+    /// Commit changes of the block at `height`
+    pub fn commit(self, height: u64) {
+        // NOTE: commit in reversed order
+        self.nodes.commit();
+        self.buckets.commit();
+        self.leaves.commit();
+        if self.change_log.is_enabled() {
+            self.change_log
+                .record(height, self.changed, self.changed_all);
+        }
+    }
+
+    fn update_leaves(&mut self, world: &impl WorldReadOnly, touched: BTreeSet<StateLeaf>) {
+        let mut dirty_buckets = BTreeSet::new();
+        let record_changes = self.change_log.is_enabled();
+        for leaf in touched {
+            let new_hash = leaf.hash(world);
+            let old_hash = self.leaves.get(&leaf).copied();
+            if new_hash == old_hash {
+                continue;
+            }
+
+            if record_changes {
+                self.changed.insert(leaf.clone());
+            }
+            let bucket = leaf.bucket();
+            let mut digest = self.buckets.get(&bucket).copied().unwrap_or_default();
+            if let Some(old_hash) = old_hash {
+                digest.sub(&old_hash);
+            }
+            match new_hash {
+                Some(new_hash) => {
+                    digest.add(&new_hash);
+                    self.leaves.insert(leaf, new_hash);
+                }
+                None => {
+                    self.leaves.remove(leaf);
+                }
+            }
+            self.buckets.insert(bucket, digest);
+            dirty_buckets.insert(bucket);
+        }
+
+        self.rehash_nodes(dirty_buckets);
+    }
+
+    /// Rehash `dirty_buckets` and their ancestors level by level up to the root
+    fn rehash_nodes(&mut self, dirty_buckets: BTreeSet<u16>) {
+        if dirty_buckets.is_empty() {
+            return;
+        }
+
+        let mut dirty_nodes = BTreeSet::new();
+        for bucket in dirty_buckets {
+            let digest = self.buckets.get(&bucket).copied().unwrap_or_default();
+            self.nodes.insert(BUCKETS + bucket, digest.hash());
+            dirty_nodes.insert((BUCKETS + bucket) / 2);
+        }
+
+        while !dirty_nodes.is_empty() {
+            let mut dirty_parents = BTreeSet::new();
+            for node in dirty_nodes {
+                let child = |index| self.nodes.get(&index).expect("Children are hashed first");
+                let children = [child(2 * node).as_ref(), child(2 * node + 1).as_ref()].concat();
+                self.nodes.insert(node, Hash::new(children));
+                if node != ROOT {
+                    dirty_parents.insert(node / 2);
+                }
+            }
+            dirty_nodes = dirty_parents;
+        }
+    }
+
+    /// Collect leaves touched by `event` and return whether it deleted an account or a domain
+    fn touched_by_domain_event(
+        &self,
+        event: &DomainEvent,
+        touched: &mut BTreeSet<StateLeaf>,
+    ) -> bool {
+        match event {
+            DomainEvent::Account(AccountEvent::Asset(event)) => {
+                let asset_id = event.origin_id();
+                touched.insert(StateLeaf::AssetTotalQuantity(
+                    asset_id.definition_id.clone(),
+                ));
+                touched.insert(StateLeaf::Asset(asset_id.clone().into()));
+                false
+            }
+            DomainEvent::Account(
+                AccountEvent::PermissionAdded(changed) | AccountEvent::PermissionRemoved(changed),
+            ) => {
+                touched.insert(StateLeaf::AccountPermissions(changed.account_id.clone()));
+                false
+            }
+            DomainEvent::Account(
+                AccountEvent::RoleGranted(changed) | AccountEvent::RoleRevoked(changed),
+            ) => {
+                touched.insert(StateLeaf::AccountRole(RoleIdWithOwner::new(
+                    changed.account_id.clone(),
+                    changed.role_id.clone(),
+                )));
+                false
+            }
+            DomainEvent::Account(AccountEvent::Deleted(account_id)) => {
+                self.touched_by_deleted_account(account_id, touched);
+                true
+            }
+            DomainEvent::Account(event) => {
+                touched.insert(StateLeaf::Account(event.origin_id().clone()));
+                false
+            }
+            DomainEvent::AssetDefinition(event) => {
+                let asset_definition_id = event.origin_id();
+                touched.insert(StateLeaf::Domain(asset_definition_id.domain_id.clone()));
+                touched.insert(StateLeaf::AssetTotalQuantity(asset_definition_id.clone()));
+                false
+            }
+            DomainEvent::Deleted(domain_id) => {
+                touched.insert(StateLeaf::Domain(domain_id.clone()));
+                // Leaves are looked up rather than the world, which no longer has the entries
+                touched.extend(
+                    self.leaves
+                        .range(LeafBounds::asset_total_quantities_in_domain(domain_id))
+                        .map(|(leaf, _)| leaf.clone()),
+                );
+                let accounts = self
+                    .leaves
+                    .range(LeafBounds::accounts_in_domain(domain_id))
+                    .filter_map(|(leaf, _)| match leaf {
+                        StateLeaf::Account(account_id) => Some(account_id.clone()),
+                        _ => None,
+                    })
+                    .collect::<Vec<_>>();
+                for account_id in &accounts {
+                    self.touched_by_deleted_account(account_id, touched);
+                }
+                true
+            }
+            event => {
+                touched.insert(StateLeaf::Domain(event.origin_id().clone()));
+                false
+            }
+        }
+    }
+
+    /// Collect leaves of the deleted account and of the entries which depend on it
+    fn touched_by_deleted_account(
+        &self,
+        account_id: &AccountId,
+        touched: &mut BTreeSet<StateLeaf>,
+    ) {
+        touched.insert(StateLeaf::Account(account_id.clone()));
+        touched.insert(StateLeaf::AccountPermissions(account_id.clone()));
+        for bounds in [
+            LeafBounds::assets_in_account(account_id),
+            LeafBounds::roles_of_account(account_id),
+        ] {
+            touched.extend(self.leaves.range(bounds).map(|(leaf, _)| leaf.clone()));
+        }
+    }
+}
+
+mod range_bounds {
+    //! Bounds of range queries over [`StateLeaf`]s of one entity
+
+    use core::ops::{Bound, RangeBounds};
+
+    use iroha_primitives::{cmpext::MinMaxExt, impl_as_dyn_key};
+
+    use super::*;
+
+    /// Key for range queries over leaves, variants are ordered as in [`StateLeaf`]
+    #[derive(PartialEq, Eq, PartialOrd, Ord, Copy, Clone)]
+    pub enum LeafKey<'leaf> {
+        Domain(&'leaf DomainId),
+        AssetTotalQuantity(&'leaf DomainId, MinMaxExt<&'leaf Name>),
+        Account(&'leaf DomainId, MinMaxExt<&'leaf PublicKey>),
+        Asset(&'leaf AccountId, MinMaxExt<&'leaf AssetDefinitionId>),
+        Role(&'leaf RoleId),
+        AccountPermissions(&'leaf AccountId),
+        AccountRole(&'leaf AccountId, MinMaxExt<&'leaf RoleId>),
+        Trigger(MinMaxExt<&'leaf TriggerId>),
+    }
+
+    /// Bounds for range queries over leaves
+    pub struct LeafBounds<'leaf> {
+        start: LeafKey<'leaf>,
+        end: LeafKey<'leaf>,
+    }
+
+    impl<'leaf> LeafBounds<'leaf> {
+        /// Create range bounds for range queries of asset total quantities over domain
+        pub fn asset_total_quantities_in_domain(domain_id: &'leaf DomainId) -> Self {
+            Self {
+                start: LeafKey::AssetTotalQuantity(domain_id, MinMaxExt::Min),
+                end: LeafKey::AssetTotalQuantity(domain_id, MinMaxExt::Max),
+            }
+        }
+
+        /// Create range bounds for range queries of accounts over domain
+        pub fn accounts_in_domain(domain_id: &'leaf DomainId) -> Self {
+            Self {
+                start: LeafKey::Account(domain_id, MinMaxExt::Min),
+                end: LeafKey::Account(domain_id, MinMaxExt::Max),
+            }
+        }
+
+        /// Create range bounds for range queries of assets over account
+        pub fn assets_in_account(account_id: &'leaf AccountId) -> Self {
+            Self {
+                start: LeafKey::Asset(account_id, MinMaxExt::Min),
+                end: LeafKey::Asset(account_id, MinMaxExt::Max),
+            }
+        }
+
+        /// Create range bounds for range queries of roles over account
+        pub fn roles_of_account(account_id: &'leaf AccountId) -> Self {
+            Self {
+                start: LeafKey::AccountRole(account_id, MinMaxExt::Min),
+                end: LeafKey::AccountRole(account_id, MinMaxExt::Max),
+            }
+        }
+
+        /// Create range bounds for range queries of all triggers
+        pub fn triggers() -> Self {
+            Self {
+                start: LeafKey::Trigger(MinMaxExt::Min),
+                end: LeafKey::Trigger(MinMaxExt::Max),
+            }
+        }
+    }
+
+    impl<'leaf> RangeBounds<dyn AsLeafKey + 'leaf> for LeafBounds<'leaf> {
+        fn start_bound(&self) -> Bound<&(dyn AsLeafKey + 'leaf)> {
+            Bound::Excluded(&self.start)
+        }
+
+        fn end_bound(&self) -> Bound<&(dyn AsLeafKey + 'leaf)> {
+            Bound::Excluded(&self.end)
+        }
+    }
+
+    impl AsLeafKey for StateLeaf {
+        fn as_key(&self) -> LeafKey<'_> {
+            match self {
+                Self::Domain(id) => LeafKey::Domain(id),
+                Self::AssetTotalQuantity(id) => {
+                    LeafKey::AssetTotalQuantity(&id.domain_id, (&id.name).into())
+                }
+                Self::Account(id) => LeafKey::Account(&id.domain_id, (&id.signatory).into()),
+                Self::Asset(id) => LeafKey::Asset(&id.account_id, (&id.definition_id).into()),
+                Self::Role(id) => LeafKey::Role(id),
+                Self::AccountPermissions(id) => LeafKey::AccountPermissions(id),
+                Self::AccountRole(id) => LeafKey::AccountRole(&id.account_id, (&id.role_id).into()),
+                Self::Trigger(id) => LeafKey::Trigger(id.into()),
+            }
+        }
+    }
+
+    impl_as_dyn_key! {
+        target: StateLeaf,
+        key: LeafKey<'_>,
+        trait: AsLeafKey
+    }
+}
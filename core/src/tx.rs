@@ -13,12 +13,12 @@ use iroha_crypto::SignatureVerificationFail;
 pub use iroha_data_model::prelude::*;
 use iroha_data_model::{
     isi::error::Mismatch,
-    query::error::FindError,
     transaction::{error::TransactionLimitError, TransactionLimits, TransactionPayload},
 };
 use iroha_genesis::GenesisTransaction;
 use iroha_logger::{debug, error};
 use iroha_macro::FromVariant;
+use parking_lot::{Condvar, Mutex, MutexGuard};
 
 use crate::{
     smartcontracts::wasm,
@@ -183,9 +183,38 @@ impl TransactionExecutor {
         &self,
         tx: AcceptedTransaction,
         state_block: &mut StateBlock<'_>,
+    ) -> Result<SignedTransaction, (SignedTransaction, TransactionRejectionReason)> {
+        self.validate_compiled(tx, None, state_block)
+    }
+
+    /// Same as [`Self::validate`] for the transaction number `idx` of the transactions
+    /// given to `compiler`. Its smart contract is taken from `compiler` once the transaction
+    /// passed the executor instead of being compiled on the spot.
+    ///
+    /// # Errors
+    /// Fails if validation of instruction fails (e.g. permissions mismatch).
+    pub fn validate_with_compiler(
+        &self,
+        tx: AcceptedTransaction,
+        compiler: &SmartContractCompiler<'_>,
+        idx: usize,
+        state_block: &mut StateBlock<'_>,
+    ) -> Result<SignedTransaction, (SignedTransaction, TransactionRejectionReason)> {
+        let result = self.validate_compiled(tx, Some((compiler, idx)), state_block);
+        compiler.validated(idx);
+        result
+    }
+
+    fn validate_compiled(
+        &self,
+        tx: AcceptedTransaction,
+        compiled: Option<(&SmartContractCompiler<'_>, usize)>,
+        state_block: &mut StateBlock<'_>,
     ) -> Result<SignedTransaction, (SignedTransaction, TransactionRejectionReason)> {
         let mut state_transaction = state_block.transaction();
-        if let Err(rejection_reason) = self.validate_internal(tx.clone(), &mut state_transaction) {
+        if let Err(rejection_reason) =
+            self.validate_internal(tx.clone(), compiled, &mut state_transaction)
+        {
             return Err((tx.0, rejection_reason));
         }
         state_transaction.apply();
@@ -196,31 +225,23 @@ impl TransactionExecutor {
     fn validate_internal(
         &self,
         tx: AcceptedTransaction,
+        compiled: Option<(&SmartContractCompiler<'_>, usize)>,
         state_transaction: &mut StateTransaction<'_, '_>,
     ) -> Result<(), TransactionRejectionReason> {
         let authority = tx.as_ref().authority();
 
-        if !state_transaction
+        state_transaction
             .world
-            .domain(&authority.domain_id)
-            .map_err(|_e| {
-                TransactionRejectionReason::AccountDoesNotExist(FindError::Domain(
-                    authority.domain_id.clone(),
-                ))
-            })?
-            .accounts
-            .contains_key(authority)
-        {
-            return Err(TransactionRejectionReason::AccountDoesNotExist(
-                FindError::Account(authority.clone()),
-            ));
-        }
+            .account(authority)
+            .map_err(TransactionRejectionReason::AccountDoesNotExist)?;
 
         debug!("Validating transaction: {:?}", tx);
         Self::validate_with_runtime_executor(tx.clone(), state_transaction)?;
 
         if let (authority, Executable::Wasm(bytes)) = tx.into() {
-            self.validate_wasm(authority, state_transaction, bytes)?
+            // Only smart contracts of transactions accepted by the executor are waited for
+            let module = compiled.and_then(|(compiler, idx)| compiler.module(idx));
+            self.validate_wasm(authority, state_transaction, bytes, module.as_ref())?
         }
 
         debug!("Validation successful");
@@ -232,18 +253,24 @@ impl TransactionExecutor {
         authority: AccountId,
         state_transaction: &mut StateTransaction<'_, '_>,
         wasm: WasmSmartContract,
+        module: Option<&wasmtime::Module>,
     ) -> Result<(), TransactionRejectionReason> {
         debug!("Validating wasm");
 
+        let max_instruction_count = self.transaction_limits.max_instruction_number;
         wasm::RuntimeBuilder::<wasm::state::SmartContract>::new()
+            .with_engine(state_transaction.engine.clone()) // Cloning engine is cheap
             .build()
-            .and_then(|mut wasm_runtime| {
-                wasm_runtime.validate(
+            .and_then(|mut wasm_runtime| match module {
+                Some(module) => wasm_runtime.validate_module(
                     state_transaction,
                     authority,
-                    wasm,
-                    self.transaction_limits.max_instruction_number,
-                )
+                    module,
+                    max_instruction_count,
+                ),
+                None => {
+                    wasm_runtime.validate(state_transaction, authority, wasm, max_instruction_count)
+                }
             })
             .map_err(|error| WasmExecutionFail {
                 reason: format!("{:?}", eyre::Report::from(error)),
@@ -278,3 +305,153 @@ impl TransactionExecutor {
             })
     }
 }
+
+/// Wasm smart contracts of a block compiled by background workers while its transactions
+/// are validated one after another, see [`TransactionExecutor::validate_with_compiler`].
+///
+/// Compilation doesn't depend on the state, but whether a smart contract is run at all does.
+/// Workers therefore stay at most one transaction per worker ahead of validation and never
+/// compile smart contracts of transactions which were already validated, so transactions
+/// rejected before their smart contract is run waste little work.
+pub struct SmartContractCompiler<'tx> {
+    engine: &'tx wasmtime::Engine,
+    /// Smart contracts to compile by transaction, [`None`] for instruction transactions
+    /// and smart contracts exceeding [`TransactionLimits::max_wasm_size_bytes`]
+    smart_contracts: Vec<Option<&'tx WasmSmartContract>>,
+    lookahead: usize,
+    progress: Mutex<CompilerProgress>,
+    /// Notified when a smart contract is compiled, validation advances or it's finished
+    progressed: Condvar,
+}
+
+struct CompilerProgress {
+    /// Transaction to be picked up by the next idle worker
+    next: usize,
+    /// Number of transactions which finished validation
+    validated: usize,
+    is_finished: bool,
+    modules: Vec<CompiledModule>,
+}
+
+enum CompiledModule {
+    Pending,
+    Compiling,
+    /// [`None`] if compilation failed, validation compiles it again to report the error
+    Compiled(Option<wasmtime::Module>),
+}
+
+impl<'tx> SmartContractCompiler<'tx> {
+    /// Compile smart contracts of `transactions` on all available cores while `validate` runs.
+    pub fn run<R>(
+        engine: &'tx wasmtime::Engine,
+        transaction_limits: &TransactionLimits,
+        transactions: &[&'tx SignedTransaction],
+        validate: impl FnOnce(&Self) -> R,
+    ) -> R {
+        let smart_contracts: Vec<_> = transactions
+            .iter()
+            .map(|tx| match tx.instructions() {
+                Executable::Wasm(smart_contract)
+                    if AcceptedTransaction::len_u64(smart_contract.size_bytes())
+                        <= transaction_limits.max_wasm_size_bytes =>
+                {
+                    Some(smart_contract)
+                }
+                _ => None,
+            })
+            .collect();
+        let worker_count = std::thread::available_parallelism()
+            .map_or(1, std::num::NonZeroUsize::get)
+            .min(smart_contracts.iter().flatten().count());
+
+        let compiler = Self {
+            engine,
+            lookahead: worker_count,
+            progress: Mutex::new(CompilerProgress {
+                next: 0,
+                validated: 0,
+                is_finished: false,
+                modules: smart_contracts
+                    .iter()
+                    .map(|_| CompiledModule::Pending)
+                    .collect(),
+            }),
+            smart_contracts,
+            progressed: Condvar::new(),
+        };
+        if worker_count == 0 {
+            return validate(&compiler);
+        }
+
+        std::thread::scope(|scope| {
+            for _ in 0..worker_count {
+                scope.spawn(|| compiler.work());
+            }
+            // Workers are stopped even if validation panics, otherwise the scope never ends
+            let _finish = FinishOnDrop(&compiler);
+            validate(&compiler)
+        })
+    }
+
+    fn work(&self) {
+        let mut progress = self.progress.lock();
+        while !progress.is_finished {
+            progress.next = progress.next.max(progress.validated);
+            let idx = progress.next;
+            if idx >= self.smart_contracts.len() {
+                return;
+            }
+            if idx >= progress.validated + self.lookahead {
+                self.progressed.wait(&mut progress);
+                continue;
+            }
+            progress.next += 1;
+
+            let Some(smart_contract) = self.smart_contracts[idx] else {
+                continue;
+            };
+            if !matches!(progress.modules[idx], CompiledModule::Pending) {
+                continue;
+            }
+            progress.modules[idx] = CompiledModule::Compiling;
+            let module = MutexGuard::unlocked(&mut progress, || {
+                wasm::load_module(self.engine, smart_contract).ok()
+            });
+            progress.modules[idx] = CompiledModule::Compiled(module);
+            self.progressed.notify_all();
+        }
+    }
+
+    /// Take the compiled smart contract of the transaction number `idx`, waiting for
+    /// a worker compiling it or compiling it on the spot if no worker picked it up yet.
+    fn module(&self, idx: usize) -> Option<wasmtime::Module> {
+        let smart_contract = (*self.smart_contracts.get(idx)?)?;
+        let mut progress = self.progress.lock();
+        loop {
+            let slot = &mut progress.modules[idx];
+            match core::mem::replace(slot, CompiledModule::Compiling) {
+                CompiledModule::Pending => break,
+                CompiledModule::Compiling => self.progressed.wait(&mut progress),
+                CompiledModule::Compiled(module) => return module,
+            }
+        }
+        drop(progress);
+        wasm::load_module(self.engine, smart_contract).ok()
+    }
+
+    /// Let workers move past the transaction number `idx` once it's validated.
+    fn validated(&self, idx: usize) {
+        let mut progress = self.progress.lock();
+        progress.validated = progress.validated.max(idx + 1);
+        self.progressed.notify_all();
+    }
+}
+
+struct FinishOnDrop<'compiler, 'tx>(&'compiler SmartContractCompiler<'tx>);
+
+impl Drop for FinishOnDrop<'_, '_> {
+    fn drop(&mut self) {
+        self.0.progress.lock().is_finished = true;
+        self.0.progressed.notify_all();
+    }
+}
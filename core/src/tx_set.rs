@@ -0,0 +1,782 @@
+//! Compact set of committed transactions.
+//!
+//! Every committed transaction is recorded together with the height of its block, so that
+//! duplicates are rejected and the block of a transaction is found. Transactions of the latest
+//! blocks are kept in a [`Storage`] by their full hashes. Once there are [`SEAL_LEN`] of them,
+//! they are sealed into a [`Segment`]: a table of hash prefixes sorted for binary search, which
+//! covers a range of blocks and carries a bloom filter answering most lookups of transactions
+//! absent from it. Segments of similar length are merged, so that a lookup goes through
+//! a logarithmic number of them. Merges run on a background thread and their result is
+//! installed by the first block committed after they finish, so that committing a block never
+//! waits for a merge. The newest segment, which may hold the latest block, is left out of merges
+//! until the next one is sealed, so that removing the latest block never rebuilds a merged one.
+//!
+//! A sealed transaction takes about 21 bytes: 16 bytes of the hash prefix, 4 bytes of the block
+//! height relative to the segment and 10 bits of the bloom filter. Prefixes of 128 bits make
+//! false matches negligible even among billions of transactions.
+use std::sync::{Arc, OnceLock};
+
+use iroha_crypto::{Hash, HashOf};
+use iroha_data_model::transaction::SignedTransaction;
+use serde::{
+    de::{self, value::MapAccessDeserializer, MapAccess, SeqAccess, Visitor},
+    Deserialize, Deserializer, Serialize, Serializer,
+};
+use storage::{
+    cell::{Block as CellBlock, Cell, Transaction as CellTransaction, View as CellView},
+    storage::{
+        Block as StorageBlock, Storage, StorageReadOnly, Transaction as StorageTransaction,
+        View as StorageView,
+    },
+};
+
+use crate::state::serialize::Entries;
+
+/// Number of recent transactions which are sealed into a segment at once
+const SEAL_LEN: usize = 1 << 16;
+/// Length of segments beyond which they aren't merged, bounding the duration of a merge
+const MAX_SEGMENT_LEN: usize = 1 << 24;
+/// Length of the hash prefixes by which sealed transactions are looked up
+const KEY_LEN: usize = 16;
+/// Bits of the bloom filter of a segment per transaction
+const BLOOM_BITS_PER_KEY: usize = 10;
+/// Number of bits set in the bloom filter per transaction
+const BLOOM_PROBES: u32 = 7;
+/// Bits of a block of the bloom filter, all probes of a key fall into one block (a cache line)
+const BLOOM_BLOCK_BITS: usize = 512;
+
+/// Prefix of a transaction hash
+type Key = [u8; KEY_LEN];
+
+/// Set of committed transactions mapped onto heights of the blocks where they are stored
+// NB: `TxSet` has custom `Serialize` and `Deserialize` implementations, as does `TxSetView`,
+// which need to be manually updated when changing the struct
+#[derive(Default)]
+pub struct TxSet {
+    /// Transactions of the latest blocks by their hashes
+    recent: Storage<HashOf<SignedTransaction>, u64>,
+    /// Older transactions sealed into segments
+    sealed: Cell<Segments>,
+}
+
+/// Transaction set for block's aggregated changes
+pub struct TxSetBlock<'set> {
+    /// Transactions of the latest blocks by their hashes
+    recent: StorageBlock<'set, HashOf<SignedTransaction>, u64>,
+    /// Older transactions sealed into segments
+    sealed: CellBlock<'set, Segments>,
+}
+
+/// Transaction set for transaction's aggregated changes
+pub struct TxSetTransaction<'block, 'set> {
+    /// Transactions of the latest blocks by their hashes
+    recent: StorageTransaction<'block, 'set, HashOf<SignedTransaction>, u64>,
+    /// Older transactions sealed into segments
+    sealed: CellTransaction<'block, 'set, Segments>,
+}
+
+/// Consistent point in time view of the [`TxSet`]
+pub struct TxSetView<'set> {
+    /// Transactions of the latest blocks by their hashes
+    recent: StorageView<'set, HashOf<SignedTransaction>, u64>,
+    /// Older transactions sealed into segments
+    sealed: CellView<'set, Segments>,
+}
+
+/// Trait to perform read-only operations on [`TxSetBlock`], [`TxSetTransaction`] and [`TxSetView`]
+#[allow(missing_docs)]
+pub trait TxSetReadOnly {
+    fn recent(&self) -> &impl StorageReadOnly<HashOf<SignedTransaction>, u64>;
+    fn sealed(&self) -> &Segments;
+
+    /// Height of the block where the transaction with `hash` is stored,
+    /// [`None`] if it isn't committed
+    fn get(&self, hash: &HashOf<SignedTransaction>) -> Option<u64> {
+        self.recent()
+            .get(hash)
+            .copied()
+            .or_else(|| self.sealed().get(&key(hash)))
+    }
+}
+
+macro_rules! impl_tx_set_ro {
+    ($($ident:ty),*) => {$(
+        impl TxSetReadOnly for $ident {
+            fn recent(&self) -> &impl StorageReadOnly<HashOf<SignedTransaction>, u64> {
+                &self.recent
+            }
+            fn sealed(&self) -> &Segments {
+                &self.sealed
+            }
+        }
+    )*};
+}
+
+impl_tx_set_ro! {
+    TxSetBlock<'_>, TxSetTransaction<'_, '_>, TxSetView<'_>
+}
+
+impl TxSet {
+    /// Create struct to apply block's changes
+    pub fn block(&self) -> TxSetBlock<'_> {
+        TxSetBlock {
+            recent: self.recent.block(),
+            sealed: self.sealed.block(),
+        }
+    }
+
+    /// Create struct to apply block's changes while reverting changes made in the latest block
+    pub fn block_and_revert(&self) -> TxSetBlock<'_> {
+        TxSetBlock {
+            recent: self.recent.block_and_revert(),
+            sealed: self.sealed.block_and_revert(),
+        }
+    }
+
+    /// Create point in time view of the [`TxSet`]
+    pub fn view(&self) -> TxSetView<'_> {
+        TxSetView {
+            recent: self.recent.view(),
+            sealed: self.sealed.view(),
+        }
+    }
+
+    fn from_parts(recent: Storage<HashOf<SignedTransaction>, u64>, mut sealed: Segments) -> Self {
+        sealed.recent_len = recent.view().iter().count();
+        Self {
+            recent,
+            sealed: Cell::new(sealed),
+        }
+    }
+}
+
+impl<'set> TxSetBlock<'set> {
+    /// Create struct to apply transaction's changes
+    pub fn transaction(&mut self) -> TxSetTransaction<'_, 'set> {
+        TxSetTransaction {
+            recent: self.recent.transaction(),
+            sealed: self.sealed.transaction(),
+        }
+    }
+
+    /// Commit block's changes, installing the finished merge of segments and sealing recent
+    /// transactions if there are enough of them
+    pub fn commit(mut self) {
+        if self.sealed.merge_finished() {
+            self.sealed.install_merge();
+        }
+        if self.sealed.recent_len >= SEAL_LEN {
+            self.seal();
+        }
+        // NOTE: sealed transactions are removed from the recent ones only after they are
+        // committed to a segment, so that views never miss them
+        self.sealed.commit();
+        self.recent.commit();
+    }
+
+    /// Record the transaction with `hash` as stored in the block at `height`
+    pub fn insert(&mut self, hash: HashOf<SignedTransaction>, height: u64) {
+        self.recent.insert(hash, height);
+        self.sealed.recent_len += 1;
+    }
+
+    /// Forget transactions stored in blocks above `height`
+    pub fn remove_above(&mut self, height: u64) {
+        let removed = self
+            .recent
+            .iter()
+            .filter(|(_, block_height)| **block_height > height)
+            .map(|(hash, _)| *hash)
+            .collect::<Vec<_>>();
+        let sealed = &mut *self.sealed;
+        sealed.recent_len -= removed.len();
+        for hash in removed {
+            self.recent.remove(hash);
+        }
+        sealed.truncate(height);
+    }
+
+    /// Move recent transactions into a new segment
+    fn seal(&mut self) {
+        let entries = self
+            .recent
+            .iter()
+            .map(|(hash, height)| (*hash, *height))
+            .collect::<Vec<_>>();
+        for (hash, _) in &entries {
+            self.recent.remove(*hash);
+        }
+        let sealed = &mut *self.sealed;
+        sealed.recent_len = 0;
+        sealed.push(Segment::new(
+            entries.iter().map(|(hash, height)| (key(hash), *height)),
+        ));
+    }
+}
+
+impl TxSetTransaction<'_, '_> {
+    /// Apply transaction's changes
+    pub fn apply(self) {
+        // NOTE: apply in reverse order
+        self.sealed.apply();
+        self.recent.apply();
+    }
+}
+
+impl Serialize for TxSet {
+    fn serialize<S: Serializer>(&self, serializer: S) -> Result<S::Ok, S::Error> {
+        // Recent transactions go first, so that transactions sealed in between
+        // are serialized twice rather than missed
+        (&self.recent, &self.sealed).serialize(serializer)
+    }
+}
+
+/// Serialized in the same format as [`TxSet`], so that a snapshot is made of a single view
+impl Serialize for TxSetView<'_> {
+    fn serialize<S: Serializer>(&self, serializer: S) -> Result<S::Ok, S::Error> {
+        (Entries::new(&self.recent), &*self.sealed).serialize(serializer)
+    }
+}
+
+impl<'de> Deserialize<'de> for TxSet {
+    fn deserialize<D: Deserializer<'de>>(deserializer: D) -> Result<Self, D::Error> {
+        struct TxSetVisitor;
+
+        impl<'de> Visitor<'de> for TxSetVisitor {
+            type Value = TxSet;
+
+            fn expecting(&self, formatter: &mut std::fmt::Formatter) -> std::fmt::Result {
+                formatter.write_str("struct TxSet")
+            }
+
+            fn visit_seq<A>(self, mut seq: A) -> Result<Self::Value, A::Error>
+            where
+                A: SeqAccess<'de>,
+            {
+                let recent = seq
+                    .next_element()?
+                    .ok_or_else(|| de::Error::invalid_length(0, &self))?;
+                let sealed = seq
+                    .next_element()?
+                    .ok_or_else(|| de::Error::invalid_length(1, &self))?;
+                Ok(TxSet::from_parts(recent, sealed))
+            }
+
+            // Transactions used to be stored as a map of hashes onto block heights
+            fn visit_map<M>(self, map: M) -> Result<Self::Value, M::Error>
+            where
+                M: MapAccess<'de>,
+            {
+                let recent = Storage::deserialize(MapAccessDeserializer::new(map))?;
+                Ok(TxSet::from_parts(recent, Segments::default()))
+            }
+        }
+
+        deserializer.deserialize_any(TxSetVisitor)
+    }
+}
+
+/// Segments of sealed transactions from the oldest to the newest
+#[derive(Clone, Default)]
+pub struct Segments {
+    segments: Vec<Arc<Segment>>,
+    /// Number of transactions which aren't sealed yet
+    recent_len: usize,
+    /// Merge running in the background, at most one at a time
+    merge: Option<Merge>,
+}
+
+/// Merge of the run of segments starting at index `start`
+#[derive(Clone)]
+struct Merge {
+    start: usize,
+    inputs: Vec<Arc<Segment>>,
+    /// Set by the background thread once the merge is done
+    merged: Arc<OnceLock<Arc<Segment>>>,
+}
+
+impl Segments {
+    fn get(&self, key: &Key) -> Option<u64> {
+        // Recent transactions are looked up more often
+        self.segments
+            .iter()
+            .rev()
+            .find_map(|segment| segment.get(key))
+    }
+
+    /// Push the newest `segment`, starting to merge the previous newest one with preceding
+    /// segments which aren't longer unless another merge is running
+    fn push(&mut self, segment: Segment) {
+        self.segments.push(Arc::new(segment));
+        if self.merge.is_none() {
+            self.start_merge();
+        }
+    }
+
+    /// Start merging the newest segments but the latest one on a background thread, if there
+    /// are ones to merge
+    fn start_merge(&mut self) {
+        // The latest segment is only truncated when the latest block is removed
+        let Some((_latest, mergeable)) = self.segments.split_last() else {
+            return;
+        };
+        let Some((newest, older)) = mergeable.split_last() else {
+            return;
+        };
+        let mut start = older.len();
+        let (mut len, mut base_height, mut last_height) =
+            (newest.len(), newest.base_height, newest.last_height);
+        for segment in older.iter().rev() {
+            let merged_base_height = base_height.min(segment.base_height);
+            let merged_last_height = last_height.max(segment.last_height);
+            if segment.len() > len
+                || !within_limits(len + segment.len(), merged_base_height, merged_last_height)
+            {
+                break;
+            }
+            len += segment.len();
+            (base_height, last_height) = (merged_base_height, merged_last_height);
+            start -= 1;
+        }
+        if start == older.len() {
+            return;
+        }
+
+        let inputs = self.segments[start..mergeable.len()].to_vec();
+        let merged = Arc::new(OnceLock::new());
+        self.merge = Some(Merge {
+            start,
+            inputs: inputs.clone(),
+            merged: Arc::clone(&merged),
+        });
+        // Detached, the result is dropped if no block installs it
+        std::thread::Builder::new()
+            .name("tx_set_merge".to_owned())
+            .spawn(move || {
+                let _ = merged.set(Arc::new(Segment::merge(&inputs)));
+            })
+            .expect("Failed to spawn transaction segments merging thread");
+    }
+
+    /// Whether the running merge is done and can be installed
+    fn merge_finished(&self) -> bool {
+        self.merge
+            .as_ref()
+            .is_some_and(|merge| merge.merged.get().is_some())
+    }
+
+    /// Replace the merged segments with the result of the finished merge and start the next one
+    fn install_merge(&mut self) {
+        let Some(merge) = self.merge.take() else {
+            return;
+        };
+        let Some(merged) = merge.merged.get() else {
+            self.merge = Some(merge);
+            return;
+        };
+        let end = merge.start + merge.inputs.len();
+        // Merged segments might have been truncated or reverted since the merge started
+        let unchanged = self.segments.get(merge.start..end).is_some_and(|segments| {
+            segments
+                .iter()
+                .zip(&merge.inputs)
+                .all(|(segment, input)| Arc::ptr_eq(segment, input))
+        });
+        if unchanged {
+            self.segments.splice(merge.start..end, [Arc::clone(merged)]);
+        }
+        self.start_merge();
+    }
+
+    /// Remove transactions of blocks above `height`
+    fn truncate(&mut self, height: u64) {
+        // Segments are dropped as a whole if they are above `height`, only those spanning it
+        // are rebuilt, which is just the latest one when the latest block is removed
+        self.segments
+            .retain(|segment| segment.base_height <= height);
+        for segment in &mut self.segments {
+            if segment.last_height > height {
+                *segment = Arc::new(Segment::from_sorted(
+                    segment
+                        .entries()
+                        .filter(|(_, block_height)| *block_height <= height)
+                        .collect(),
+                ));
+            }
+        }
+        self.segments.retain(|segment| !segment.is_empty());
+    }
+}
+
+impl Serialize for Segments {
+    fn serialize<S: Serializer>(&self, serializer: S) -> Result<S::Ok, S::Error> {
+        serializer.collect_seq(self.segments.iter().map(|segment| &**segment))
+    }
+}
+
+impl<'de> Deserialize<'de> for Segments {
+    fn deserialize<D: Deserializer<'de>>(deserializer: D) -> Result<Self, D::Error> {
+        let segments = Vec::<Segment>::deserialize(deserializer)?;
+        Ok(Self {
+            segments: segments.into_iter().map(Arc::new).collect(),
+            recent_len: 0,
+            merge: None,
+        })
+    }
+}
+
+/// Transactions of a range of blocks, sorted by prefixes of their hashes
+struct Segment {
+    /// Height of the first block of the range
+    base_height: u64,
+    /// Height of the last block of the range
+    last_height: u64,
+    /// Sorted prefixes of transaction hashes, [`KEY_LEN`] bytes each
+    keys: Box<[u8]>,
+    /// Heights of the blocks of transactions relative to `base_height`
+    heights: Box<[u32]>,
+    bloom: Bloom,
+}
+
+impl Segment {
+    fn new(entries: impl IntoIterator<Item = (Key, u64)>) -> Self {
+        let mut entries = entries.into_iter().collect::<Vec<_>>();
+        entries.sort_unstable_by_key(|(key, _)| *key);
+        entries.dedup_by_key(|(key, _)| *key);
+        Self::from_sorted(entries)
+    }
+
+    /// # Panics
+    /// If `entries` span more than [`u32::MAX`] blocks
+    fn from_sorted(entries: Vec<(Key, u64)>) -> Self {
+        let base_height = entries
+            .iter()
+            .map(|(_, height)| *height)
+            .min()
+            .unwrap_or_default();
+        let mut keys = Vec::with_capacity(entries.len() * KEY_LEN);
+        let mut heights = Vec::with_capacity(entries.len());
+        for (key, height) in entries {
+            keys.extend_from_slice(&key);
+            heights.push(
+                u32::try_from(height - base_height)
+                    .expect("Segment spans at most `u32::MAX` blocks"),
+            );
+        }
+        Self::from_parts(base_height, keys.into(), heights.into())
+    }
+
+    fn from_parts(base_height: u64, keys: Box<[u8]>, heights: Box<[u32]>) -> Self {
+        let last_height = base_height + u64::from(heights.iter().copied().max().unwrap_or(0));
+        Self {
+            base_height,
+            last_height,
+            bloom: Bloom::new(&keys),
+            keys,
+            heights,
+        }
+    }
+
+    fn len(&self) -> usize {
+        self.heights.len()
+    }
+
+    fn is_empty(&self) -> bool {
+        self.heights.is_empty()
+    }
+
+    fn key(&self, index: usize) -> &[u8] {
+        &self.keys[index * KEY_LEN..(index + 1) * KEY_LEN]
+    }
+
+    fn entries(&self) -> impl Iterator<Item = (Key, u64)> + '_ {
+        self.keys
+            .chunks_exact(KEY_LEN)
+            .zip(self.heights.iter())
+            .map(|(key, offset)| {
+                (
+                    key.try_into().expect("Chunk has the key length"),
+                    self.base_height + u64::from(*offset),
+                )
+            })
+    }
+
+    fn get(&self, key: &Key) -> Option<u64> {
+        if !self.bloom.may_contain(key) {
+            return None;
+        }
+        let (mut low, mut high) = (0, self.len());
+        while low < high {
+            let mid = low + (high - low) / 2;
+            match self.key(mid).cmp(key.as_slice()) {
+                core::cmp::Ordering::Less => low = mid + 1,
+                core::cmp::Ordering::Greater => high = mid,
+                core::cmp::Ordering::Equal => {
+                    return Some(self.base_height + u64::from(self.heights[mid]))
+                }
+            }
+        }
+        None
+    }
+
+    /// Merge `segments` ordered from the oldest to the newest into one
+    fn merge(segments: &[Arc<Self>]) -> Self {
+        Self::new(segments.iter().flat_map(|segment| segment.entries()))
+    }
+}
+
+/// Whether a segment of `len` transactions of blocks from `base_height` to `last_height`
+/// stays within the limits
+fn within_limits(len: usize, base_height: u64, last_height: u64) -> bool {
+    len <= MAX_SEGMENT_LEN && last_height - base_height <= u64::from(u32::MAX)
+}
+
+impl Serialize for Segment {
+    fn serialize<S: Serializer>(&self, serializer: S) -> Result<S::Ok, S::Error> {
+        (self.base_height, Bytes(&self.keys), &self.heights).serialize(serializer)
+    }
+}
+
+impl<'de> Deserialize<'de> for Segment {
+    fn deserialize<D: Deserializer<'de>>(deserializer: D) -> Result<Self, D::Error> {
+        let (base_height, ByteBuf(keys), heights) =
+            <(u64, ByteBuf, Vec<u32>)>::deserialize(deserializer)?;
+        if keys.len() != heights.len() * KEY_LEN {
+            return Err(de::Error::invalid_length(
+                keys.len(),
+                &"a key for every height",
+            ));
+        }
+        Ok(Self::from_parts(base_height, keys.into(), heights.into()))
+    }
+}
+
+/// Blocked bloom filter over the keys of a segment
+struct Bloom {
+    blocks: Box<[[u64; BLOOM_BLOCK_BITS / 64]]>,
+}
+
+impl Bloom {
+    fn new(keys: &[u8]) -> Self {
+        let len = keys.len() / KEY_LEN;
+        let block_count = (len * BLOOM_BITS_PER_KEY).div_ceil(BLOOM_BLOCK_BITS).max(1);
+        let mut blocks = vec![[0; BLOOM_BLOCK_BITS / 64]; block_count].into_boxed_slice();
+        for key in keys.chunks_exact(KEY_LEN) {
+            let (block, bits) = Self::probes(key, block_count);
+            for bit in bits {
+                blocks[block][bit / 64] |= 1 << (bit % 64);
+            }
+        }
+        Self { blocks }
+    }
+
+    fn may_contain(&self, key: &[u8]) -> bool {
+        let (block, mut bits) = Self::probes(key, self.blocks.len());
+        bits.all(|bit| self.blocks[block][bit / 64] & (1 << (bit % 64)) != 0)
+    }
+
+    /// Block of the `key` and its bits within the block,
+    /// taken from the key itself as it is uniformly random
+    fn probes(key: &[u8], block_count: usize) -> (usize, impl Iterator<Item = usize>) {
+        let low = u64::from_le_bytes(key[..8].try_into().expect("Key is 16 bytes long"));
+        let high = u64::from_le_bytes(key[8..].try_into().expect("Key is 16 bytes long"));
+        let block = usize::try_from(low % block_count as u64).expect("Less than block count");
+        let bits = (0..BLOOM_PROBES).map(move |probe| {
+            usize::try_from((high >> (9 * probe)) % BLOOM_BLOCK_BITS as u64)
+                .expect("Less than block bits")
+        });
+        (block, bits)
+    }
+}
+
+/// Bytes serialized as a byte string rather than as a sequence of numbers
+struct Bytes<'a>(&'a [u8]);
+
+impl Serialize for Bytes<'_> {
+    fn serialize<S: Serializer>(&self, serializer: S) -> Result<S::Ok, S::Error> {
+        serializer.serialize_bytes(self.0)
+    }
+}
+
+/// Owned counterpart of [`Bytes`]
+struct ByteBuf(Vec<u8>);
+
+impl<'de> Deserialize<'de> for ByteBuf {
+    fn deserialize<D: Deserializer<'de>>(deserializer: D) -> Result<Self, D::Error> {
+        struct ByteBufVisitor;
+
+        impl<'de> Visitor<'de> for ByteBufVisitor {
+            type Value = ByteBuf;
+
+            fn expecting(&self, formatter: &mut std::fmt::Formatter) -> std::fmt::Result {
+                formatter.write_str("bytes")
+            }
+
+            fn visit_bytes<E: de::Error>(self, bytes: &[u8]) -> Result<Self::Value, E> {
+                Ok(ByteBuf(bytes.to_vec()))
+            }
+
+            fn visit_byte_buf<E: de::Error>(self, bytes: Vec<u8>) -> Result<Self::Value, E> {
+                Ok(ByteBuf(bytes))
+            }
+
+            fn visit_seq<A>(self, mut seq: A) -> Result<Self::Value, A::Error>
+            where
+                A: SeqAccess<'de>,
+            {
+                let mut bytes = Vec::with_capacity(seq.size_hint().unwrap_or(0));
+                while let Some(byte) = seq.next_element()? {
+                    bytes.push(byte);
+                }
+                Ok(ByteBuf(bytes))
+            }
+        }
+
+        deserializer.deserialize_byte_buf(ByteBufVisitor)
+    }
+}
+
+/// Prefix of the transaction `hash` by which it is looked up in segments
+fn key(hash: &HashOf<SignedTransaction>) -> Key {
+    let bytes: [u8; Hash::LENGTH] = Hash::from(*hash).into();
+    bytes[..KEY_LEN]
+        .try_into()
+        .expect("Hash is longer than the key")
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    fn tx_hash(n: u64) -> HashOf<SignedTransaction> {
+        HashOf::from_untyped_unchecked(Hash::new(n.to_le_bytes()))
+    }
+
+    /// Wait until the running merge of segments is done, so that the next block installs it
+    fn wait_for_merge(set: &TxSet) {
+        while set
+            .view()
+            .sealed()
+            .merge
+            .as_ref()
+            .is_some_and(|merge| merge.merged.get().is_none())
+        {
+            std::thread::yield_now();
+        }
+    }
+
+    #[test]
+    fn sealed_transactions_are_found() {
+        let set = TxSet::default();
+        for height in 1..=5 {
+            let mut block = set.block();
+            for n in 0..100 {
+                block.insert(tx_hash(height * 1000 + n), height);
+            }
+            // Every block is sealed into a segment, segments of the same length but the latest
+            // one are merged
+            block.seal();
+            block.commit();
+            wait_for_merge(&set);
+        }
+        // Merged segments are only installed by the next block
+        assert_eq!(set.view().sealed().segments.len(), 4);
+        assert_eq!(set.view().get(&tx_hash(4000)), Some(4));
+        set.block().commit();
+
+        let view = set.view();
+        assert_eq!(view.recent().iter().count(), 0);
+        assert_eq!(view.sealed().segments.len(), 2);
+        for height in 1..=5 {
+            for n in 0..100 {
+                assert_eq!(view.get(&tx_hash(height * 1000 + n)), Some(height));
+            }
+        }
+        assert_eq!(view.get(&tx_hash(6000)), None);
+    }
+
+    #[test]
+    fn removing_latest_block_keeps_merged_segments() {
+        let set = TxSet::default();
+        for height in 1..=3 {
+            let mut block = set.block();
+            block.insert(tx_hash(height), height);
+            block.seal();
+            block.commit();
+            wait_for_merge(&set);
+        }
+        set.block().commit();
+        let merged = Arc::clone(&set.view().sealed().segments[0]);
+        assert_eq!(merged.last_height, 2);
+
+        let mut block = set.block();
+        block.remove_above(2);
+        block.commit();
+
+        let view = set.view();
+        assert_eq!(view.sealed().segments.len(), 1);
+        assert!(Arc::ptr_eq(&view.sealed().segments[0], &merged));
+        assert_eq!(view.get(&tx_hash(2)), Some(2));
+        assert_eq!(view.get(&tx_hash(3)), None);
+    }
+
+    #[test]
+    fn sealing_is_reverted_with_block() {
+        let set = TxSet::default();
+        let mut block = set.block();
+        block.insert(tx_hash(1), 1);
+        block.commit();
+        let mut block = set.block();
+        block.insert(tx_hash(2), 2);
+        block.seal();
+        block.commit();
+
+        let mut block = set.block_and_revert();
+        assert_eq!(block.get(&tx_hash(1)), Some(1));
+        assert_eq!(block.get(&tx_hash(2)), None);
+        assert!(block.sealed().segments.is_empty());
+        block.insert(tx_hash(3), 2);
+        block.commit();
+
+        let view = set.view();
+        assert_eq!(view.get(&tx_hash(3)), Some(2));
+        assert_eq!(view.recent().iter().count(), 2);
+    }
+
+    #[test]
+    fn transactions_above_height_are_removed() {
+        let set = TxSet::default();
+        let mut block = set.block();
+        for height in 1..=10 {
+            block.insert(tx_hash(height), height);
+        }
+        block.seal();
+        block.insert(tx_hash(11), 11);
+        block.remove_above(5);
+        block.commit();
+
+        let view = set.view();
+        assert_eq!(view.get(&tx_hash(5)), Some(5));
+        assert_eq!(view.get(&tx_hash(6)), None);
+        assert_eq!(view.get(&tx_hash(11)), None);
+        assert_eq!(view.sealed().segments[0].last_height, 5);
+    }
+
+    #[test]
+    fn can_read_legacy_map_of_transactions() {
+        let legacy = [(tx_hash(1), 1_u64), (tx_hash(2), 2)]
+            .into_iter()
+            .collect::<std::collections::BTreeMap<_, _>>();
+        let json = serde_json::to_string(&legacy).unwrap();
+        let set: TxSet = serde_json::from_str(&json).unwrap();
+        assert_eq!(set.view().get(&tx_hash(2)), Some(2));
+
+        let mut block = set.block();
+        block.seal();
+        block.commit();
+        let set: TxSet = serde_json::from_str(&serde_json::to_string(&set).unwrap()).unwrap();
+        let view = set.view();
+        assert_eq!(view.get(&tx_hash(1)), Some(1));
+        assert_eq!(view.sealed().recent_len, 0);
+    }
+}
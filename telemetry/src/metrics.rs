@@ -5,7 +5,8 @@ use std::{ops::Deref, time::Duration};
 use parity_scale_codec::{Compact, Decode, Encode};
 use prometheus::{
     core::{AtomicU64, GenericGauge, GenericGaugeVec},
-    Encoder, Histogram, HistogramOpts, HistogramVec, IntCounter, IntCounterVec, Opts, Registry,
+    Encoder, Gauge, Histogram, HistogramOpts, HistogramVec, IntCounter, IntCounterVec, Opts,
+    Registry,
 };
 use serde::{Deserialize, Serialize};
 
@@ -13,6 +14,14 @@ use serde::{Deserialize, Serialize};
 pub type DroppedMessagesCounter = IntCounter;
 /// Type for reporting view change index of current round
 pub type ViewChangesGauge = GenericGauge<AtomicU64>;
+/// Type for reporting time from storing a block in Kura until it is durable
+pub type KuraDurableLatencyHistogram = Histogram;
+/// Type for reporting time spent writing state snapshots
+pub type SnapshotDurationHistogram = Histogram;
+/// Type for reporting sizes of the latest state snapshot
+pub type SnapshotBytesGauge = GenericGaugeVec<AtomicU64>;
+/// Type for reporting compression ratio of the latest state snapshot
+pub type SnapshotCompressionRatioGauge = Gauge;
 
 /// Thin wrapper around duration that `impl`s [`Default`]
 #[derive(Debug, Clone, Copy, Serialize, Deserialize)]
@@ -112,6 +121,20 @@ pub struct Metrics {
     pub queue_size: GenericGauge<AtomicU64>,
     /// Number of sumeragi dropped messages
     pub dropped_messages: DroppedMessagesCounter,
+    /// Hits, misses and evictions of the Kura block cache
+    pub kura_block_cache: IntCounterVec,
+    /// Size of blocks held by the Kura block cache in bytes
+    pub kura_block_cache_bytes: GenericGauge<AtomicU64>,
+    /// Time from handing a block over to Kura until it is durable on disk
+    pub kura_commit_to_durable: KuraDurableLatencyHistogram,
+    /// Estimated accesses to the most accessed keys of the world state in the latest block
+    pub hot_keys: GenericGaugeVec<AtomicU64>,
+    /// Time spent writing state snapshots
+    pub snapshot_duration: SnapshotDurationHistogram,
+    /// Size of the latest state snapshot before and after compression
+    pub snapshot_bytes: SnapshotBytesGauge,
+    /// Ratio of the size of the latest state snapshot before compression to its size after
+    pub snapshot_compression_ratio: SnapshotCompressionRatioGauge,
     /// Internal use only. Needed for generating the response.
     registry: Registry,
 }
@@ -162,6 +185,44 @@ impl Default for Metrics {
             .expect("Infallible");
         let dropped_messages =
             IntCounter::new("dropped_messages", "Sumeragi dropped messages").expect("Infallible");
+        let kura_block_cache = IntCounterVec::new(
+            Opts::new("kura_block_cache", "Kura block cache lookups and evictions"),
+            &["type"],
+        )
+        .expect("Infallible");
+        let kura_block_cache_bytes = GenericGauge::new(
+            "kura_block_cache_bytes",
+            "Size of blocks held by the Kura block cache",
+        )
+        .expect("Infallible");
+        let kura_commit_to_durable = Histogram::with_opts(HistogramOpts::new(
+            "kura_commit_to_durable_seconds",
+            "Time from storing a block in Kura until it is durable on disk",
+        ))
+        .expect("Infallible");
+        let hot_keys = GenericGaugeVec::new(
+            Opts::new(
+                "hot_keys",
+                "Accesses to the most accessed keys of the world state in the latest block",
+            ),
+            &["kind", "key", "access"],
+        )
+        .expect("Infallible");
+        let snapshot_duration = Histogram::with_opts(HistogramOpts::new(
+            "snapshot_write_seconds",
+            "Time spent writing a state snapshot, including its compression",
+        ))
+        .expect("Infallible");
+        let snapshot_bytes = GenericGaugeVec::new(
+            Opts::new("snapshot_bytes", "Size of the latest state snapshot"),
+            &["type"],
+        )
+        .expect("Infallible");
+        let snapshot_compression_ratio = Gauge::new(
+            "snapshot_compression_ratio",
+            "Size of the latest state snapshot before compression divided by its size after",
+        )
+        .expect("Infallible");
         let registry = Registry::new();
 
         macro_rules! register {
@@ -186,7 +247,14 @@ impl Default for Metrics {
             isi_times,
             view_changes,
             queue_size,
-            dropped_messages
+            dropped_messages,
+            kura_block_cache,
+            kura_block_cache_bytes,
+            kura_commit_to_durable,
+            hot_keys,
+            snapshot_duration,
+            snapshot_bytes,
+            snapshot_compression_ratio
         );
 
         Self {
@@ -202,6 +270,13 @@ impl Default for Metrics {
             view_changes,
             queue_size,
             dropped_messages,
+            kura_block_cache,
+            kura_block_cache_bytes,
+            kura_commit_to_durable,
+            hot_keys,
+            snapshot_duration,
+            snapshot_bytes,
+            snapshot_compression_ratio,
             registry,
         }
     }
@@ -2,7 +2,9 @@
 use std::path::{Path, PathBuf};
 
 use clap::{Parser, Subcommand};
-use iroha_core::kura::{BlockIndex, BlockStore, LockStatus};
+use iroha_core::kura::{
+    BlockCodec, BlockIndex, BlockStore, BlockStoreMap, LockStatus, SegmentLayout,
+};
 use iroha_data_model::block::SignedBlock;
 use iroha_version::scale::DecodeVersioned;
 
@@ -29,6 +31,22 @@ enum Command {
         #[clap(short = 'n', long, default_value_t = 1)]
         length: u64,
     },
+    /// Print how well a certain length of the blocks is compressed.
+    /// Unlike `print` it starts from the genesis block by default
+    Stats {
+        /// Number of the blocks to inspect.
+        /// Defaults to all blocks
+        #[clap(short = 'n', long)]
+        length: Option<u64>,
+    },
+    /// Check a certain length of the blocks against their checksums without decoding them.
+    /// Unlike `print` it starts from the genesis block by default
+    Verify {
+        /// Number of the blocks to verify.
+        /// Defaults to all blocks
+        #[clap(short = 'n', long)]
+        length: Option<u64>,
+    },
 }
 
 fn main() {
@@ -46,10 +64,225 @@ fn main() {
             from_height.unwrap_or(u64::MAX),
             length,
         ),
+        Command::Stats { length } => print_compression_stats(
+            &args.path_to_block_store,
+            from_height.unwrap_or(0),
+            length.unwrap_or(u64::MAX),
+        ),
+        Command::Verify { length } => {
+            let is_intact = verify_blockchain(
+                &args.path_to_block_store,
+                from_height.unwrap_or(0),
+                length.unwrap_or(u64::MAX),
+            );
+            if !is_intact {
+                std::process::exit(1);
+            }
+        }
+    }
+}
+
+/// Block store together with the indices of the requested range of blocks.
+struct BlockRange {
+    block_store: BlockStore,
+    store_path: PathBuf,
+    layout: SegmentLayout,
+    index_count: u64,
+    from_height: u64,
+    block_indices: Vec<BlockIndex>,
+}
+
+impl BlockRange {
+    /// Read and decompress the block with the given offset in the range.
+    /// Returns `None` if the block was pruned.
+    fn read_block_bytes(&self, offset: usize) -> Option<(BlockIndex, Vec<u8>)> {
+        let idx = self.block_indices[offset];
+        let block_number = self.from_height + offset as u64;
+        let height = block_number + 1;
+        if self.layout.is_pruned(block_number) {
+            return None;
+        }
+        let mut block_buf =
+            vec![0_u8; usize::try_from(idx.length).expect("index_len didn't fit in 32-bits")];
+        self.block_store
+            .read_block_data(block_number, idx.start, &mut block_buf)
+            .unwrap_or_else(|_| panic!("Failed to read block № {height} data."));
+        let block_bytes = idx
+            .codec
+            .decompress(&block_buf)
+            .unwrap_or_else(|_| panic!("Failed to decompress block № {height}"))
+            .into_owned();
+        Some((idx, block_bytes))
     }
 }
 
 fn print_blockchain(block_store_path: &Path, from_height: u64, block_count: u64) {
+    let Some(range) = read_block_range(block_store_path, from_height, block_count) else {
+        println!("The block store is empty.");
+        return;
+    };
+
+    // Now for the actual printing
+    println!("Index file says there are {} blocks.", range.index_count);
+    println!(
+        "Printing blocks {}-{}...",
+        range.from_height + 1,
+        range.from_height + range.block_indices.len() as u64
+    );
+
+    for i in 0..range.block_indices.len() {
+        let meta_index = range.from_height + i as u64;
+        let Some((idx, block_bytes)) = range.read_block_bytes(i) else {
+            println!("Block#{} is pruned.", meta_index + 1);
+            continue;
+        };
+
+        println!(
+            "Block#{} starts at byte offset {} and is {} bytes long.",
+            meta_index + 1,
+            idx.start,
+            idx.length
+        );
+        if idx.codec != BlockCodec::None {
+            println!(
+                "Block#{} is compressed with {:?} from {} bytes (ratio {:.2}).",
+                meta_index + 1,
+                idx.codec,
+                block_bytes.len(),
+                compression_ratio(block_bytes.len() as u64, idx.length)
+            );
+        }
+        let block = SignedBlock::decode_all_versioned(&block_bytes)
+            .unwrap_or_else(|_| panic!("Failed to decode block № {}", meta_index + 1));
+        println!("Block#{} :", meta_index + 1);
+        println!("{block:#?}");
+    }
+}
+
+fn print_compression_stats(block_store_path: &Path, from_height: u64, block_count: u64) {
+    let Some(range) = read_block_range(block_store_path, from_height, block_count) else {
+        println!("The block store is empty.");
+        return;
+    };
+
+    println!(
+        "Inspecting blocks {}-{}...",
+        range.from_height + 1,
+        range.from_height + range.block_indices.len() as u64
+    );
+
+    let (mut stored_bytes, mut decoded_bytes) = (0, 0);
+    let (mut compressed_blocks, mut pruned_blocks) = (0, 0);
+    for i in 0..range.block_indices.len() {
+        let Some((idx, block_bytes)) = range.read_block_bytes(i) else {
+            pruned_blocks += 1;
+            continue;
+        };
+        stored_bytes += idx.length;
+        decoded_bytes += block_bytes.len() as u64;
+        if idx.codec != BlockCodec::None {
+            compressed_blocks += 1;
+        }
+    }
+
+    println!(
+        "{compressed_blocks} of {} blocks are compressed, {pruned_blocks} are pruned.",
+        range.block_indices.len()
+    );
+    println!(
+        "Blocks take {stored_bytes} bytes on disk and {decoded_bytes} bytes decompressed (ratio {:.2}).",
+        compression_ratio(decoded_bytes, stored_bytes)
+    );
+}
+
+/// Check blocks against their checksums and sealed segments against theirs.
+/// Returns `false` if any of them doesn't match.
+#[allow(clippy::cast_precision_loss)]
+fn verify_blockchain(block_store_path: &Path, from_height: u64, block_count: u64) -> bool {
+    let Some(range) = read_block_range(block_store_path, from_height, block_count) else {
+        println!("The block store is empty.");
+        return true;
+    };
+    let started_at = std::time::Instant::now();
+    let block_map = BlockStoreMap::new(&range.store_path).expect("Failed to map block store");
+    let checksums_count = range
+        .block_store
+        .read_checksums_count()
+        .expect("Failed to read checksum count")
+        .saturating_sub(range.from_height)
+        .min(range.block_indices.len() as u64);
+    let checksums = range
+        .block_store
+        .read_block_checksums(
+            range.from_height,
+            usize::try_from(checksums_count).expect("checksums_count didn't fit in 32-bits"),
+        )
+        .expect("Failed to read block checksums");
+
+    println!(
+        "Verifying blocks {}-{}...",
+        range.from_height + 1,
+        range.from_height + range.block_indices.len() as u64
+    );
+    let (mut checked_bytes, mut pruned_blocks, mut corrupted_blocks) = (0, 0, 0);
+    for (offset, idx) in range.block_indices.iter().enumerate() {
+        let block_number = range.from_height + offset as u64;
+        if range.layout.is_pruned(block_number) {
+            pruned_blocks += 1;
+            continue;
+        }
+        let Some(checksum) = checksums.get(offset) else {
+            println!("Block#{} has no checksum.", block_number + 1);
+            corrupted_blocks += 1;
+            continue;
+        };
+        if block_map.block_checksum(block_number) != Some(*checksum) {
+            println!("Block#{} doesn't match its checksum.", block_number + 1);
+            corrupted_blocks += 1;
+        }
+        checked_bytes += idx.length;
+    }
+
+    let last_block = range.from_height + range.block_indices.len() as u64 - 1;
+    let mut corrupted_segments = 0;
+    if let (Some(first_segment), Some(last_segment)) = (
+        range.layout.segment(range.from_height),
+        range.layout.segment(last_block),
+    ) {
+        for segment in first_segment..=last_segment {
+            // Segments which are not sealed yet or were pruned have no checksum to check
+            if let Ok(false) = range.block_store.verify_segment(segment) {
+                println!("Segment {segment} doesn't match its checksum.");
+                corrupted_segments += 1;
+            }
+        }
+    }
+
+    let elapsed = started_at.elapsed().as_secs_f64();
+    println!(
+        "{corrupted_blocks} of {} blocks and {corrupted_segments} segments are corrupted, {pruned_blocks} blocks are pruned.",
+        range.block_indices.len()
+    );
+    println!(
+        "Checked {checked_bytes} bytes in {elapsed:.2}s ({:.1} MiB/s).",
+        checked_bytes as f64 / f64::from(1 << 20) / elapsed.max(f64::EPSILON)
+    );
+    corrupted_blocks == 0 && corrupted_segments == 0
+}
+
+#[allow(clippy::cast_precision_loss)]
+fn compression_ratio(decoded_bytes: u64, stored_bytes: u64) -> f64 {
+    if stored_bytes == 0 {
+        return 1.0;
+    }
+    decoded_bytes as f64 / stored_bytes as f64
+}
+
+fn read_block_range(
+    block_store_path: &Path,
+    from_height: u64,
+    block_count: u64,
+) -> Option<BlockRange> {
     let mut block_store_path: std::borrow::Cow<'_, Path> = block_store_path.into();
 
     if let Some(os_str_file_name) = block_store_path.file_name() {
@@ -66,8 +299,7 @@ fn print_blockchain(block_store_path: &Path, from_height: u64, block_count: u64)
         .expect("Failed to read index count from block store {block_store_path:?}.");
 
     if index_count == 0 {
-        println!("The block store is empty.");
-        return;
+        return None;
     }
 
     assert!(
@@ -81,17 +313,14 @@ fn print_blockchain(block_store_path: &Path, from_height: u64, block_count: u64)
         from_height
     };
 
-    let block_count = if from_height + block_count > index_count {
+    let block_count = if from_height.saturating_add(block_count) > index_count {
         index_count - from_height
     } else {
         block_count
     };
 
     let mut block_indices = vec![
-        BlockIndex {
-            start: 0,
-            length: 0
-        };
+        BlockIndex::default();
         block_count
             .try_into()
             .expect("block_count didn't fit in 32-bits")
@@ -99,34 +328,14 @@ fn print_blockchain(block_store_path: &Path, from_height: u64, block_count: u64)
     block_store
         .read_block_indices(from_height, &mut block_indices)
         .expect("Failed to read block indices");
-    let block_indices = block_indices;
-
-    // Now for the actual printing
-    println!("Index file says there are {index_count} blocks.");
-    println!(
-        "Printing blocks {}-{}...",
-        from_height + 1,
-        from_height + block_count
-    );
-
-    for i in 0..block_count {
-        let idx = block_indices[usize::try_from(i).expect("i didn't fit in 32-bits")];
-        let meta_index = from_height + i;
+    let layout = block_store.layout().expect("Failed to read segment layout");
 
-        println!(
-            "Block#{} starts at byte offset {} and is {} bytes long.",
-            meta_index + 1,
-            idx.start,
-            idx.length
-        );
-        let mut block_buf =
-            vec![0_u8; usize::try_from(idx.length).expect("index_len didn't fit in 32-bits")];
-        block_store
-            .read_block_data(idx.start, &mut block_buf)
-            .unwrap_or_else(|_| panic!("Failed to read block № {} data.", meta_index + 1));
-        let block = SignedBlock::decode_all_versioned(&block_buf)
-            .unwrap_or_else(|_| panic!("Failed to decode block № {}", meta_index + 1));
-        println!("Block#{} :", meta_index + 1);
-        println!("{block:#?}");
-    }
+    Some(BlockRange {
+        block_store,
+        store_path: block_store_path.into_owned(),
+        layout,
+        index_count,
+        from_height,
+        block_indices,
+    })
 }
@@ -24,6 +24,10 @@ pub mod uri {
     pub const CONFIGURATION: &str = "configuration";
     /// URI to report status for administration
     pub const STATUS: &str = "status";
+    /// URI nested under [`STATUS`] to report the most accessed keys of the world state
+    pub const HOT_KEYS: &str = "hot_keys";
+    /// URI nested under [`STATUS`] to report the commitment to the world state
+    pub const STATE_ROOT: &str = "state_root";
     ///  Metrics URI is used to export metrics according to [Prometheus
     ///  Guidance](https://prometheus.io/docs/instrumenting/writing_exporters/).
     pub const METRICS: &str = "metrics";
@@ -107,6 +107,20 @@ impl Torii {
 
         #[cfg(feature = "telemetry")]
         let get_router = get_router
+            .or(warp::path(uri::STATUS)
+                .and(warp::path(uri::HOT_KEYS))
+                .and(warp::path::end())
+                .and(add_state!(self.metrics_reporter.clone()))
+                .and_then(|metrics_reporter| async move {
+                    Ok::<_, Infallible>(routing::handle_hot_keys(&metrics_reporter))
+                }))
+            .or(warp::path(uri::STATUS)
+                .and(warp::path(uri::STATE_ROOT))
+                .and(warp::path::end())
+                .and(add_state!(self.metrics_reporter.clone()))
+                .and_then(|metrics_reporter| async move {
+                    Ok::<_, Infallible>(routing::handle_state_root(&metrics_reporter))
+                }))
             .or(warp::path(uri::STATUS)
                 .and(add_state!(self.metrics_reporter.clone()))
                 .and(warp::header::optional(warp::http::header::ACCEPT.as_str()))
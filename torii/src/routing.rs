@@ -278,6 +278,16 @@ pub fn handle_metrics(metrics_reporter: &MetricsReporter) -> Result<String> {
         .map_err(Error::Prometheus)
 }
 
+#[cfg(feature = "telemetry")]
+pub fn handle_hot_keys(metrics_reporter: &MetricsReporter) -> Json {
+    reply::json(&metrics_reporter.hot_keys())
+}
+
+#[cfg(feature = "telemetry")]
+pub fn handle_state_root(metrics_reporter: &MetricsReporter) -> Json {
+    reply::json(&metrics_reporter.state_root())
+}
+
 #[cfg(feature = "telemetry")]
 #[allow(clippy::unnecessary_wraps)]
 pub fn handle_status(